@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <mtlt/atomic_matrix.h>
+
+#include "benchmark_counters.h"
+
+using namespace mtlt;
+
+static const std::size_t kContentionOrder = 64;
+
+// Every thread increments the same element, the cache line bounces between cores
+static void BM_AtomicSameElement(benchmark::State &state) {
+  static atomic_matrix<long long> m(kContentionOrder, kContentionOrder);
+
+  for (auto _ : state)
+	m(0, 0).fetch_add(1, std::memory_order_relaxed);
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AtomicSameElement)->ThreadRange(1, 8)->UseRealTime();
+
+// Neighbouring elements of one row share cache lines, false sharing
+static void BM_AtomicFalseSharing(benchmark::State &state) {
+  static atomic_matrix<long long> m(kContentionOrder, kContentionOrder);
+  const std::size_t col = static_cast<std::size_t>(state.thread_index()) % kContentionOrder;
+
+  for (auto _ : state)
+	m(0, col).fetch_add(1, std::memory_order_relaxed);
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AtomicFalseSharing)->ThreadRange(1, 8)->UseRealTime();
+
+// Every thread works on its own row, 512 bytes apart
+static void BM_AtomicOwnRow(benchmark::State &state) {
+  static atomic_matrix<long long> m(kContentionOrder, kContentionOrder);
+  const std::size_t row = static_cast<std::size_t>(state.thread_index()) % kContentionOrder;
+
+  for (auto _ : state)
+	m(row, 0).fetch_add(1, std::memory_order_relaxed);
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AtomicOwnRow)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_AtomicMul(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  atomic_matrix<double> lhs(n, n), rhs(n, n);
+  lhs.fill_random(1.0, 9.0);
+  rhs.fill_random(1.0, 9.0);
+
+  for (auto _ : state) {
+	atomic_matrix<double> product(lhs);
+	product.mul(rhs);
+	benchmark::DoNotOptimize(product(0, 0).load());
+  }
+
+  set_flops(state, 2.0 * n * n * n);
+}
+BENCHMARK(BM_AtomicMul)->RangeMultiplier(2)->Range(16, 128);
@@ -0,0 +1,19 @@
+#ifndef MTLT_BENCHMARK_COUNTERS_H_
+#define MTLT_BENCHMARK_COUNTERS_H_
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+// Reported as FLOP/s, the count is per iteration
+inline void set_flops(benchmark::State &state, double flops) {
+  state.counters["FLOP/s"] = benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate,
+												benchmark::Counter::OneK::kIs1000);
+}
+
+// Reported as bytes_per_second, the count is per iteration
+inline void set_bytes(benchmark::State &state, std::uint64_t bytes) {
+  state.SetBytesProcessed(static_cast<std::int64_t>(bytes * state.iterations()));
+}
+
+#endif // MTLT_BENCHMARK_COUNTERS_H_
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Compares two Google Benchmark JSON files produced by mtl-benchmark.
+
+    ./mtl-benchmark --benchmark_out=old.json --benchmark_out_format=json
+    ./mtl-benchmark --benchmark_out=new.json --benchmark_out_format=json
+    python3 compare.py old.json new.json --threshold 5
+
+Prints the time change of every benchmark present in both files and the change
+of its FLOP/s and bytes_per_second counters. Exits with 1 if --fail-on-regression
+is given and any benchmark became slower by more than --threshold percent.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+COUNTERS = ("FLOP/s", "bytes_per_second", "items_per_second")
+
+
+def load(path, pattern):
+    with open(path) as f:
+        data = json.load(f)
+
+    results = {}
+    for run in data.get("benchmarks", []):
+        # With --benchmark_repetitions only the mean is compared
+        if run.get("run_type") == "aggregate" and run.get("aggregate_name") != "mean":
+            continue
+
+        name = run.get("run_name", run["name"])
+        if pattern and not re.search(pattern, name):
+            continue
+
+        scale = TIME_UNITS[run.get("time_unit", "ns")]
+        results[name] = {
+            "time": run["real_time"] * scale,
+            "cpu": run["cpu_time"] * scale,
+            "counters": {key: run[key] for key in COUNTERS if key in run},
+        }
+    return results
+
+
+def human(value, suffix=""):
+    for unit in ("", "K", "M", "G", "T"):
+        if abs(value) < 1000:
+            return "%.3g%s%s" % (value, unit, suffix)
+        value /= 1000.0
+    return "%.3gP%s" % (value, suffix)
+
+
+def human_time(nanoseconds):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if nanoseconds >= scale:
+            return "%.3g %s" % (nanoseconds / scale, unit)
+    return "%.3g ns" % nanoseconds
+
+
+def change(old, new):
+    return (new - old) / old * 100.0 if old else float("inf")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--filter", help="regex, compare only matching benchmarks")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="percent of time change reported as a regression or improvement")
+    parser.add_argument("--cpu", action="store_true", help="compare cpu time instead of real time")
+    parser.add_argument("--fail-on-regression", action="store_true")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.filter)
+    contender = load(args.contender, args.filter)
+    key = "cpu" if args.cpu else "time"
+
+    names = [name for name in contender if name in baseline]
+    width = max([len("Benchmark")] + [len(name) for name in names])
+
+    print("%-*s %12s %12s %9s  %s" % (width, "Benchmark", "Old", "New", "Change", "Counters"))
+    print("-" * (width + 60))
+
+    regressions = 0
+    for name in names:
+        old, new = baseline[name], contender[name]
+        delta = change(old[key], new[key])
+
+        mark = ""
+        if delta > args.threshold:
+            mark = "  SLOWER"
+            regressions += 1
+        elif delta < -args.threshold:
+            mark = "  faster"
+
+        counters = []
+        for counter, value in new["counters"].items():
+            if counter in old["counters"]:
+                counters.append("%s %s -> %s" % (counter, human(old["counters"][counter]), human(value)))
+
+        print("%-*s %12s %12s %+8.1f%%  %s%s" % (width, name, human_time(old[key]), human_time(new[key]),
+                                              delta, ", ".join(counters), mark))
+
+    missing = sorted(set(baseline) ^ set(contender))
+    if missing:
+        print("\nPresent in only one file: " + ", ".join(missing))
+
+    print("\n%d of %d benchmarks slower by more than %.1f%%" % (regressions, len(names), args.threshold))
+    return 1 if args.fail_on_regression and regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,445 @@
+#include <vector>
+#include <sstream>
+#include <limits>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <mtlt/graph.h>
+#include <mtlt/bit_matrix.h>
+#include <mtlt/matrix.h>
+
+#include "benchmark_counters.h"
+
+using namespace mtlt;
+
+template<typename T>
+static matrix<T> random_matrix(std::size_t rows, std::size_t cols) {
+  matrix<T> m(rows, cols);
+  m.fill_random(T(1), T(9));
+  return m;
+}
+
+template<typename T>
+static void BM_Construct(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state) {
+	matrix<T> m(n, n);
+	benchmark::DoNotOptimize(m.data());
+  }
+
+  set_bytes(state, n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_Construct, int)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_TEMPLATE(BM_Construct, double)->RangeMultiplier(4)->Range(16, 1024);
+
+template<typename T>
+static void BM_Copy(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const matrix<T> source = random_matrix<T>(n, n);
+
+  for (auto _ : state) {
+	matrix<T> copy(source);
+	benchmark::DoNotOptimize(copy.data());
+  }
+
+  set_bytes(state, 2 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_Copy, double)->RangeMultiplier(4)->Range(16, 1024);
+
+template<typename T>
+static void BM_Move(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  matrix<T> source = random_matrix<T>(n, n);
+
+  for (auto _ : state) {
+	matrix<T> moved(std::move(source));
+	source = std::move(moved);
+	benchmark::DoNotOptimize(source.data());
+  }
+}
+BENCHMARK_TEMPLATE(BM_Move, double)->Arg(1024);
+
+template<typename T>
+static void BM_AddMatrix(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  matrix<T> lhs = random_matrix<T>(n, n);
+  const matrix<T> rhs = random_matrix<T>(n, n);
+
+  for (auto _ : state) {
+	lhs.add(rhs);
+	benchmark::ClobberMemory();
+  }
+
+  set_flops(state, static_cast<double>(n * n));
+  set_bytes(state, 3 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_AddMatrix, int)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_TEMPLATE(BM_AddMatrix, double)->RangeMultiplier(4)->Range(16, 1024);
+
+template<typename T>
+static void BM_MulByElement(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  matrix<T> lhs = random_matrix<T>(n, n);
+  const matrix<T> rhs(n, n, T(1));
+
+  for (auto _ : state) {
+	lhs.mul_by_element(rhs);
+	benchmark::ClobberMemory();
+  }
+
+  set_flops(state, static_cast<double>(n * n));
+  set_bytes(state, 3 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_MulByElement, double)->RangeMultiplier(4)->Range(16, 1024);
+
+template<typename T>
+static void BM_MulByNumber(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  matrix<T> m = random_matrix<T>(n, n);
+
+  for (auto _ : state) {
+	m.mul(T(1));
+	benchmark::ClobberMemory();
+  }
+
+  set_flops(state, static_cast<double>(n * n));
+  set_bytes(state, 2 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_MulByNumber, float)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_TEMPLATE(BM_MulByNumber, double)->RangeMultiplier(4)->Range(16, 1024);
+
+template<typename T>
+static void BM_Sum(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const matrix<T> m = random_matrix<T>(n, n);
+
+  for (auto _ : state)
+	benchmark::DoNotOptimize(m.sum());
+
+  set_flops(state, static_cast<double>(n * n));
+  set_bytes(state, n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_Sum, float)->RangeMultiplier(4)->Range(64, 8192);
+BENCHMARK_TEMPLATE(BM_Sum, double)->RangeMultiplier(4)->Range(64, 8192);
+
+template<typename T>
+static void BM_FrobeniusNorm(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const matrix<T> m = random_matrix<T>(n, n);
+
+  for (auto _ : state)
+	benchmark::DoNotOptimize(m.frobenius_norm());
+
+  set_flops(state, 2.0 * static_cast<double>(n * n));
+  set_bytes(state, n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_FrobeniusNorm, double)->RangeMultiplier(4)->Range(64, 8192);
+
+template<typename T>
+static void BM_ReduceCols(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const matrix<T> m = random_matrix<T>(n, n);
+
+  for (auto _ : state)
+	benchmark::DoNotOptimize(m.reduce_cols(reduction::sum).data());
+
+  set_flops(state, static_cast<double>(n * n));
+  set_bytes(state, n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_ReduceCols, double)->RangeMultiplier(4)->Range(64, 4096);
+
+template<typename T>
+static void BM_SubRowMean(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  matrix<T> m = random_matrix<T>(n, n);
+
+  for (auto _ : state) {
+	m.sub_row_mean();
+	benchmark::ClobberMemory();
+  }
+
+  set_flops(state, 2.0 * static_cast<double>(n * n));
+  set_bytes(state, 3 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_SubRowMean, float)->RangeMultiplier(4)->Range(64, 4096);
+
+template<typename T>
+static void BM_FillNormal(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  matrix<T> m(n, n);
+
+  for (auto _ : state) {
+	m.fill_random(execution::par, normal_random<T>(42, T(0), T(1)));
+	benchmark::ClobberMemory();
+  }
+
+  set_bytes(state, n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_FillNormal, double)->RangeMultiplier(4)->Range(64, 4096);
+
+template<typename T>
+static void BM_Mul(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const matrix<T> lhs = random_matrix<T>(n, n);
+  const matrix<T> rhs = random_matrix<T>(n, n);
+
+  for (auto _ : state) {
+	matrix<T> product(lhs);
+	product.mul(rhs);
+	benchmark::DoNotOptimize(product.data());
+  }
+
+  set_flops(state, 2.0 * n * n * n);
+  set_bytes(state, 3 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_Mul, int)->RangeMultiplier(2)->Range(16, 256);
+BENCHMARK_TEMPLATE(BM_Mul, float)->RangeMultiplier(2)->Range(16, 256);
+BENCHMARK_TEMPLATE(BM_Mul, double)->RangeMultiplier(2)->Range(16, 512);
+
+template<typename T>
+static void BM_MulStrassen(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const std::size_t threshold = static_cast<std::size_t>(state.range(1));
+  const matrix<T> lhs = random_matrix<T>(n, n);
+  const matrix<T> rhs = random_matrix<T>(n, n);
+
+  for (auto _ : state) {
+	matrix<T> product(lhs);
+	product.mul_strassen(rhs, threshold);
+	benchmark::DoNotOptimize(product.data());
+  }
+
+  set_flops(state, 2.0 * n * n * n);
+  set_bytes(state, 3 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_MulStrassen, double)->ArgsProduct({{1024, 2048}, {256, 512}})->Unit(benchmark::kMillisecond);
+
+template<typename T, typename Semiring>
+static void BM_MulSemiring(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  matrix<T> lhs(n, n), rhs(n, n);
+  lhs.fill_random(bernoulli_random<T>(1, 0.1));
+  rhs.fill_random(bernoulli_random<T>(2, 0.1));
+
+  for (auto _ : state) {
+	matrix<T> product(lhs);
+	product.template mul<Semiring>(rhs);
+	benchmark::DoNotOptimize(product.data());
+  }
+
+  set_flops(state, 2.0 * n * n * n);
+  set_bytes(state, 3 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_MulSemiring, int, semiring::min_plus)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK_TEMPLATE(BM_MulSemiring, int, semiring::or_and)->RangeMultiplier(4)->Range(64, 1024);
+
+static matrix<int> random_graph(std::size_t n) {
+  matrix<int> distances(n, n);
+  distances.fill_random(uniform_random<int>(1, 1, 1000));
+
+  matrix<int> edges(n, n);
+  edges.fill_random(bernoulli_random<int>(2, 0.01));
+
+  for (std::size_t row = 0; row != n; ++row)
+	for (std::size_t col = 0; col != n; ++col)
+	  if (row == col)
+		distances(row, col) = 0;
+	  else if (edges(row, col) == 0)
+		distances(row, col) = std::numeric_limits<int>::max();
+
+  return distances;
+}
+
+static void BM_FloydWarshall(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const matrix<int> graph = random_graph(n);
+
+  for (auto _ : state) {
+	matrix<int> distances(graph);
+	floyd_warshall(distances);
+	benchmark::DoNotOptimize(distances.data());
+  }
+
+  set_flops(state, 2.0 * n * n * n);
+  set_bytes(state, n * n * sizeof(int));
+}
+BENCHMARK(BM_FloydWarshall)->RangeMultiplier(4)->Range(64, 1024)->Unit(benchmark::kMillisecond);
+
+static void BM_TransitiveClosure(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  matrix<int> adjacency(n, n);
+  adjacency.fill_random(bernoulli_random<int>(3, 1.0 / static_cast<double>(n)));
+
+  for (auto _ : state) {
+	matrix<int> closure(adjacency);
+	transitive_closure(closure);
+	benchmark::DoNotOptimize(closure.data());
+  }
+
+  set_bytes(state, n * n * sizeof(int));
+}
+BENCHMARK(BM_TransitiveClosure)->RangeMultiplier(4)->Range(64, 4096)->Unit(benchmark::kMillisecond);
+
+static bit_matrix random_bit_matrix(std::size_t n, std::uint64_t seed) {
+  matrix<int> bits(n, n);
+  bits.fill_random(bernoulli_random<int>(seed, 0.5));
+  return bit_matrix(bits);
+}
+
+static void BM_BitMatrixMul(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const bit_matrix lhs = random_bit_matrix(n, 1), rhs = random_bit_matrix(n, 2);
+
+  for (auto _ : state)
+	benchmark::DoNotOptimize(lhs.mul(rhs));
+
+  set_flops(state, 2.0 * n * n * n);
+  set_bytes(state, 3 * n * n / 8);
+}
+BENCHMARK(BM_BitMatrixMul)->RangeMultiplier(4)->Range(64, 4096)->Unit(benchmark::kMillisecond);
+
+static void BM_BitMatrixMulCount(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const bit_matrix lhs = random_bit_matrix(n, 1), rhs = random_bit_matrix(n, 2);
+
+  for (auto _ : state)
+	benchmark::DoNotOptimize(lhs.mul_count(rhs));
+
+  set_flops(state, 2.0 * n * n * n);
+  set_bytes(state, 2 * n * n / 8 + n * n * sizeof(std::size_t));
+}
+BENCHMARK(BM_BitMatrixMulCount)->RangeMultiplier(4)->Range(64, 4096)->Unit(benchmark::kMillisecond);
+
+static void BM_BitMatrixTranspose(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const bit_matrix m = random_bit_matrix(n, 3);
+
+  for (auto _ : state)
+	benchmark::DoNotOptimize(m.transpose());
+
+  set_bytes(state, 2 * n * n / 8);
+}
+BENCHMARK(BM_BitMatrixTranspose)->RangeMultiplier(4)->Range(64, 4096);
+
+template<typename T>
+static void BM_Transpose(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const matrix<T> m = random_matrix<T>(n, n);
+
+  for (auto _ : state) {
+	matrix<T> transposed = m.transpose();
+	benchmark::DoNotOptimize(transposed.data());
+  }
+
+  set_bytes(state, 2 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_Transpose, double)->RangeMultiplier(4)->Range(16, 2048);
+
+template<typename T>
+static void BM_DeterminantGaussian(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const matrix<T> m = random_matrix<T>(n, n);
+
+  for (auto _ : state)
+	benchmark::DoNotOptimize(m.determinant_gaussian());
+
+  set_flops(state, 2.0 * n * n * n / 3.0);
+}
+BENCHMARK_TEMPLATE(BM_DeterminantGaussian, double)->RangeMultiplier(2)->Range(8, 512);
+
+template<typename T>
+static void BM_Inverse(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  matrix<T> m = random_matrix<T>(n, n);
+  for (std::size_t i = 0; i != n; ++i)
+	m(i, i) += static_cast<T>(10 * n);
+
+  for (auto _ : state) {
+	matrix<T> inverse = m.inverse();
+	benchmark::DoNotOptimize(inverse.data());
+  }
+
+  // Cofactor inverse: n * n minors, every one is a Gaussian elimination of order n - 1
+  set_flops(state, n * n * 2.0 * (n - 1) * (n - 1) * (n - 1) / 3.0);
+}
+BENCHMARK_TEMPLATE(BM_Inverse, double)->RangeMultiplier(2)->Range(4, 32);
+
+template<typename T>
+static void BM_JoinRight(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const matrix<T> lhs = random_matrix<T>(n, n);
+  const matrix<T> rhs = random_matrix<T>(n, n);
+
+  for (auto _ : state) {
+	matrix<T> joined = lhs.join_right(rhs);
+	benchmark::DoNotOptimize(joined.data());
+  }
+
+  set_bytes(state, 4 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_JoinRight, double)->RangeMultiplier(4)->Range(16, 1024);
+
+template<typename T>
+static void BM_JoinBottom(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const matrix<T> lhs = random_matrix<T>(n, n);
+  const matrix<T> rhs = random_matrix<T>(n, n);
+
+  for (auto _ : state) {
+	matrix<T> joined = lhs.join_bottom(rhs);
+	benchmark::DoNotOptimize(joined.data());
+  }
+
+  set_bytes(state, 4 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_JoinBottom, double)->RangeMultiplier(4)->Range(16, 1024);
+
+template<typename T>
+static void BM_Resize(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  matrix<T> m = random_matrix<T>(n, n);
+
+  for (auto _ : state) {
+	m.resize(n + 1, n + 1);
+	m.resize(n, n);
+	benchmark::DoNotOptimize(m.data());
+  }
+
+  set_bytes(state, 4 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_Resize, double)->RangeMultiplier(4)->Range(16, 1024);
+
+template<typename T>
+static void BM_PushBackRow(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const std::vector<T> row(64, T(1));
+
+  for (auto _ : state) {
+	matrix<T> m;
+	for (std::size_t i = 0; i != n; ++i)
+	  m.push_back_row(row.begin(), row.end());
+	benchmark::DoNotOptimize(m.data());
+  }
+
+  set_bytes(state, n * row.size() * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_PushBackRow, double)->RangeMultiplier(4)->Range(16, 4096);
+
+template<typename T>
+static void BM_Print(benchmark::State &state) {
+  const std::size_t n = static_cast<std::size_t>(state.range(0));
+  const matrix<T> m = random_matrix<T>(n, n);
+  std::ostringstream os;
+
+  for (auto _ : state) {
+	os.str(std::string());
+	m.print(os);
+	benchmark::DoNotOptimize(os.tellp());
+  }
+
+  set_bytes(state, n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_Print, int)->RangeMultiplier(4)->Range(16, 256);
+BENCHMARK_TEMPLATE(BM_Print, double)->RangeMultiplier(4)->Range(16, 256);
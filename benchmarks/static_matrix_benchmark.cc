@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include <mtlt/static_matrix.h>
+
+#include "benchmark_counters.h"
+
+using namespace mtlt;
+
+template<typename T, std::size_t N>
+static static_matrix<T, N, N> random_static_matrix() {
+  static_matrix<T, N, N> m;
+  m.fill_random(T(1), T(9));
+  return m;
+}
+
+template<typename T, std::size_t N>
+static void BM_StaticMul(benchmark::State &state) {
+  const static_matrix<T, N, N> lhs = random_static_matrix<T, N>();
+  const static_matrix<T, N, N> rhs = random_static_matrix<T, N>();
+
+  for (auto _ : state) {
+	static_matrix<T, N, N> product = lhs * rhs;
+	benchmark::DoNotOptimize(product.data());
+  }
+
+  set_flops(state, 2.0 * N * N * N);
+}
+BENCHMARK_TEMPLATE(BM_StaticMul, float, 4);
+BENCHMARK_TEMPLATE(BM_StaticMul, double, 4);
+BENCHMARK_TEMPLATE(BM_StaticMul, double, 8);
+BENCHMARK_TEMPLATE(BM_StaticMul, double, 16);
+
+template<typename T, std::size_t N>
+static void BM_StaticTranspose(benchmark::State &state) {
+  const static_matrix<T, N, N> m = random_static_matrix<T, N>();
+
+  for (auto _ : state) {
+	static_matrix<T, N, N> transposed = m.transpose();
+	benchmark::DoNotOptimize(transposed.data());
+  }
+
+  set_bytes(state, 2 * N * N * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_StaticTranspose, double, 4);
+BENCHMARK_TEMPLATE(BM_StaticTranspose, double, 16);
+
+template<typename T, std::size_t N>
+static void BM_StaticAdd(benchmark::State &state) {
+  const static_matrix<T, N, N> lhs = random_static_matrix<T, N>();
+  const static_matrix<T, N, N> rhs = random_static_matrix<T, N>();
+
+  for (auto _ : state) {
+	static_matrix<T, N, N> sum = lhs.add(rhs);
+	benchmark::DoNotOptimize(sum.data());
+  }
+
+  set_flops(state, static_cast<double>(N * N));
+  set_bytes(state, 3 * N * N * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_StaticAdd, double, 4);
+BENCHMARK_TEMPLATE(BM_StaticAdd, double, 16);
@@ -0,0 +1,342 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Asynchronous matrix operations running on the executor
+ *        of the library and returning chainable futures
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_ASYNC_H_
+#define MTLT_ASYNC_H_
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+#include <mtlt/matrix.h>
+#include <mtlt/parallel.h>
+#include <mtlt/serialization.h>
+
+namespace mtlt {
+
+template<typename T>
+class future;
+
+namespace detail {
+
+template<typename T>
+struct future_access;
+
+template<typename T>
+class future_value {
+public:
+  T &get() { return *value_; }
+
+  template<typename U>
+  void set(U &&value) {
+	value_.reset(new T(std::forward<U>(value)));
+  }
+
+  template<typename Function, typename... Args>
+  void emplace(Function &f, Args &&... args) {
+	value_.reset(new T(f(std::forward<Args>(args)...)));
+  }
+
+private:
+  std::unique_ptr<T> value_;
+};
+
+template<>
+class future_value<void> {
+public:
+  void get() {}
+
+  void set() {}
+
+  template<typename Function, typename... Args>
+  void emplace(Function &f, Args &&... args) {
+	f(std::forward<Args>(args)...);
+  }
+};
+
+/**
+ * Shared state of a future: the task computing the value and the continuations
+ * waiting for it. The task is run once, either by the executor or by the first
+ * thread waiting for the value, so a future never waits for a job the executor
+ * has not started. A state without a task is completed by its owner with complete()
+ */
+template<typename T>
+class future_state : public future_value<T> {
+public:
+  using task_type = std::function<void(future_state &)>;
+
+public:
+  future_state() noexcept : claimed_(true) {}
+
+  explicit future_state(task_type task) : task_(std::move(task)) {}
+
+  void run() {
+	if (claimed_.exchange(true, std::memory_order_acq_rel))
+	  return;
+
+	task_type task = std::move(task_);
+	task_ = nullptr;
+
+	try {
+	  task(*this);
+	} catch (...) {
+	  error_ = std::current_exception();
+	}
+
+	complete();
+  }
+
+  void fail(std::exception_ptr error) noexcept { error_ = std::move(error); }
+
+  /**
+   * Makes the value (or the error) visible and calls the continuations
+   */
+  void complete() {
+	std::vector<std::function<void()>> continuations;
+	{
+	  std::lock_guard<std::mutex> lock(mutex_);
+	  ready_ = true;
+	  continuations.swap(continuations_);
+	}
+	ready_condition_.notify_all();
+
+	for (auto &continuation : continuations)
+	  continuation();
+  }
+
+  /**
+   * While the value is computed by others, runs the jobs of the executor,
+   * they may be the ones the value depends on
+   */
+  void wait() {
+	run();
+
+	executor &ex = get_executor();
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (!ready_) {
+	  lock.unlock();
+	  const bool helped = ex.try_run_one();
+	  lock.lock();
+
+	  if (!helped)
+		ready_condition_.wait_for(lock, std::chrono::milliseconds(1), [this] { return ready_; });
+	}
+  }
+
+  bool is_ready() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return ready_;
+  }
+
+  /**
+   * Calls continuation when the value is ready, right away if it already is
+   */
+  void on_ready(std::function<void()> continuation) {
+	{
+	  std::lock_guard<std::mutex> lock(mutex_);
+	  if (!ready_) {
+		continuations_.push_back(std::move(continuation));
+		return;
+	  }
+	}
+
+	continuation();
+  }
+
+  const std::exception_ptr &error() const noexcept { return error_; }
+
+private:
+  std::atomic<bool> claimed_{false};
+  task_type task_;
+
+  std::mutex mutex_;
+  std::condition_variable ready_condition_;
+  bool ready_ = false;
+  std::exception_ptr error_;
+  std::vector<std::function<void()>> continuations_;
+};
+
+template<typename T>
+void schedule(const std::shared_ptr<future_state<T>> &state) {
+  try {
+	get_executor().submit([state]() { state->run(); });
+  } catch (...) {
+	state->run();
+  }
+}
+
+template<typename Function, typename T>
+struct continuation_result {
+  using type = decltype(std::declval<Function &>()(std::declval<T &>()));
+};
+
+template<typename Function>
+struct continuation_result<Function, void> {
+  using type = decltype(std::declval<Function &>()());
+};
+
+template<typename R, typename Function, typename T>
+void continue_with(future_state<R> &next, Function &f, future_state<T> &source) {
+  next.emplace(f, source.get());
+}
+
+template<typename R, typename Function>
+void continue_with(future_state<R> &next, Function &f, future_state<void> &) {
+  next.emplace(f);
+}
+
+template<typename T>
+struct future_access {
+  static const std::shared_ptr<future_state<T>> &state(const future<T> &f) noexcept { return f.state_; }
+};
+
+} // namespace detail end
+
+/**
+ * @class future
+ *
+ * Result of an asynchronous operation. get() waits for the value and
+ * rethrows the exception of the operation, then() attaches an operation
+ * started when the value is ready, without blocking the calling thread
+ *
+ * @code
+ *
+ * mtlt::future<mtlt::matrix<double>> inversed = mtlt::load_async<mtlt::matrix<double>>("a.mtlt")
+ *     .then([](mtlt::matrix<double> &a) { return a.inverse(); });
+ *
+ * handle_network();
+ * use(inversed.get());
+ *
+ * @endcode
+ */
+template<typename T>
+class future final {
+public:
+  future() noexcept = default;
+
+  explicit future(std::shared_ptr<detail::future_state<T>> state) noexcept
+	  : state_(std::move(state)) {}
+
+public:
+  MATRIX_CXX17_NODISCARD
+  bool valid() const noexcept { return state_ != nullptr; }
+
+  MATRIX_CXX17_NODISCARD
+  bool is_ready() const { return state_->is_ready(); }
+
+  void wait() const { state_->wait(); }
+
+  /**
+   * The value stays in the future, it can be moved out of the returned reference
+   */
+  typename std::add_lvalue_reference<T>::type get() const {
+	state_->wait();
+
+	if (state_->error())
+	  std::rethrow_exception(state_->error());
+
+	return state_->get();
+  }
+
+  /**
+   * f gets T & (nothing for future<void>), an exception of this future
+   * is passed to the returned one without calling f
+   */
+  template<typename Function>
+  future<typename detail::continuation_result<Function, T>::type> then(Function f) const {
+	using result_type = typename detail::continuation_result<Function, T>::type;
+	using next_state = detail::future_state<result_type>;
+
+	std::shared_ptr<detail::future_state<T>> source = state_;
+	std::shared_ptr<next_state> next = std::make_shared<next_state>([source, f](next_state &self) mutable {
+	  source->wait();
+	  if (source->error())
+		std::rethrow_exception(source->error());
+
+	  detail::continue_with(self, f, *source);
+	});
+
+	source->on_ready([next]() { detail::schedule(next); });
+	return future<result_type>(std::move(next));
+  }
+
+private:
+  friend struct detail::future_access<T>;
+
+  std::shared_ptr<detail::future_state<T>> state_;
+};
+
+/**
+ * Runs f() on the executor of the library
+ */
+template<typename Function>
+future<typename detail::continuation_result<Function, void>::type> async(Function f) {
+  using result_type = typename detail::continuation_result<Function, void>::type;
+  using state_type = detail::future_state<result_type>;
+
+  std::shared_ptr<state_type> state = std::make_shared<state_type>([f](state_type &self) mutable {
+	self.emplace(f);
+  });
+
+  detail::schedule(state);
+  return future<result_type>(std::move(state));
+}
+
+/**
+ * The operands are taken by value, move them in to avoid copies
+ */
+template<typename T>
+future<matrix<T>> mul_async(matrix<T> lhs, matrix<T> rhs) {
+  std::shared_ptr<matrix<T>> left = std::make_shared<matrix<T>>(std::move(lhs));
+  std::shared_ptr<const matrix<T>> right = std::make_shared<matrix<T>>(std::move(rhs));
+
+  return async([left, right]() { return std::move(left->mul(*right)); });
+}
+
+template<typename T>
+future<matrix<T>> inverse_async(matrix<T> m) {
+  std::shared_ptr<matrix<T>> operand = std::make_shared<matrix<T>>(std::move(m));
+  return async([operand]() { return operand->inverse(); });
+}
+
+template<typename Matrix>
+future<Matrix> load_async(std::string path) {
+  return async([path]() { return load<Matrix>(path); });
+}
+
+template<typename Matrix>
+future<void> save_async(Matrix m, std::string path, matrix_binary_settings settings = matrix_binary_settings{}) {
+  std::shared_ptr<Matrix> operand = std::make_shared<Matrix>(std::move(m));
+  return async([operand, path, settings]() { save(*operand, path, settings); });
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_ASYNC_H_
@@ -29,6 +29,7 @@
 #include <random>
 #include <chrono>
 #include <vector>
+#include <utility>
 #include <iomanip>
 #include <numeric>
 #include <iostream>
@@ -39,8 +40,12 @@
 #include <concepts>
 #endif
 
+#include <mtlt/reduce.h>
+#include <mtlt/random.h>
+#include <mtlt/execution.h>
 #include <mtlt/matrix_config.h>
 #include <mtlt/matrix_type_traits.h>
+#include <mtlt/instrumentation.h>
 #include <mtlt/matrix_normal_iterator.h>
 #include <mtlt/matrix_reverse_iterator.h>
 
@@ -118,6 +123,7 @@ public:
 
   MATRIX_CXX17_CONSTEXPR atomic_matrix(size_type rows, size_type cols, atomic_value_type f = {})
 	  : rows_(rows), cols_(cols), data_(new value_type[rows * cols]{}) {
+	MTLT_COUNT_ALLOCATION(rows * cols * sizeof(value_type));
 	if (f != value_type{})
 	  fill(f);
 
@@ -287,6 +293,12 @@ public:
   MATRIX_CXX17_NODISCARD
   size_type size() const noexcept { return rows_ * cols_; }
 
+  MATRIX_CXX17_CONSTEXPR
+  pointer data() noexcept { return data_; }
+
+  MATRIX_CXX17_CONSTEXPR
+  const_pointer data() const noexcept { return data_; }
+
   void rows(size_type rows) {
 	if (rows_ == rows)
 	  return;
@@ -319,6 +331,8 @@ public:
 	if (cols_ == cols && rows_ == rows)
 	  return;
 
+	MTLT_OPERATION_SCOPE(operation::resize, rows, cols, 0, std::min(rows, rows_) * std::min(cols, cols_) * sizeof(value_type), rows * cols * sizeof(value_type));
+
 	atomic_matrix tmp(rows, cols);
 	const size_type min_cols = std::min(cols, cols_);
 	const size_type min_rows = std::min(rows, rows_);
@@ -377,6 +391,8 @@ public:
   }
 
   atomic_matrix &mul(const atomic_value_type &number) {
+	MTLT_OPERATION_SCOPE(operation::mul_by_number, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
 	transform([&number](const value_type &item) { return item * number; });
 	return *this;
   }
@@ -392,6 +408,8 @@ public:
 	if (cols_ != rhs.rows())
 	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
 
+	MTLT_OPERATION_SCOPE(operation::mul, rows_, rhs.cols(), 2 * rows_ * cols_ * rhs.cols(), (size() + rhs.size()) * sizeof(value_type), rows_ * rhs.cols() * sizeof(value_type));
+
 	const size_type cols = rhs.cols();
 	const size_type rows = rows_;
 
@@ -424,11 +442,15 @@ public:
 	if (std::is_integral<atomic_value_type>::value && number == 0)
 	  throw std::logic_error("Dividing by zero");
 
+	MTLT_OPERATION_SCOPE(operation::div_by_number, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
 	transform([&number](const value_type &item) { return item / number; });
 	return *this;
   }
 
   atomic_matrix &add(const atomic_value_type &number) {
+	MTLT_OPERATION_SCOPE(operation::add, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
 	transform([&number](const value_type &item) { return item + number; });
 	return *this;
   }
@@ -444,11 +466,15 @@ public:
 	if (rhs.rows() != rows_ || rhs.cols() != cols_)
 	  throw std::logic_error("Can't add different sized matrices");
 
+	MTLT_OPERATION_SCOPE(operation::add, rows_, cols_, size(), 2 * size() * sizeof(value_type), size() * sizeof(value_type));
+
 	transform(rhs, [](const T &lhs, const U &rhs) { return lhs + rhs; });
 	return *this;
   }
 
   atomic_matrix &sub(const atomic_value_type &number) {
+	MTLT_OPERATION_SCOPE(operation::sub, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
 	transform([&number](const value_type &item) { return item - number; });
 	return *this;
   }
@@ -464,26 +490,39 @@ public:
 	if (rhs.rows() != rows_ || rhs.cols() != cols_)
 	  throw std::logic_error("Can't add different sized matrices");
 
+	MTLT_OPERATION_SCOPE(operation::sub, rows_, cols_, size(), 2 * size() * sizeof(value_type), size() * sizeof(value_type));
+
 	transform(rhs, [](const T &lhs, const U &rhs) { return lhs - rhs; });
 	return *this;
   }
 
   atomic_matrix &fill(const atomic_value_type &v) {
+	MTLT_OPERATION_SCOPE(operation::fill, rows_, cols_, 0, 0, size() * sizeof(value_type));
+
 	for (auto &value : *this)
 	  value.store(v);
 	return *this;
   }
 
   atomic_matrix &fill_random(const atomic_value_type &left, const atomic_value_type &right) {
-	using namespace std::chrono;
+	return fill_random(execution::seq, uniform_random<atomic_value_type>(detail::random_seed(), left, right));
+  }
 
-	std::default_random_engine re(system_clock::now().time_since_epoch().count());
-	auto distribution = typename std::conditional<std::is_integral<T>::value,
-												  std::uniform_int_distribution<T>,
-												  std::uniform_real_distribution<T>>::type(left, right);
+  /**
+   * Fills the matrix with a distribution of mtlt/random.h by relaxed stores,
+   * see matrix::fill_random
+   */
+  template<typename Distribution>
+  atomic_matrix &fill_random(const Distribution &distribution) {
+	return fill_random(execution::seq, distribution);
+  }
 
-	generate([&]() {
-	  return distribution(re);
+  template<typename Distribution>
+  atomic_matrix &fill_random(const execution_policy &policy, const Distribution &distribution) {
+	detail::for_each_range(policy, size(), [this, &distribution](size_type first, size_type last) {
+	  detail::random_range(distribution, first, last, [this](size_type i, const atomic_value_type &value) {
+		data_[i].store(value, std::memory_order_relaxed);
+	  });
 	});
 
 	return *this;
@@ -542,12 +581,58 @@ public:
 	return *this;
   }
 
+  /**
+   * Reductions read the elements with relaxed loads, see matrix::sum
+   */
   atomic_value_type sum() const {
-	atomic_value_type sum{};
-	for (const auto &value : *this)
-	  sum += value;
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, size(), size() * sizeof(value_type), 0);
+
+	return detail::sum_elements<atomic_value_type>(data_, size(), detail::relaxed_load());
+  }
+
+  double mean() const {
+	if (size() == 0)
+	  throw std::logic_error("Can't calculate mean of empty matrix");
+
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, size(), size() * sizeof(value_type), 0);
+
+	return detail::sum_elements<double>(data_, size(), detail::relaxed_load()) / static_cast<double>(size());
+  }
+
+  atomic_value_type min() const {
+	const std::pair<size_type, size_type> position = argmin();
+	return (*this)(position.first, position.second).load(std::memory_order_relaxed);
+  }
+
+  atomic_value_type max() const {
+	const std::pair<size_type, size_type> position = argmax();
+	return (*this)(position.first, position.second).load(std::memory_order_relaxed);
+  }
+
+  std::pair<size_type, size_type> argmin() const {
+	return extremum(std::less<atomic_value_type>());
+  }
 
-	return sum;
+  std::pair<size_type, size_type> argmax() const {
+	return extremum(std::greater<atomic_value_type>());
+  }
+
+  double frobenius_norm() const {
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, 2 * size(), size() * sizeof(value_type), 0);
+
+	return std::sqrt(detail::sum_elements<double>(data_, size(), detail::relaxed_load(), detail::square_transform()));
+  }
+
+  double l1_norm() const {
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, size(), size() * sizeof(value_type), 0);
+
+	return detail::max_col_abs_sum(data_, rows_, cols_, detail::relaxed_load());
+  }
+
+  double linf_norm() const {
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, size(), size() * sizeof(value_type), 0);
+
+	return detail::max_row_abs_sum(data_, rows_, cols_, detail::relaxed_load());
   }
 
 public:
@@ -562,6 +647,8 @@ public:
 	if (rhs.rows() != rows_)
 	  throw std::logic_error("Can't join left rhs matrix to lhs, because lhs.rows() != rhs.rows()");
 
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
+
 	atomic_matrix join_matrix(rows_, cols_ + rhs.cols());
 
 	size_type cols2 = rhs.cols();
@@ -581,6 +668,8 @@ public:
 	if (rhs.rows() != rows_)
 	  throw std::logic_error("Can't join left rhs matrix to lhs, because lhs.rows() != rhs.rows()");
 
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
+
 	size_type old_cols = cols_;
 	size_type cols2 = rhs.cols();
 
@@ -596,6 +685,8 @@ public:
 	if (rhs.rows() != rows_)
 	  throw std::logic_error("Can't join right rhs matrix to lhs, because lhs.rows() != rhs.rows()");
 
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
+
 	atomic_matrix join_matrix(rows_, cols_ + rhs.cols());
 	size_type cols2 = rhs.cols();
 
@@ -621,6 +712,8 @@ public:
 	if (rhs.rows() != rows_)
 	  throw std::logic_error("Can't join top rhs matrix to lhs, because lhs.cols() != rhs.cols()");
 
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
+
 	size_type old_rows = rows_;
 	size_type rows2 = rhs.rows();
 	atomic_matrix join_matrix(rows_ + rhs.rows(), cols_);
@@ -640,6 +733,8 @@ public:
 	if (rhs.rows() != rows_)
 	  throw std::logic_error("Can't join bottom rhs matrix to lhs, because lhs.cols() != rhs.cols()");
 
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
+
 	size_type old_rows = rows_;
 	size_type rows2 = rhs.rows();
 	this->rows(rows_ + rhs.rows());
@@ -655,6 +750,8 @@ public:
 	if (rhs.rows() != rows_)
 	  throw std::logic_error("Can't join bottom rhs matrix to lhs, because lhs.cols() != rhs.cols()");
 
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
+
 	atomic_matrix join_matrix(rows_ + rhs.rows(), cols_);
 	size_type rows2 = rhs.rows();
 
@@ -671,6 +768,8 @@ public:
 
 public:
   atomic_matrix transpose() const {
+	MTLT_OPERATION_SCOPE(operation::transpose, rows_, cols_, 0, size() * sizeof(value_type), size() * sizeof(value_type));
+
 	atomic_matrix transposed(cols_, rows_);
 
 	for (size_type row = 0; row != rows_; ++row)
@@ -708,6 +807,8 @@ public:
 	if (rows_ != cols_)
 	  throw std::logic_error("determinant_gaussian can be found only for square matrices");
 
+	MTLT_OPERATION_SCOPE(operation::determinant, rows_, cols_, 2 * rows_ * rows_ * rows_ / 3, size() * sizeof(value_type), 0);
+
 	double determinant_value = 1;
 
 	atomic_matrix<double> matrix(rows_, cols_, *this);
@@ -769,6 +870,8 @@ public:
 	if (rows_ != cols_)
 	  throw std::logic_error("determinant_gaussian can be found only for square matrices");
 
+	MTLT_OPERATION_SCOPE(operation::determinant, rows_, cols_, rows_ < 2 ? 0 : rows_ == 2 ? 3 : 3 * rows_, size() * sizeof(value_type), 0);
+
 	int sign = 1;
 	double determinant_value{};
 
@@ -801,6 +904,8 @@ public:
 	if (rows_ != cols_)
 	  throw std::logic_error("Complements matrix can be found only for square matrices");
 
+	MTLT_OPERATION_SCOPE(operation::complements, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
 	atomic_matrix complements(rows_, cols_);
 
 	for (size_type row = 0; row != rows_; ++row) {
@@ -816,6 +921,8 @@ public:
   }
 
   atomic_matrix inverse() const {
+	MTLT_OPERATION_SCOPE(operation::inverse, rows_, cols_, 0, 0, 0);
+
 	double determinant = determinant_gaussian();
 
 	if (std::fabs(determinant) <= 1e-6)
@@ -825,6 +932,8 @@ public:
   }
 
   atomic_matrix inverse(double determinant) const {
+	MTLT_OPERATION_SCOPE(operation::inverse, rows_, cols_, 0, 0, 0);
+
 	if (std::fabs(determinant) <= 1e-6)
 	  throw std::logic_error("Can't found inverse matrix because determinant is zero");
 
@@ -909,6 +1018,18 @@ public:
 	return v;
   }
 
+private:
+  template<typename Compare>
+  std::pair<size_type, size_type> extremum(Compare compare) const {
+	if (size() == 0)
+	  throw std::logic_error("Can't find extremum of empty matrix");
+
+	MTLT_OPERATION_SCOPE(operation::other, rows_, cols_, size(), size() * sizeof(value_type), 0);
+
+	const size_type index = detail::extremum_index<atomic_value_type>(data_, size(), detail::relaxed_load(), compare);
+	return std::make_pair(index / cols_, index % cols_);
+  }
+
 private:
   size_type rows_{}, cols_{};
   pointer data_ = nullptr;
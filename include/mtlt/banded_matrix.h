@@ -0,0 +1,356 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        The banded_matrix container class stores only the diagonals
+ *        between the lower and the upper bandwidth of a square matrix
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_BANDED_MATRIX_H_
+#define MTLT_BANDED_MATRIX_H_
+
+#include <cmath>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <mtlt/matrix.h>
+#include <mtlt/matrix_config.h>
+#include <mtlt/matrix_normal_iterator.h>
+
+namespace mtlt {
+
+/**
+ * @class banded_matrix
+ *
+ * Square matrix with A(i, j) == 0 when j < i - lower() or j > i + upper().
+ * Every row keeps lower() + upper() + 1 elements, so the storage is
+ * rows() * (lower() + upper() + 1) instead of rows() * cols()
+ *
+ * operator() returns zero outside of the stored band,
+ * at() returns a reference to the stored element and throws outside of it
+ *
+ * @code
+ *
+ * mtlt::banded_matrix<double> tridiagonal(n, 1, 1);
+ * tridiagonal.at(i, i - 1) = -1; tridiagonal.at(i, i) = 2; tridiagonal.at(i, i + 1) = -1;
+ *
+ * mtlt::matrix<double> x = tridiagonal.solve(b); // tridiagonal * x == b
+ *
+ * @endcode
+ */
+template<typename T>
+class banded_matrix final {
+public:
+  using value_type = T;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using size_type = std::size_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = matrix_normal_iterator<pointer>;
+  using const_iterator = matrix_normal_iterator<const_pointer>;
+
+public:
+  MATRIX_CXX17_CONSTEXPR banded_matrix() noexcept = default;
+
+  MATRIX_CXX17_CONSTEXPR banded_matrix(size_type order, size_type lower, size_type upper, value_type f = {})
+	  : order_(order), lower_(lower), upper_(upper), data_(new value_type[order * (lower + upper + 1)]{}) {
+	if (f != value_type{})
+	  for (size_type row = 0; row != order_; ++row)
+		for (size_type col = first_col(row); col != last_col(row); ++col)
+		  data_[index(row, col)] = f;
+  }
+
+  /**
+   * Takes the band of a square matrix, the elements outside of it are ignored
+   */
+  banded_matrix(const matrix<T> &full, size_type lower, size_type upper)
+	  : banded_matrix(full.rows(), lower, upper) {
+	if (full.rows() != full.cols())
+	  throw std::logic_error("Only square matrices can be packed as banded");
+
+	for (size_type row = 0; row != order_; ++row)
+	  for (size_type col = first_col(row); col != last_col(row); ++col)
+		data_[index(row, col)] = full(row, col);
+  }
+
+  MATRIX_CXX17_CONSTEXPR banded_matrix(const banded_matrix &other)
+	  : banded_matrix(other.order_, other.lower_, other.upper_) {
+	std::copy(other.begin(), other.end(), begin());
+  }
+
+  MATRIX_CXX17_CONSTEXPR banded_matrix(banded_matrix &&other) noexcept
+	  : order_(other.order_), lower_(other.lower_), upper_(other.upper_), data_(other.data_) {
+	other.order_ = other.lower_ = other.upper_ = size_type{};
+	other.data_ = nullptr;
+  }
+
+  MATRIX_CXX17_CONSTEXPR banded_matrix &operator=(const banded_matrix &other) {
+	if (&other == this)
+	  return *this;
+
+	banded_matrix tmp(other);
+	*this = std::move(tmp);
+
+	return *this;
+  }
+
+  MATRIX_CXX17_CONSTEXPR banded_matrix &operator=(banded_matrix &&other) noexcept {
+	if (&other == this)
+	  return *this;
+
+	std::swap(order_, other.order_);
+	std::swap(lower_, other.lower_);
+	std::swap(upper_, other.upper_);
+	std::swap(data_, other.data_);
+
+	return *this;
+  }
+
+  ~banded_matrix() noexcept {
+	delete[] data_;
+  }
+
+public:
+  MATRIX_CXX17_CONSTEXPR
+  iterator begin() noexcept { return iterator(data_); }
+
+  MATRIX_CXX17_CONSTEXPR
+  const_iterator begin() const noexcept { return const_iterator(data_); }
+
+  MATRIX_CXX17_CONSTEXPR
+  iterator end() noexcept { return iterator(data_ + size()); }
+
+  MATRIX_CXX17_CONSTEXPR
+  const_iterator end() const noexcept { return const_iterator(data_ + size()); }
+
+public:
+  value_type operator()(size_type row, size_type col) const {
+	return is_stored(row, col) ? data_[index(row, col)] : value_type{};
+  }
+
+  reference at(size_type row, size_type col) {
+	if (row >= order_ || col >= order_)
+	  throw std::out_of_range("row or col is out of range of matrix");
+
+	if (!is_stored(row, col))
+	  throw std::out_of_range("row and col are out of the stored band");
+
+	return data_[index(row, col)];
+  }
+
+  value_type at(size_type row, size_type col) const {
+	if (row >= order_ || col >= order_)
+	  throw std::out_of_range("row or col is out of range of matrix");
+
+	return (*this)(row, col);
+  }
+
+  MATRIX_CXX17_NODISCARD
+  bool is_stored(size_type row, size_type col) const noexcept {
+	return col + lower_ >= row && col <= row + upper_;
+  }
+
+  MATRIX_CXX17_NODISCARD
+  size_type rows() const noexcept { return order_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type cols() const noexcept { return order_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type lower() const noexcept { return lower_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type upper() const noexcept { return upper_; }
+
+  /**
+   * Count of stored elements including the unused corners of the band
+   */
+  MATRIX_CXX17_NODISCARD
+  size_type size() const noexcept { return order_ * (lower_ + upper_ + 1); }
+
+public:
+  void print(std::ostream &os = std::cout, matrix_debug_settings s = matrix_debug_settings{}) const {
+	for (size_type row = 0; row != order_; ++row) {
+	  for (size_type col = 0; col != order_; ++col) {
+		os << std::setw(s.width)
+		   << std::setprecision(s.precision)
+		   << (*this)(row, col)
+		   << s.separator;
+	  }
+	  os << s.end;
+	}
+
+	if (s.is_double_end)
+	  os << s.end;
+  }
+
+  matrix<T> to_matrix() const {
+	matrix<T> full(order_, order_);
+
+	for (size_type row = 0; row != order_; ++row)
+	  for (size_type col = first_col(row); col != last_col(row); ++col)
+		full(row, col) = data_[index(row, col)];
+
+	return full;
+  }
+
+  /**
+   * GBMM: returns this * rhs touching only the band,
+   * the work is rows() * (lower() + upper() + 1) * rhs.cols()
+   */
+  matrix<T> mul(const matrix<T> &rhs) const {
+	if (order_ != rhs.rows())
+	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
+
+	const size_type cols = rhs.cols();
+	matrix<T> multiplied(order_, cols);
+
+	for (size_type row = 0; row != order_; ++row)
+	  for (size_type k = first_col(row); k != last_col(row); ++k) {
+		const value_type a = data_[index(row, k)];
+		for (size_type col = 0; col != cols; ++col)
+		  multiplied(row, col) += a * rhs(k, col);
+	  }
+
+	return multiplied;
+  }
+
+  /**
+   * Solves this * x == rhs by banded gaussian elimination with partial pivoting.
+   * Row interchanges widen the upper band to upper() + lower(),
+   * the cost is rows() * lower() * (lower() + upper()) * rhs.cols()
+   */
+  matrix<T> solve(const matrix<T> &rhs) const {
+	if (order_ != rhs.rows())
+	  throw std::logic_error("Can't solve system because lhs.rows() != rhs.rows()");
+
+	const size_type cols = rhs.cols();
+	const size_type width = 2 * lower_ + upper_ + 1;
+	const size_type wide_upper = lower_ + upper_;
+
+	std::vector<value_type> band(order_ * width);
+	auto work = [&](size_type row, size_type col) -> value_type & {
+	  return band[row * width + (col + lower_ - row)];
+	};
+
+	for (size_type row = 0; row != order_; ++row)
+	  for (size_type col = first_col(row); col != last_col(row); ++col)
+		work(row, col) = data_[index(row, col)];
+
+	matrix<T> x(rhs);
+
+	for (size_type k = 0; k != order_; ++k) {
+	  const size_type last_row = std::min(order_, k + lower_ + 1);
+	  const size_type last = std::min(order_, k + wide_upper + 1);
+
+	  size_type pivot_row = k;
+	  for (size_type row = k + 1; row < last_row; ++row)
+		if (std::abs(work(row, k)) > std::abs(work(pivot_row, k)))
+		  pivot_row = row;
+
+	  if (work(pivot_row, k) == value_type{})
+		throw std::logic_error("Can't solve system because banded matrix is singular");
+
+	  if (pivot_row != k) {
+		for (size_type col = k; col != last; ++col)
+		  std::swap(work(k, col), work(pivot_row, col));
+		x.swap_rows(k, pivot_row);
+	  }
+
+	  const value_type pivot = work(k, k);
+	  for (size_type row = k + 1; row < last_row; ++row) {
+		const value_type factor = work(row, k) / pivot;
+		if (factor == value_type{})
+		  continue;
+
+		for (size_type col = k + 1; col != last; ++col)
+		  work(row, col) -= factor * work(k, col);
+		for (size_type col = 0; col != cols; ++col)
+		  x(row, col) -= factor * x(k, col);
+	  }
+	}
+
+	for (size_type step = 0; step != order_; ++step) {
+	  const size_type row = order_ - 1 - step;
+	  const size_type last = std::min(order_, row + wide_upper + 1);
+
+	  for (size_type k = row + 1; k < last; ++k) {
+		const value_type a = work(row, k);
+		for (size_type col = 0; col != cols; ++col)
+		  x(row, col) -= a * x(k, col);
+	  }
+
+	  const value_type diagonal = work(row, row);
+	  for (size_type col = 0; col != cols; ++col)
+		x(row, col) /= diagonal;
+	}
+
+	return x;
+  }
+
+  template<typename EqualCompare = std::equal_to<value_type>>
+  bool equal_to(const banded_matrix &rhs) const {
+	return order_ == rhs.order_ && lower_ == rhs.lower_ && upper_ == rhs.upper_ &&
+		std::equal(begin(), end(), rhs.begin(), EqualCompare());
+  }
+
+private:
+  MATRIX_CXX17_CONSTEXPR size_type first_col(size_type row) const noexcept {
+	return row > lower_ ? row - lower_ : 0;
+  }
+
+  MATRIX_CXX17_CONSTEXPR size_type last_col(size_type row) const noexcept {
+	return std::min(order_, row + upper_ + 1);
+  }
+
+  MATRIX_CXX17_CONSTEXPR size_type index(size_type row, size_type col) const noexcept {
+	return row * (lower_ + upper_ + 1) + (col + lower_ - row);
+  }
+
+private:
+  size_type order_{}, lower_{}, upper_{};
+  pointer data_ = nullptr;
+};
+
+template<typename T>
+std::ostream &operator<<(std::ostream &out, const banded_matrix<T> &rhs) {
+  rhs.print(out);
+  return out;
+}
+
+template<typename T>
+matrix<T> inline operator*(const banded_matrix<T> &lhs, const matrix<T> &rhs) {
+  return lhs.mul(rhs);
+}
+
+template<typename T>
+bool inline operator==(const banded_matrix<T> &lhs, const banded_matrix<T> &rhs) {
+  return lhs.equal_to(rhs);
+}
+
+template<typename T>
+bool inline operator!=(const banded_matrix<T> &lhs, const banded_matrix<T> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_BANDED_MATRIX_H_
@@ -0,0 +1,473 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Boolean matrix storing 64 elements per word with
+ *        word level element wise operations and products
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_BIT_MATRIX_H_
+#define MTLT_BIT_MATRIX_H_
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <mtlt/matrix.h>
+#include <mtlt/parallel.h>
+#include <mtlt/execution.h>
+#include <mtlt/matrix_config.h>
+
+namespace mtlt {
+
+namespace detail {
+
+inline std::size_t popcount(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ull);
+  word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+  return static_cast<std::size_t>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/**
+ * Transposes a 64 x 64 block in place, bit col of block[row] is the element (row, col).
+ * Swaps the off diagonal halves of blocks of 64, 32, ... 2 rows with word operations
+ */
+inline void transpose_bit_block(std::uint64_t *block) noexcept {
+  std::uint64_t mask = 0x00000000FFFFFFFFull;
+
+  for (std::size_t half = 32; half != 0; half >>= 1, mask ^= mask << half) {
+	for (std::size_t row = 0; row < 64; row = ((row | half) + 1) & ~half) {
+	  const std::uint64_t swapped = ((block[row] >> half) ^ block[row | half]) & mask;
+	  block[row] ^= swapped << half;
+	  block[row | half] ^= swapped;
+	}
+  }
+}
+
+} // namespace detail end
+
+/**
+ * @class bit_matrix
+ *
+ * Boolean matrix storing 64 elements per word, every row starts with a new word.
+ * Element wise operations work on whole words, the product uses the method of
+ * Four Russians, the transpose works on blocks of 64 x 64 elements
+ *
+ * @code
+ *
+ * mtlt::bit_matrix reachable(adjacency);                      // nonzero elements are true
+ * mtlt::bit_matrix two_steps = reachable.mul(reachable);
+ * mtlt::matrix<std::size_t> common = sets.mul_count(sets.transpose()); // |set i & set j|
+ *
+ * @endcode
+ */
+class bit_matrix final {
+public:
+  using word_type = std::uint64_t;
+  using size_type = std::size_t;
+
+  static constexpr size_type kWordBits = 64;
+
+public:
+  bit_matrix() noexcept = default;
+
+  bit_matrix(size_type rows, size_type cols, bool f = false)
+	  : rows_(rows), cols_(cols), words_per_row_((cols + kWordBits - 1) / kWordBits), words_(rows * words_per_row_) {
+	if (f)
+	  fill(true);
+  }
+
+  /**
+   * Nonzero elements of m are true
+   */
+  template<typename T>
+  explicit bit_matrix(const matrix<T> &m)
+	  : bit_matrix(m.rows(), m.cols()) {
+	for (size_type row = 0; row != rows_; ++row)
+	  for (size_type col = 0; col != cols_; ++col)
+		if (m(row, col) != T{})
+		  words_[row * words_per_row_ + col / kWordBits] |= word_type{1} << (col % kWordBits);
+  }
+
+public:
+  MATRIX_CXX17_NODISCARD
+  size_type rows() const noexcept { return rows_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type cols() const noexcept { return cols_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type size() const noexcept { return rows_ * cols_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type words_per_row() const noexcept { return words_per_row_; }
+
+  /**
+   * Words of the row, bit col % 64 of word col / 64 is the element (row, col).
+   * The bits after cols() in the last word are zero and must stay zero
+   */
+  word_type *row_data(size_type row) noexcept { return words_.data() + row * words_per_row_; }
+
+  const word_type *row_data(size_type row) const noexcept { return words_.data() + row * words_per_row_; }
+
+  bool operator()(size_type row, size_type col) const noexcept {
+	return ((words_[row * words_per_row_ + col / kWordBits] >> (col % kWordBits)) & 1) != 0;
+  }
+
+  bool at(size_type row, size_type col) const {
+	check_index(row, col);
+	return (*this)(row, col);
+  }
+
+  bit_matrix &set(size_type row, size_type col, bool value = true) {
+	check_index(row, col);
+
+	word_type &word = words_[row * words_per_row_ + col / kWordBits];
+	const word_type bit = word_type{1} << (col % kWordBits);
+	word = value ? word | bit : word & ~bit;
+	return *this;
+  }
+
+  bit_matrix &reset(size_type row, size_type col) {
+	return set(row, col, false);
+  }
+
+  bit_matrix &fill(bool value) {
+	std::fill(words_.begin(), words_.end(), value ? ~word_type{0} : word_type{0});
+	clear_padding();
+	return *this;
+  }
+
+  /**
+   * Count of true elements
+   */
+  MATRIX_CXX17_NODISCARD
+  size_type count() const noexcept {
+	size_type counted = 0;
+	for (word_type word : words_)
+	  counted += detail::popcount(word);
+	return counted;
+  }
+
+  MATRIX_CXX17_NODISCARD
+  bool any() const noexcept {
+	return std::any_of(words_.begin(), words_.end(), [](word_type word) { return word != 0; });
+  }
+
+  MATRIX_CXX17_NODISCARD
+  bool none() const noexcept { return !any(); }
+
+public:
+  bit_matrix &bit_and(const bit_matrix &rhs) {
+	return combine(rhs, [](word_type lhs, word_type rhs) { return lhs & rhs; });
+  }
+
+  bit_matrix &bit_or(const bit_matrix &rhs) {
+	return combine(rhs, [](word_type lhs, word_type rhs) { return lhs | rhs; });
+  }
+
+  bit_matrix &bit_xor(const bit_matrix &rhs) {
+	return combine(rhs, [](word_type lhs, word_type rhs) { return lhs ^ rhs; });
+  }
+
+  /**
+   * Elements which are true in this and false in rhs
+   */
+  bit_matrix &bit_and_not(const bit_matrix &rhs) {
+	return combine(rhs, [](word_type lhs, word_type rhs) { return lhs & ~rhs; });
+  }
+
+  bit_matrix &flip() {
+	for (word_type &word : words_)
+	  word = ~word;
+
+	clear_padding();
+	return *this;
+  }
+
+  bit_matrix transpose() const {
+	bit_matrix transposed(cols_, rows_);
+	word_type block[kWordBits];
+
+	for (size_type row_word = 0; row_word != transposed.words_per_row_; ++row_word) {
+	  const size_type first_row = row_word * kWordBits;
+	  const size_type block_rows = std::min(size_type{kWordBits}, rows_ - first_row);
+
+	  for (size_type col_word = 0; col_word != words_per_row_; ++col_word) {
+		for (size_type index = 0; index != kWordBits; ++index)
+		  block[index] = index < block_rows ? words_[(first_row + index) * words_per_row_ + col_word] : 0;
+
+		detail::transpose_bit_block(block);
+
+		const size_type first_col = col_word * kWordBits;
+		const size_type block_cols = std::min(size_type{kWordBits}, cols_ - first_col);
+		for (size_type index = 0; index != block_cols; ++index)
+		  transposed.words_[(first_col + index) * transposed.words_per_row_ + row_word] = block[index];
+	  }
+	}
+
+	return transposed;
+  }
+
+  /**
+   * Boolean product: (i, j) is true when this(i, k) and rhs(k, j) for some k
+   */
+  bit_matrix mul(const bit_matrix &rhs) const {
+	return mul(execution::seq, rhs);
+  }
+
+  /**
+   * Method of Four Russians: for every 8 rows of rhs a table of the unions of all
+   * their 256 subsets is built, then a byte of a row of this selects the union
+   * to add to the row of the product, that is n^3 / 512 word operations
+   */
+  bit_matrix mul(const execution_policy &policy, const bit_matrix &rhs) const {
+	if (cols_ != rhs.rows_)
+	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
+
+	bit_matrix multiplied(rows_, rhs.cols_);
+	const size_type out_words = rhs.words_per_row_;
+	std::vector<word_type> tables(kTables * kTableSize * out_words);
+
+	for (size_type word = 0; word != words_per_row_; ++word) {
+	  for (size_type table = 0; table != kTables; ++table)
+		build_table(rhs, word * kWordBits + table * kTableBits, tables.data() + table * kTableSize * out_words);
+
+	  for_each_row(policy, rhs.cols_, [&](size_type row) {
+		const word_type bits = words_[row * words_per_row_ + word];
+		if (bits == 0)
+		  return;
+
+		word_type *out = multiplied.row_data(row);
+		for (size_type table = 0; table != kTables; ++table) {
+		  const size_type subset = static_cast<size_type>((bits >> (table * kTableBits)) & (kTableSize - 1));
+		  if (subset == 0)
+			continue;
+
+		  const word_type *selected = tables.data() + (table * kTableSize + subset) * out_words;
+		  for (size_type index = 0; index != out_words; ++index)
+			out[index] |= selected[index];
+		}
+	  });
+	}
+
+	return multiplied;
+  }
+
+  /**
+   * Integer product: (i, j) is the count of k with this(i, k) and rhs(k, j),
+   * computed as popcount of the rows of this and of the transposed rhs.
+   * a.mul_count(b.transpose()) counts the common elements of the rows of a and b
+   */
+  matrix<size_type> mul_count(const bit_matrix &rhs) const {
+	return mul_count(execution::seq, rhs);
+  }
+
+  matrix<size_type> mul_count(const execution_policy &policy, const bit_matrix &rhs) const {
+	if (cols_ != rhs.rows_)
+	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
+
+	const bit_matrix rhs_transposed = rhs.transpose();
+	matrix<size_type> counted(rows_, rhs.cols_, uninitialized);
+
+	for_each_row(policy, rhs.cols_, [&](size_type row) {
+	  const word_type *lhs_row = row_data(row);
+
+	  for (size_type col = 0; col != rhs.cols_; ++col) {
+		const word_type *rhs_row = rhs_transposed.row_data(col);
+
+		size_type common = 0;
+		for (size_type index = 0; index != words_per_row_; ++index)
+		  common += detail::popcount(lhs_row[index] & rhs_row[index]);
+
+		counted(row, col) = common;
+	  }
+	});
+
+	return counted;
+  }
+
+  /**
+   * Elements are 0 and 1
+   */
+  template<typename T = bool>
+  matrix<T> to_matrix() const {
+	matrix<T> converted(rows_, cols_);
+
+	for (size_type row = 0; row != rows_; ++row)
+	  for (size_type col = 0; col != cols_; ++col)
+		if ((*this)(row, col))
+		  converted(row, col) = T(1);
+
+	return converted;
+  }
+
+  bool equal_to(const bit_matrix &rhs) const noexcept {
+	return rows_ == rhs.rows_ && cols_ == rhs.cols_ && words_ == rhs.words_;
+  }
+
+  void print(std::ostream &os = std::cout, matrix_debug_settings s = matrix_debug_settings{}) const {
+	for (size_type row = 0; row != rows_; ++row) {
+	  for (size_type col = 0; col != cols_; ++col)
+		os << std::setw(s.width) << (*this)(row, col) << s.separator;
+	  os << s.end;
+	}
+
+	if (s.is_double_end)
+	  os << s.end;
+  }
+
+private:
+  static constexpr size_type kTableBits = 8;
+  static constexpr size_type kTableSize = size_type{1} << kTableBits;
+  static constexpr size_type kTables = kWordBits / kTableBits;
+
+  void check_index(size_type row, size_type col) const {
+	if (row >= rows_ || col >= cols_)
+	  throw std::out_of_range("row or col is out of range of matrix");
+  }
+
+  void clear_padding() noexcept {
+	const size_type used = cols_ % kWordBits;
+	if (used == 0)
+	  return;
+
+	const word_type mask = (word_type{1} << used) - 1;
+	for (size_type row = 0; row != rows_; ++row)
+	  words_[row * words_per_row_ + words_per_row_ - 1] &= mask;
+  }
+
+  template<typename Operation>
+  bit_matrix &combine(const bit_matrix &rhs, Operation op) {
+	if (rows_ != rhs.rows_ || cols_ != rhs.cols_)
+	  throw std::logic_error("Can't combine two matrices of different sizes");
+
+	for (size_type index = 0; index != words_.size(); ++index)
+	  words_[index] = op(words_[index], rhs.words_[index]);
+	return *this;
+  }
+
+  /**
+   * table[subset] = union of the rows first + bit of rhs for the bits of subset,
+   * the rows after rhs.rows() are empty
+   */
+  static void build_table(const bit_matrix &rhs, size_type first, word_type *table) {
+	const size_type words = rhs.words_per_row_;
+	std::fill(table, table + words, word_type{0});
+
+	for (size_type bit = 0; bit != kTableBits; ++bit) {
+	  const size_type begin = size_type{1} << bit;
+	  const word_type *row = first + bit < rhs.rows_ ? rhs.row_data(first + bit) : nullptr;
+
+	  for (size_type subset = begin; subset != 2 * begin; ++subset) {
+		const word_type *without = table + (subset - begin) * words;
+		word_type *out = table + subset * words;
+
+		for (size_type index = 0; index != words; ++index)
+		  out[index] = row != nullptr ? without[index] | row[index] : without[index];
+	  }
+	}
+  }
+
+  /**
+   * Calls f(row) for every row, the rows are split between the threads of the policy
+   */
+  template<typename Function>
+  void for_each_row(const execution_policy &policy, size_type cols, Function &&f) const {
+	const size_type threads = std::min(policy.threads_for(rows_ * cols), rows_);
+	if (threads <= 1) {
+	  for (size_type row = 0; row != rows_; ++row)
+		f(row);
+	  return;
+	}
+
+	detail::parallel_ranges(threads, rows_, 1, [&f](size_type, size_type first, size_type last) {
+	  for (; first != last; ++first)
+		f(first);
+	});
+  }
+
+private:
+  size_type rows_{}, cols_{}, words_per_row_{};
+  std::vector<word_type> words_;
+};
+
+inline std::ostream &operator<<(std::ostream &out, const bit_matrix &rhs) {
+  rhs.print(out);
+  return out;
+}
+
+inline bit_matrix operator&(const bit_matrix &lhs, const bit_matrix &rhs) {
+  bit_matrix result(lhs);
+  result.bit_and(rhs);
+  return result;
+}
+
+inline bit_matrix operator|(const bit_matrix &lhs, const bit_matrix &rhs) {
+  bit_matrix result(lhs);
+  result.bit_or(rhs);
+  return result;
+}
+
+inline bit_matrix operator^(const bit_matrix &lhs, const bit_matrix &rhs) {
+  bit_matrix result(lhs);
+  result.bit_xor(rhs);
+  return result;
+}
+
+inline bit_matrix operator~(const bit_matrix &rhs) {
+  bit_matrix result(rhs);
+  result.flip();
+  return result;
+}
+
+inline bit_matrix &operator&=(bit_matrix &lhs, const bit_matrix &rhs) {
+  return lhs.bit_and(rhs);
+}
+
+inline bit_matrix &operator|=(bit_matrix &lhs, const bit_matrix &rhs) {
+  return lhs.bit_or(rhs);
+}
+
+inline bit_matrix &operator^=(bit_matrix &lhs, const bit_matrix &rhs) {
+  return lhs.bit_xor(rhs);
+}
+
+inline bit_matrix operator*(const bit_matrix &lhs, const bit_matrix &rhs) {
+  return lhs.mul(rhs);
+}
+
+inline bool operator==(const bit_matrix &lhs, const bit_matrix &rhs) {
+  return lhs.equal_to(rhs);
+}
+
+inline bool operator!=(const bit_matrix &lhs, const bit_matrix &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_BIT_MATRIX_H_
@@ -0,0 +1,122 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Element wise comparison kernels over contiguous storage
+ *        shared by the matrix containers
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_COMPARE_H_
+#define MTLT_COMPARE_H_
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+namespace mtlt {
+
+namespace detail {
+
+/**
+ * Elements are compared in blocks, the loop inside of a block has no branches
+ * so the compiler vectorizes it, the result is checked between the blocks
+ */
+constexpr std::size_t kCompareBlock = 256;
+
+/**
+ * Types whose equality is equality of their bytes
+ */
+template<typename T>
+struct is_bitwise_comparable : std::integral_constant<bool,
+	std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value> {};
+
+template<typename T, typename EqualCompare>
+bool equal_elements(const T *lhs, const T *rhs, std::size_t count, EqualCompare compare, std::false_type) {
+  return std::equal(lhs, lhs + count, rhs, compare);
+}
+
+template<typename T, typename EqualCompare>
+bool equal_elements(const T *lhs, const T *rhs, std::size_t count, EqualCompare, std::true_type) {
+  return count == 0 || std::memcmp(lhs, rhs, count * sizeof(T)) == 0;
+}
+
+/**
+ * std::equal_to of integral, enum and pointer types is done by memcmp
+ */
+template<typename T, typename EqualCompare>
+bool equal_elements(const T *lhs, const T *rhs, std::size_t count, EqualCompare compare) {
+  using bitwise = std::integral_constant<bool,
+	  is_bitwise_comparable<T>::value && std::is_same<EqualCompare, std::equal_to<T>>::value>;
+  return equal_elements(lhs, rhs, count, compare, bitwise());
+}
+
+/**
+ * |lhs - rhs| <= max(abs_tol, rel_tol * max(|lhs|, |rhs|)) for every element,
+ * equal infinities are close, NaN is never close
+ */
+template<typename T>
+bool approx_equal_elements(const T *lhs, const T *rhs, std::size_t count, T abs_tol, T rel_tol) {
+  for (std::size_t first = 0; first < count; first += kCompareBlock) {
+	const std::size_t last = std::min(first + kCompareBlock, count);
+
+	bool close = true;
+	for (std::size_t i = first; i != last; ++i) {
+	  const T a = lhs[i], b = rhs[i];
+	  const T tolerance = std::max(abs_tol, rel_tol * std::max(std::fabs(a), std::fabs(b)));
+	  close &= (a == b) | (std::fabs(a - b) <= tolerance);
+	}
+
+	if (!close)
+	  return false;
+  }
+
+  return true;
+}
+
+/**
+ * max |lhs - rhs|, NaN if any difference is NaN
+ */
+template<typename T>
+T max_abs_diff_elements(const T *lhs, const T *rhs, std::size_t count) {
+  T max_diff{};
+  bool nan = false;
+
+  for (std::size_t first = 0; first < count; first += kCompareBlock) {
+	const std::size_t last = std::min(first + kCompareBlock, count);
+
+	for (std::size_t i = first; i != last; ++i) {
+	  const T diff = std::fabs(lhs[i] - rhs[i]);
+	  nan |= diff != diff;
+	  max_diff = diff > max_diff ? diff : max_diff;
+	}
+
+	if (nan)
+	  return std::numeric_limits<T>::quiet_NaN();
+  }
+
+  return max_diff;
+}
+
+} // namespace detail end
+
+} // namespace mtlt end
+
+#endif // MTLT_COMPARE_H_
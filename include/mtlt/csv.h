@@ -0,0 +1,394 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Reading and writing numeric matrices as CSV / TSV text
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_CSV_H_
+#define MTLT_CSV_H_
+
+#include <limits>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#  if __has_include(<charconv>)
+#    include <charconv>
+#  endif
+#endif
+
+#include <mtlt/matrix.h>
+#include <mtlt/parallel.h>
+#include <mtlt/matrix_config.h>
+#include <mtlt/file_mapping.h>
+
+namespace mtlt {
+
+/**
+ * @struct matrix_csv_settings
+ *
+ * delimiter   - field separator, ',' for CSV and '\t' for TSV
+ * skip_header - the first line holds column names and is ignored on read
+ * precision   - significant digits of floating point values on write,
+ *               negative value writes the shortest text that reads back exactly
+ * threads     - count of parsing threads on read, 0 uses all hardware threads
+ * buffer_size - size of the output buffer on write
+ */
+struct matrix_csv_settings {
+  char delimiter = ',';
+  bool skip_header = false;
+  int precision = -1;
+  unsigned threads = 0;
+  std::size_t buffer_size = 1 << 20;
+};
+
+namespace detail {
+
+#if defined(__cpp_lib_to_chars)
+
+template<typename T>
+inline const char *parse_number(const char *first, const char *last, T &value) noexcept {
+  if (first != last && *first == '+')
+	++first;
+
+  const std::from_chars_result result = std::from_chars(first, last, value);
+  return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+template<typename T>
+inline char *format_number(char *first, char *last, T value, int precision, std::true_type) noexcept {
+  const std::to_chars_result result = precision >= 0
+	  ? std::to_chars(first, last, value, std::chars_format::general, precision)
+	  : std::to_chars(first, last, value);
+  return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+template<typename T>
+inline char *format_number(char *first, char *last, T value, int, std::false_type) noexcept {
+  const std::to_chars_result result = std::to_chars(first, last, value);
+  return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+template<typename T>
+inline char *format_number(char *first, char *last, T value, int precision) noexcept {
+  return format_number(first, last, value, precision, std::is_floating_point<T>());
+}
+
+#else
+
+inline bool is_number_char(char c) noexcept {
+  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+	  || c == '.' || c == '-' || c == '+';
+}
+
+/**
+ * The number is copied to a terminated buffer because strto* functions
+ * would otherwise read past the end of a mapped file
+ */
+template<typename T>
+inline const char *parse_number(const char *first, const char *last, T &value) noexcept {
+  char buffer[128];
+  std::size_t length = 0;
+
+  while (first + length != last && length != sizeof(buffer) - 1 && is_number_char(first[length]))
+	++length;
+
+  if (length == 0)
+	return nullptr;
+
+  std::memcpy(buffer, first, length);
+  buffer[length] = '\0';
+
+  char *end = nullptr;
+  errno = 0;
+
+  if (std::is_floating_point<T>::value) {
+	value = static_cast<T>(std::strtold(buffer, &end));
+  } else if (std::is_signed<T>::value) {
+	const long long parsed = std::strtoll(buffer, &end, 10);
+	if (parsed < static_cast<long long>(std::numeric_limits<T>::min())
+		|| parsed > static_cast<long long>(std::numeric_limits<T>::max()))
+	  return nullptr;
+	value = static_cast<T>(parsed);
+  } else {
+	const unsigned long long parsed = std::strtoull(buffer, &end, 10);
+	if (buffer[0] == '-' || parsed > static_cast<unsigned long long>(std::numeric_limits<T>::max()))
+	  return nullptr;
+	value = static_cast<T>(parsed);
+  }
+
+  if (errno == ERANGE || end != buffer + length)
+	return nullptr;
+
+  return first + length;
+}
+
+template<typename T>
+inline char *format_number(char *first, char *last, T value, int precision) noexcept {
+  int written;
+
+  if (std::is_floating_point<T>::value)
+	written = std::snprintf(first, static_cast<std::size_t>(last - first), "%.*Lg",
+							precision >= 0 ? precision : std::numeric_limits<T>::max_digits10,
+							static_cast<long double>(value));
+  else if (std::is_signed<T>::value)
+	written = std::snprintf(first, static_cast<std::size_t>(last - first), "%lld", static_cast<long long>(value));
+  else
+	written = std::snprintf(first, static_cast<std::size_t>(last - first), "%llu",
+							static_cast<unsigned long long>(value));
+
+  return written < 0 || written >= last - first ? nullptr : first + written;
+}
+
+#endif
+
+inline const char *skip_blanks(const char *first, const char *last, char delimiter) noexcept {
+  while (first != last && (*first == ' ' || (*first == '\t' && delimiter != '\t')))
+	++first;
+  return first;
+}
+
+inline const char *line_end(const char *first, const char *last) noexcept {
+  const void *found = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+  return found ? static_cast<const char *>(found) : last;
+}
+
+/**
+ * Line without the trailing '\r', empty if it has only blanks
+ */
+inline const char *trim_line(const char *first, const char *last, char delimiter) noexcept {
+  if (last != first && last[-1] == '\r')
+	--last;
+  return skip_blanks(first, last, delimiter) == last ? first : last;
+}
+
+inline std::size_t count_fields(const char *first, const char *last, char delimiter) noexcept {
+  std::size_t fields = 1;
+  for (; first != last; ++first)
+	if (*first == delimiter)
+	  ++fields;
+  return fields;
+}
+
+/**
+ * Splits [first, last) into chunks of whole lines, one chunk per thread
+ */
+inline std::vector<const char *> split_lines(const char *first, const char *last, std::size_t chunks) {
+  std::vector<const char *> bounds(chunks + 1, last);
+  bounds[0] = first;
+
+  const std::size_t size = static_cast<std::size_t>(last - first);
+  for (std::size_t chunk = 1; chunk != chunks; ++chunk) {
+	const char *bound = first + size / chunks * chunk;
+	bound = bound < bounds[chunk - 1] ? bounds[chunk - 1] : bound;
+	bound = line_end(bound, last);
+	bounds[chunk] = bound == last ? last : bound + 1;
+  }
+
+  return bounds;
+}
+
+template<typename T>
+void parse_csv_rows(const char *first, const char *last, T *data,
+					std::size_t row, std::size_t cols, char delimiter) {
+  while (first != last) {
+	const char *eol = line_end(first, last);
+	const char *end = trim_line(first, eol, delimiter);
+
+	if (end != first) {
+	  const char *field = first;
+	  for (std::size_t col = 0; col != cols; ++col) {
+		field = skip_blanks(field, end, delimiter);
+		field = parse_number(field, end, *data++);
+
+		if (field != nullptr)
+		  field = skip_blanks(field, end, delimiter);
+
+		const bool separated = field != nullptr
+			&& (col + 1 == cols ? field == end : field != end && *field++ == delimiter);
+
+		if (!separated)
+		  throw std::runtime_error("Can't parse csv because row " + std::to_string(row)
+									   + " has invalid number or count of fields other than "
+									   + std::to_string(cols));
+	  }
+	  ++row;
+	}
+
+	first = eol == last ? last : eol + 1;
+  }
+}
+
+inline std::size_t count_csv_rows(const char *first, const char *last, char delimiter) noexcept {
+  std::size_t rows = 0;
+
+  while (first != last) {
+	const char *eol = line_end(first, last);
+	if (trim_line(first, eol, delimiter) != first)
+	  ++rows;
+	first = eol == last ? last : eol + 1;
+  }
+
+  return rows;
+}
+
+template<typename T>
+inline auto csv_value(const T &value) -> typename std::enable_if<std::is_arithmetic<T>::value, T>::type {
+  return value;
+}
+
+template<typename Atomic>
+inline auto csv_value(const Atomic &value) -> decltype(value.load()) {
+  return value.load();
+}
+
+} // namespace detail end
+
+/**
+ * Parses a numeric CSV text into a matrix. Dimensions are taken from the text:
+ * cols from the first row, rows from the count of non empty lines.
+ * The text is split into chunks of whole lines, every chunk is counted and then
+ * parsed by its own thread straight into the matrix buffer.
+ * Throws std::runtime_error if a row has another count of fields
+ * or a field is not a number of type T
+ */
+template<typename T>
+matrix<T> parse_csv(const char *data, std::size_t size, matrix_csv_settings settings = matrix_csv_settings{}) {
+  static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+				"csv supports only numeric matrices");
+
+  const std::size_t kMinChunkSize = 1 << 18;
+  const char delimiter = settings.delimiter;
+  const char *last = data + size;
+  const char *first = data;
+
+  if (settings.skip_header && first != last) {
+	first = detail::line_end(first, last);
+	first = first == last ? last : first + 1;
+  }
+
+  // The first non empty line defines the count of columns
+  const char *line = first;
+  const char *line_last = line;
+  while (line != last && (line_last = detail::trim_line(line, detail::line_end(line, last), delimiter)) == line) {
+	line = detail::line_end(line, last);
+	line = line == last ? last : line + 1;
+  }
+
+  if (line == last)
+	return matrix<T>();
+
+  const std::size_t cols = detail::count_fields(line, line_last, delimiter);
+
+  std::size_t chunks = settings.threads == 0 ? detail::available_threads() : settings.threads;
+  chunks = std::max<std::size_t>(1, std::min<std::size_t>(chunks, static_cast<std::size_t>(last - line) / kMinChunkSize));
+
+  const std::vector<const char *> bounds = detail::split_lines(line, last, chunks);
+  std::vector<std::size_t> offsets(chunks + 1);
+
+  detail::parallel_tasks(chunks, [&](std::size_t chunk) {
+	offsets[chunk + 1] = detail::count_csv_rows(bounds[chunk], bounds[chunk + 1], delimiter);
+  });
+
+  for (std::size_t chunk = 0; chunk != chunks; ++chunk)
+	offsets[chunk + 1] += offsets[chunk];
+
+  matrix<T> m(offsets[chunks], cols);
+  T *elements = m.data();
+
+  detail::parallel_tasks(chunks, [&](std::size_t chunk) {
+	detail::parse_csv_rows(bounds[chunk], bounds[chunk + 1], elements + offsets[chunk] * cols,
+						   offsets[chunk], cols, delimiter);
+  });
+
+  return m;
+}
+
+template<typename T>
+matrix<T> read_csv(std::istream &is, matrix_csv_settings settings = matrix_csv_settings{}) {
+  const std::string text((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+  return parse_csv<T>(text.data(), text.size(), settings);
+}
+
+/**
+ * The file is mapped into memory and parsed in place, without an intermediate copy
+ */
+template<typename T>
+matrix<T> read_csv(const std::string &path, matrix_csv_settings settings = matrix_csv_settings{}) {
+  const detail::file_mapping mapping(path, map_mode::read_only);
+  mapping.advise(access_hint::sequential, 0, mapping.size());
+
+  return parse_csv<T>(mapping.data(), mapping.size(), settings);
+}
+
+/**
+ * Writes any matrix of numbers (matrix, static_matrix, atomic_matrix, ...) row by row.
+ * Numbers are formatted into a large buffer that is passed to the stream when full
+ */
+template<typename Matrix>
+void write_csv(std::ostream &os, const Matrix &m, matrix_csv_settings settings = matrix_csv_settings{}) {
+  const std::size_t kMaxFieldSize = 512;
+
+  std::vector<char> buffer(std::max(settings.buffer_size, 2 * kMaxFieldSize));
+  char *const first = buffer.data();
+  char *const last = first + buffer.size();
+  char *current = first;
+
+  for (std::size_t row = 0; row != m.rows(); ++row) {
+	for (std::size_t col = 0; col != m.cols(); ++col) {
+	  if (static_cast<std::size_t>(last - current) < kMaxFieldSize) {
+		os.write(first, current - first);
+		current = first;
+	  }
+
+	  current = detail::format_number(current, current + kMaxFieldSize - 1,
+									  detail::csv_value(m(row, col)), settings.precision);
+	  if (current == nullptr)
+		throw std::runtime_error("Can't write csv because number is too long");
+
+	  *current++ = col + 1 == m.cols() ? '\n' : settings.delimiter;
+	}
+  }
+
+  os.write(first, current - first);
+
+  if (!os)
+	throw std::runtime_error("Can't write csv to stream");
+}
+
+template<typename Matrix>
+void write_csv(const Matrix &m, const std::string &path, matrix_csv_settings settings = matrix_csv_settings{}) {
+  std::ofstream os(path, std::ios::binary | std::ios::trunc);
+  if (!os.is_open())
+	throw std::runtime_error("Can't open file " + path + " for writing");
+
+  write_csv(os, m, settings);
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_CSV_H_
@@ -0,0 +1,324 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        The diagonal_matrix container class stores only
+ *        the main diagonal of a square matrix
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_DIAGONAL_MATRIX_H_
+#define MTLT_DIAGONAL_MATRIX_H_
+
+#include <iomanip>
+#include <numeric>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <mtlt/matrix.h>
+#include <mtlt/matrix_config.h>
+#include <mtlt/matrix_normal_iterator.h>
+
+namespace mtlt {
+
+/**
+ * @class diagonal_matrix
+ *
+ * Square matrix with zeros outside of the main diagonal,
+ * only rows() elements are stored
+ *
+ * @code
+ *
+ * mtlt::diagonal_matrix<double> d(3, {1.0, 2.0, 3.0});
+ *
+ * mtlt::matrix<double> scaled = d.mul(a); // rows of a are scaled
+ * d.scale_cols(a);                         // a = a * d, in place
+ *
+ * @endcode
+ */
+template<typename T>
+class diagonal_matrix final {
+public:
+  using value_type = T;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using size_type = std::size_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = matrix_normal_iterator<pointer>;
+  using const_iterator = matrix_normal_iterator<const_pointer>;
+
+public:
+  MATRIX_CXX17_CONSTEXPR diagonal_matrix() noexcept = default;
+
+  MATRIX_CXX17_CONSTEXPR explicit diagonal_matrix(size_type order, value_type f = {})
+	  : order_(order), data_(new value_type[order]{}) {
+	if (f != value_type{})
+	  std::fill(begin(), end(), f);
+  }
+
+  MATRIX_CXX20_CONSTEXPR diagonal_matrix(size_type order, const std::initializer_list<T> &initializer)
+	  : diagonal_matrix(order) {
+	std::copy(initializer.begin(), initializer.end(), begin());
+  }
+
+  /**
+   * Takes the main diagonal of a square matrix, the other elements are ignored
+   */
+  explicit diagonal_matrix(const matrix<T> &full)
+	  : diagonal_matrix(full.rows()) {
+	if (full.rows() != full.cols())
+	  throw std::logic_error("Only square matrices can be packed as diagonal");
+
+	for (size_type i = 0; i != order_; ++i)
+	  data_[i] = full(i, i);
+  }
+
+  MATRIX_CXX17_CONSTEXPR diagonal_matrix(const diagonal_matrix &other)
+	  : diagonal_matrix(other.order_) {
+	std::copy(other.begin(), other.end(), begin());
+  }
+
+  MATRIX_CXX17_CONSTEXPR diagonal_matrix(diagonal_matrix &&other) noexcept
+	  : order_(other.order_), data_(other.data_) {
+	other.order_ = size_type{};
+	other.data_ = nullptr;
+  }
+
+  MATRIX_CXX17_CONSTEXPR diagonal_matrix &operator=(const diagonal_matrix &other) {
+	if (&other == this)
+	  return *this;
+
+	diagonal_matrix tmp(other);
+	*this = std::move(tmp);
+
+	return *this;
+  }
+
+  MATRIX_CXX17_CONSTEXPR diagonal_matrix &operator=(diagonal_matrix &&other) noexcept {
+	if (&other == this)
+	  return *this;
+
+	std::swap(order_, other.order_);
+	std::swap(data_, other.data_);
+
+	return *this;
+  }
+
+  ~diagonal_matrix() noexcept {
+	delete[] data_;
+  }
+
+public:
+  MATRIX_CXX17_CONSTEXPR
+  iterator begin() noexcept { return iterator(data_); }
+
+  MATRIX_CXX17_CONSTEXPR
+  const_iterator begin() const noexcept { return const_iterator(data_); }
+
+  MATRIX_CXX17_CONSTEXPR
+  iterator end() noexcept { return iterator(data_ + order_); }
+
+  MATRIX_CXX17_CONSTEXPR
+  const_iterator end() const noexcept { return const_iterator(data_ + order_); }
+
+public:
+  reference operator[](size_type i) {
+	return data_[i];
+  }
+
+  const_reference operator[](size_type i) const {
+	return data_[i];
+  }
+
+  value_type operator()(size_type row, size_type col) const {
+	return row == col ? data_[row] : value_type{};
+  }
+
+  value_type at(size_type row, size_type col) const {
+	if (row >= order_ || col >= order_)
+	  throw std::out_of_range("row or col is out of range of matrix");
+
+	return (*this)(row, col);
+  }
+
+  MATRIX_CXX17_NODISCARD
+  size_type rows() const noexcept { return order_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type cols() const noexcept { return order_; }
+
+  /**
+   * Count of stored diagonal elements, not rows() * cols()
+   */
+  MATRIX_CXX17_NODISCARD
+  size_type size() const noexcept { return order_; }
+
+public:
+  void print(std::ostream &os = std::cout, matrix_debug_settings s = matrix_debug_settings{}) const {
+	for (size_type row = 0; row != order_; ++row) {
+	  for (size_type col = 0; col != order_; ++col) {
+		os << std::setw(s.width)
+		   << std::setprecision(s.precision)
+		   << (*this)(row, col)
+		   << s.separator;
+	  }
+	  os << s.end;
+	}
+
+	if (s.is_double_end)
+	  os << s.end;
+  }
+
+  matrix<T> to_matrix() const {
+	matrix<T> full(order_, order_);
+
+	for (size_type i = 0; i != order_; ++i)
+	  full(i, i) = data_[i];
+
+	return full;
+  }
+
+  /**
+   * Returns this * rhs, i.e. rhs with every row scaled by the diagonal element
+   */
+  matrix<T> mul(const matrix<T> &rhs) const {
+	matrix<T> multiplied(rhs);
+	scale_rows(multiplied);
+	return multiplied;
+  }
+
+  diagonal_matrix mul(const diagonal_matrix &rhs) const {
+	if (order_ != rhs.order_)
+	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
+
+	diagonal_matrix multiplied(*this);
+	std::transform(multiplied.begin(), multiplied.end(), rhs.begin(), multiplied.begin(),
+				   [](const value_type &lhs, const value_type &rhs) { return lhs * rhs; });
+	return multiplied;
+  }
+
+  /**
+   * In place target = this * target
+   */
+  void scale_rows(matrix<T> &target) const {
+	if (order_ != target.rows())
+	  throw std::logic_error("Can't scale rows because lhs.cols() != rhs.rows()");
+
+	const size_type cols = target.cols();
+	for (size_type row = 0; row != order_; ++row) {
+	  const value_type factor = data_[row];
+	  for (size_type col = 0; col != cols; ++col)
+		target(row, col) *= factor;
+	}
+  }
+
+  /**
+   * In place target = target * this
+   */
+  void scale_cols(matrix<T> &target) const {
+	if (order_ != target.cols())
+	  throw std::logic_error("Can't scale cols because lhs.cols() != rhs.rows()");
+
+	const size_type rows = target.rows();
+	for (size_type row = 0; row != rows; ++row)
+	  for (size_type col = 0; col != order_; ++col)
+		target(row, col) *= data_[col];
+  }
+
+  /**
+   * Solves this * x == rhs, every row of rhs is divided by the diagonal element
+   */
+  matrix<T> solve(const matrix<T> &rhs) const {
+	if (order_ != rhs.rows())
+	  throw std::logic_error("Can't solve system because lhs.rows() != rhs.rows()");
+
+	if (std::find(begin(), end(), value_type{}) != end())
+	  throw std::logic_error("Can't solve system because diagonal matrix is singular");
+
+	matrix<T> x(rhs);
+	const size_type cols = x.cols();
+	for (size_type row = 0; row != order_; ++row) {
+	  const value_type diagonal = data_[row];
+	  for (size_type col = 0; col != cols; ++col)
+		x(row, col) /= diagonal;
+	}
+
+	return x;
+  }
+
+  diagonal_matrix inverse() const {
+	if (std::find(begin(), end(), value_type{}) != end())
+	  throw std::logic_error("Can't found inverse matrix because determinant is zero");
+
+	diagonal_matrix inversed(order_);
+	std::transform(begin(), end(), inversed.begin(), [](const value_type &item) { return value_type{1} / item; });
+	return inversed;
+  }
+
+  value_type determinant() const {
+	value_type determinant_value{1};
+	for (const value_type &item : *this)
+	  determinant_value *= item;
+	return determinant_value;
+  }
+
+  value_type trace() const {
+	return std::accumulate(begin(), end(), value_type{});
+  }
+
+  template<typename EqualCompare = std::equal_to<value_type>>
+  bool equal_to(const diagonal_matrix &rhs) const {
+	return order_ == rhs.order_ && std::equal(begin(), end(), rhs.begin(), EqualCompare());
+  }
+
+private:
+  size_type order_{};
+  pointer data_ = nullptr;
+};
+
+template<typename T>
+std::ostream &operator<<(std::ostream &out, const diagonal_matrix<T> &rhs) {
+  rhs.print(out);
+  return out;
+}
+
+template<typename T>
+matrix<T> inline operator*(const diagonal_matrix<T> &lhs, const matrix<T> &rhs) {
+  return lhs.mul(rhs);
+}
+
+template<typename T>
+matrix<T> inline operator*(const matrix<T> &lhs, const diagonal_matrix<T> &rhs) {
+  matrix<T> result(lhs);
+  rhs.scale_cols(result);
+  return result;
+}
+
+template<typename T>
+bool inline operator==(const diagonal_matrix<T> &lhs, const diagonal_matrix<T> &rhs) {
+  return lhs.equal_to(rhs);
+}
+
+template<typename T>
+bool inline operator!=(const diagonal_matrix<T> &lhs, const diagonal_matrix<T> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_DIAGONAL_MATRIX_H_
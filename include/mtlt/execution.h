@@ -0,0 +1,158 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Execution policies of the element wise matrix operations
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_EXECUTION_H_
+#define MTLT_EXECUTION_H_
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+// libstdc++ implements the standard parallel algorithms on top of TBB,
+// so they are used only when asked for and the program links with TBB
+#ifdef MTLT_USE_STD_EXECUTION
+#include <execution>
+#endif
+
+#include <mtlt/parallel.h>
+#include <mtlt/matrix_config.h>
+
+namespace mtlt {
+
+/**
+ * @class execution_policy
+ *
+ * Describes how an element wise operation is run: the elements are split
+ * into contiguous ranges processed on threads() threads (0 uses all hardware
+ * threads), operations on less than threshold() elements stay on the calling thread
+ *
+ * The loops over a range are simple enough to be vectorized by the compiler,
+ * so there is no separate unsequenced policy
+ *
+ * With MTLT_USE_STD_EXECUTION defined std::execution::par and par_unseq
+ * are accepted too and run the ranges with the standard parallel algorithms
+ *
+ * @code
+ *
+ * m.transform(mtlt::execution::par, [](double x) { return std::exp(x); });
+ * m.add(mtlt::execution::par.with_threads(4), 1.0);
+ *
+ * @endcode
+ */
+class execution_policy {
+public:
+  static constexpr std::size_t kDefaultThreshold = 1 << 16;
+
+public:
+  constexpr explicit execution_policy(std::size_t threads = 0, std::size_t threshold = kDefaultThreshold) noexcept
+	  : threads_(threads), threshold_(threshold) {}
+
+#ifdef MTLT_USE_STD_EXECUTION
+  execution_policy(const std::execution::sequenced_policy &) noexcept
+	  : execution_policy(1) {}
+
+  execution_policy(const std::execution::parallel_policy &) noexcept
+	  : threads_(0), threshold_(kDefaultThreshold), standard_(true) {}
+
+  execution_policy(const std::execution::parallel_unsequenced_policy &) noexcept
+	  : threads_(0), threshold_(kDefaultThreshold), standard_(true) {}
+#endif
+
+public:
+  MATRIX_CXX17_NODISCARD
+  constexpr execution_policy with_threads(std::size_t threads) const noexcept {
+	return execution_policy(threads, threshold_);
+  }
+
+  MATRIX_CXX17_NODISCARD
+  constexpr execution_policy with_threshold(std::size_t threshold) const noexcept {
+	return execution_policy(threads_, threshold);
+  }
+
+  MATRIX_CXX17_NODISCARD
+  constexpr std::size_t threads() const noexcept { return threads_; }
+
+  MATRIX_CXX17_NODISCARD
+  constexpr std::size_t threshold() const noexcept { return threshold_; }
+
+  MATRIX_CXX17_NODISCARD
+  constexpr bool is_standard() const noexcept { return standard_; }
+
+  /**
+   * Count of threads used for count elements
+   */
+  std::size_t threads_for(std::size_t count) const noexcept {
+	if (count < threshold_ || count < 2)
+	  return 1;
+
+	const std::size_t threads = threads_ == 0 ? detail::available_threads() : threads_;
+	return std::min(threads, count);
+  }
+
+private:
+  std::size_t threads_;
+  std::size_t threshold_;
+  bool standard_ = false;
+};
+
+namespace execution {
+
+MATRIX_CXX17_INLINE constexpr execution_policy seq{1};
+MATRIX_CXX17_INLINE constexpr execution_policy par{};
+
+} // namespace execution end
+
+namespace detail {
+
+/**
+ * Calls f(first, last) for consecutive parts of [0, count), in parallel as the policy says
+ */
+template<typename Function>
+void for_each_range(const execution_policy &policy, std::size_t count, Function &&f) {
+  const std::size_t threads = policy.threads_for(count);
+  if (threads == 1) {
+	f(std::size_t{0}, count);
+	return;
+  }
+
+#ifdef MTLT_USE_STD_EXECUTION
+  if (policy.is_standard()) {
+	std::vector<std::size_t> tasks(threads);
+	for (std::size_t task = 0; task != threads; ++task)
+	  tasks[task] = task;
+
+	std::for_each(std::execution::par, tasks.begin(), tasks.end(), [&](std::size_t task) {
+	  f(count * task / threads, count * (task + 1) / threads);
+	});
+	return;
+  }
+#endif
+
+  parallel_ranges(threads, count, 1, [&f](std::size_t, std::size_t first, std::size_t last) {
+	f(first, last);
+  });
+}
+
+} // namespace detail end
+
+} // namespace mtlt end
+
+#endif // MTLT_EXECUTION_H_
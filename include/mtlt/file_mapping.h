@@ -0,0 +1,286 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Thin RAII wrapper over mmap / MapViewOfFile
+ *        used by the file backed matrices
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_FILE_MAPPING_H_
+#define MTLT_FILE_MAPPING_H_
+
+#include <string>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
+#include <mtlt/matrix_config.h>
+
+namespace mtlt {
+
+/**
+ * @enum map_mode
+ *
+ * read_only  - the file is never modified, writes through the mapping
+ *              go to private copy on write pages and are dropped on unmap
+ * read_write - the mapping is shared, writes reach the file
+ */
+enum class map_mode {
+  read_only,
+  read_write
+};
+
+/**
+ * @enum access_hint
+ * Expected access pattern, passed to madvise
+ */
+enum class access_hint {
+  normal,
+  sequential,
+  random,
+  will_need
+};
+
+namespace detail {
+
+class file_mapping {
+public:
+  file_mapping() noexcept = default;
+
+  /**
+   * Maps the whole existing file
+   */
+  file_mapping(const std::string &path, map_mode mode) : mode_(mode) {
+#if defined(_WIN32)
+	const DWORD access = mode == map_mode::read_write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+	HANDLE file = CreateFileA(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+							  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	  throw std::runtime_error("Can't open file " + path + " for mapping");
+
+	LARGE_INTEGER size;
+	GetFileSizeEx(file, &size);
+	size_ = static_cast<std::size_t>(size.QuadPart);
+	map(file, path);
+	CloseHandle(file);
+#else
+	const int fd = ::open(path.c_str(), mode == map_mode::read_write ? O_RDWR : O_RDONLY);
+	if (fd == -1)
+	  throw std::runtime_error("Can't open file " + path + " for mapping: " + std::strerror(errno));
+
+	struct stat info;
+	if (::fstat(fd, &info) == -1) {
+	  ::close(fd);
+	  throw std::runtime_error("Can't get size of file " + path + ": " + std::strerror(errno));
+	}
+
+	size_ = static_cast<std::size_t>(info.st_size);
+	map(fd, path);
+	::close(fd);
+#endif
+  }
+
+  /**
+   * Creates (or truncates) the file with size bytes and maps it for read and write
+   */
+  static file_mapping create(const std::string &path, std::size_t size) {
+	file_mapping mapping;
+	mapping.mode_ = map_mode::read_write;
+	mapping.size_ = size;
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+							  CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	  throw std::runtime_error("Can't create file " + path);
+
+	LARGE_INTEGER distance;
+	distance.QuadPart = static_cast<LONGLONG>(size);
+	if (!SetFilePointerEx(file, distance, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+	  CloseHandle(file);
+	  throw std::runtime_error("Can't resize file " + path);
+	}
+
+	mapping.map(file, path);
+	CloseHandle(file);
+#else
+	const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd == -1)
+	  throw std::runtime_error("Can't create file " + path + ": " + std::strerror(errno));
+
+	if (::ftruncate(fd, static_cast<off_t>(size)) == -1) {
+	  ::close(fd);
+	  throw std::runtime_error("Can't resize file " + path + ": " + std::strerror(errno));
+	}
+
+	mapping.map(fd, path);
+	::close(fd);
+#endif
+	return mapping;
+  }
+
+  file_mapping(const file_mapping &) = delete;
+  file_mapping &operator=(const file_mapping &) = delete;
+
+  file_mapping(file_mapping &&other) noexcept
+	  : mode_(other.mode_), size_(other.size_), data_(other.data_) {
+	other.size_ = 0;
+	other.data_ = nullptr;
+  }
+
+  file_mapping &operator=(file_mapping &&other) noexcept {
+	if (&other == this)
+	  return *this;
+
+	std::swap(mode_, other.mode_);
+	std::swap(size_, other.size_);
+	std::swap(data_, other.data_);
+
+	return *this;
+  }
+
+  ~file_mapping() noexcept {
+	unmap();
+  }
+
+public:
+  MATRIX_CXX17_NODISCARD
+  char *data() const noexcept { return data_; }
+
+  MATRIX_CXX17_NODISCARD
+  std::size_t size() const noexcept { return size_; }
+
+  MATRIX_CXX17_NODISCARD
+  map_mode mode() const noexcept { return mode_; }
+
+  /**
+   * Advises the kernel about the access pattern of [offset, offset + length)
+   */
+  void advise(access_hint hint, std::size_t offset, std::size_t length) const noexcept {
+#if defined(_WIN32)
+	(void) hint, (void) offset, (void) length;
+#else
+	if (data_ == nullptr || length == 0)
+	  return;
+
+	const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	const std::size_t begin = offset / page * page;
+
+	int advice = MADV_NORMAL;
+	switch (hint) {
+	  case access_hint::sequential: advice = MADV_SEQUENTIAL; break;
+	  case access_hint::random: advice = MADV_RANDOM; break;
+	  case access_hint::will_need: advice = MADV_WILLNEED; break;
+	  default: break;
+	}
+
+	::madvise(data_ + begin, offset + length - begin, advice);
+#endif
+  }
+
+  /**
+   * Writes dirty pages of a read_write mapping back to the file
+   */
+  void flush() const {
+	if (data_ == nullptr || mode_ != map_mode::read_write)
+	  return;
+
+#if defined(_WIN32)
+	if (!FlushViewOfFile(data_, 0))
+	  throw std::runtime_error("Can't flush mapped file");
+#else
+	if (::msync(data_, size_, MS_SYNC) == -1)
+	  throw std::runtime_error(std::string("Can't flush mapped file: ") + std::strerror(errno));
+#endif
+  }
+
+private:
+#if defined(_WIN32)
+  void map(HANDLE file, const std::string &path) {
+	if (size_ == 0)
+	  return;
+
+	const bool write = mode_ == map_mode::read_write;
+	HANDLE mapping = CreateFileMappingA(file, nullptr, write ? PAGE_READWRITE : PAGE_WRITECOPY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+	  CloseHandle(file);
+	  throw std::runtime_error("Can't map file " + path);
+	}
+
+	data_ = static_cast<char *>(MapViewOfFile(mapping, write ? FILE_MAP_WRITE : FILE_MAP_COPY, 0, 0, size_));
+	CloseHandle(mapping);
+
+	if (data_ == nullptr) {
+	  CloseHandle(file);
+	  throw std::runtime_error("Can't map file " + path);
+	}
+  }
+#else
+  void map(int fd, const std::string &path) {
+	if (size_ == 0)
+	  return;
+
+	const int flags = mode_ == map_mode::read_write ? MAP_SHARED : MAP_PRIVATE;
+	void *address = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, flags, fd, 0);
+
+	if (address == MAP_FAILED) {
+	  const int error = errno;
+	  ::close(fd);
+	  throw std::runtime_error("Can't map file " + path + ": " + std::strerror(error));
+	}
+
+	data_ = static_cast<char *>(address);
+  }
+#endif
+
+  void unmap() noexcept {
+	if (data_ == nullptr)
+	  return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile(data_);
+#else
+	::munmap(data_, size_);
+#endif
+	data_ = nullptr;
+	size_ = 0;
+  }
+
+private:
+  map_mode mode_ = map_mode::read_only;
+  std::size_t size_ = 0;
+  char *data_ = nullptr;
+};
+
+} // namespace detail end
+
+} // namespace mtlt end
+
+#endif // MTLT_FILE_MAPPING_H_
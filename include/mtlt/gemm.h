@@ -0,0 +1,373 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Kernels of the matrix product: cache blocked multiplication
+ *        and Strassen-Winograd recursion for large products
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_GEMM_H_
+#define MTLT_GEMM_H_
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include <mtlt/parallel.h>
+#include <mtlt/semiring.h>
+#include <mtlt/execution.h>
+#include <mtlt/matrix_config.h>
+
+namespace mtlt {
+
+/**
+ * @class mul_policy
+ *
+ * Describes how a matrix product is computed. execution() splits the rows
+ * of the product between threads, products with all dimensions not less than
+ * strassen_threshold() use the Strassen-Winograd recursion (0 disables it)
+ *
+ * Strassen-Winograd does about (7/8)^levels of the multiplications of the usual
+ * product, but it is only normwise stable: the error of an element is bounded by
+ * max|A| * max|B| (not by the elements taking part in it) and the bound grows by
+ * a constant factor with every level. Elements much smaller than the rest of the
+ * product may lose their relative accuracy, so it is opt-in. Integer products are
+ * exact while the intermediate sums of the blocks do not overflow
+ *
+ * @code
+ *
+ * a.mul(mtlt::mul_policy(mtlt::execution::par).with_strassen(1024), b);
+ *
+ * @endcode
+ */
+class mul_policy {
+public:
+  static constexpr std::size_t kDefaultStrassenThreshold = 512;
+
+public:
+  constexpr mul_policy(execution_policy execution = mtlt::execution::seq, std::size_t strassen_threshold = 0) noexcept
+	  : execution_(execution), strassen_threshold_(strassen_threshold) {}
+
+public:
+  MATRIX_CXX17_NODISCARD
+  constexpr mul_policy with_execution(execution_policy execution) const noexcept {
+	return mul_policy(execution, strassen_threshold_);
+  }
+
+  MATRIX_CXX17_NODISCARD
+  constexpr mul_policy with_strassen(std::size_t threshold = kDefaultStrassenThreshold) const noexcept {
+	return mul_policy(execution_, threshold);
+  }
+
+  MATRIX_CXX17_NODISCARD
+  constexpr const execution_policy &execution() const noexcept { return execution_; }
+
+  MATRIX_CXX17_NODISCARD
+  constexpr std::size_t strassen_threshold() const noexcept { return strassen_threshold_; }
+
+  MATRIX_CXX17_NODISCARD
+  constexpr bool uses_strassen(std::size_t rows, std::size_t cols, std::size_t depth) const noexcept {
+	return strassen_threshold_ != 0 && rows >= strassen_threshold_ && cols >= strassen_threshold_ && depth >= strassen_threshold_;
+  }
+
+private:
+  execution_policy execution_;
+  std::size_t strassen_threshold_;
+};
+
+namespace detail {
+
+// A panel of kGemmDepthBlock rows and kGemmColBlock columns of rhs
+// stays in L2 while all rows of lhs go over it
+MATRIX_CXX17_INLINE constexpr std::size_t kGemmDepthBlock = 128;
+MATRIX_CXX17_INLINE constexpr std::size_t kGemmColBlock = 256;
+MATRIX_CXX17_INLINE constexpr std::size_t kGemmRowGranularity = 8;
+MATRIX_CXX17_INLINE constexpr std::size_t kStrassenMinThreshold = 16;
+
+/**
+ * c += a * b in the semiring for row major blocks: a is rows x depth, b is depth x cols,
+ * ld* are the distances between the rows. Every element of c gets its
+ * products in the order of depth, as in the textbook loop
+ */
+template<typename Semiring, typename T, typename U>
+void gemm_kernel(std::size_t rows, std::size_t cols, std::size_t depth,
+				 const T *a, std::size_t lda, const U *b, std::size_t ldb, T *c, std::size_t ldc) {
+  for (std::size_t col = 0; col < cols; col += kGemmColBlock) {
+	const std::size_t col_end = std::min(cols, col + kGemmColBlock);
+
+	for (std::size_t k = 0; k < depth; k += kGemmDepthBlock) {
+	  const std::size_t k_end = std::min(depth, k + kGemmDepthBlock);
+
+	  std::size_t row = 0;
+
+	  // Four rows of c share every load of a row of b
+	  for (; row + 4 <= rows; row += 4) {
+		const T *a0 = a + row * lda, *a1 = a0 + lda, *a2 = a1 + lda, *a3 = a2 + lda;
+		T *c0 = c + row * ldc, *c1 = c0 + ldc, *c2 = c1 + ldc, *c3 = c2 + ldc;
+
+		for (std::size_t p = k; p != k_end; ++p) {
+		  const T v0 = a0[p], v1 = a1[p], v2 = a2[p], v3 = a3[p];
+		  const U *b_row = b + p * ldb;
+
+		  for (std::size_t j = col; j != col_end; ++j) {
+			const U b_value = b_row[j];
+			c0[j] = Semiring::add(c0[j], Semiring::mul(v0, b_value));
+			c1[j] = Semiring::add(c1[j], Semiring::mul(v1, b_value));
+			c2[j] = Semiring::add(c2[j], Semiring::mul(v2, b_value));
+			c3[j] = Semiring::add(c3[j], Semiring::mul(v3, b_value));
+		  }
+		}
+	  }
+
+	  for (; row != rows; ++row) {
+		const T *a_row = a + row * lda;
+		T *c_row = c + row * ldc;
+
+		for (std::size_t p = k; p != k_end; ++p) {
+		  const T a_value = a_row[p];
+		  const U *b_row = b + p * ldb;
+
+		  for (std::size_t j = col; j != col_end; ++j)
+			c_row[j] = Semiring::add(c_row[j], Semiring::mul(a_value, b_row[j]));
+		}
+	  }
+	}
+  }
+}
+
+/**
+ * c += a * b in the semiring with the rows of c split between the threads of the policy
+ */
+template<typename Semiring, typename T, typename U>
+void semiring_gemm(const execution_policy &policy, std::size_t rows, std::size_t cols, std::size_t depth,
+				   const T *a, std::size_t lda, const U *b, std::size_t ldb, T *c, std::size_t ldc) {
+  const std::size_t threads = policy.threads_for(rows * cols);
+  if (threads == 1 || rows < 2 * kGemmRowGranularity) {
+	gemm_kernel<Semiring>(rows, cols, depth, a, lda, b, ldb, c, ldc);
+	return;
+  }
+
+  parallel_ranges(threads, rows, kGemmRowGranularity, [&](std::size_t, std::size_t first, std::size_t last) {
+	gemm_kernel<Semiring>(last - first, cols, depth, a + first * lda, lda, b, ldb, c + first * ldc, ldc);
+  });
+}
+
+template<typename T, typename U>
+void gemm(const execution_policy &policy, std::size_t rows, std::size_t cols, std::size_t depth,
+		  const T *a, std::size_t lda, const U *b, std::size_t ldb, T *c, std::size_t ldc) {
+  semiring_gemm<semiring::plus_times>(policy, rows, cols, depth, a, lda, b, ldb, c, ldc);
+}
+
+/**
+ * Boolean product of contiguous matrices: the rows of b are packed into bits,
+ * a row of c is the union of the rows of b selected by the nonzero elements
+ * of the row of a, 64 elements of c per instruction
+ */
+template<typename T, typename U>
+void boolean_gemm(const execution_policy &policy, std::size_t rows, std::size_t cols, std::size_t depth,
+				  const T *a, const U *b, T *c) {
+  const std::size_t words = (cols + 63) / 64;
+
+  std::vector<std::uint64_t> packed(depth * words);
+  for (std::size_t k = 0; k != depth; ++k)
+	for (std::size_t col = 0; col != cols; ++col)
+	  if (b[k * cols + col] != U{})
+		packed[k * words + col / 64] |= std::uint64_t{1} << (col % 64);
+
+  auto multiply_rows = [&](std::size_t first, std::size_t last) {
+	std::vector<std::uint64_t> row_bits(words);
+
+	for (std::size_t row = first; row != last; ++row) {
+	  std::fill(row_bits.begin(), row_bits.end(), std::uint64_t{0});
+
+	  for (std::size_t k = 0; k != depth; ++k) {
+		if (a[row * depth + k] == T{})
+		  continue;
+
+		const std::uint64_t *b_bits = packed.data() + k * words;
+		for (std::size_t word = 0; word != words; ++word)
+		  row_bits[word] |= b_bits[word];
+	  }
+
+	  for (std::size_t col = 0; col != cols; ++col)
+		c[row * cols + col] = static_cast<T>((row_bits[col / 64] >> (col % 64)) & 1);
+	}
+  };
+
+  const std::size_t threads = policy.threads_for(rows * cols);
+  if (threads == 1) {
+	multiply_rows(0, rows);
+	return;
+  }
+
+  parallel_ranges(threads, rows, 1, [&](std::size_t, std::size_t first, std::size_t last) {
+	multiply_rows(first, last);
+  });
+}
+
+/**
+ * c = a * b in the semiring for contiguous row major matrices,
+ * c is filled with the zero of the semiring before
+ */
+template<typename Semiring, typename T, typename U>
+void semiring_product(const execution_policy &policy, std::size_t rows, std::size_t cols, std::size_t depth,
+					  const T *a, const U *b, T *c, Semiring) {
+  semiring_gemm<Semiring>(policy, rows, cols, depth, a, depth, b, cols, c, cols);
+}
+
+template<typename T, typename U>
+void semiring_product(const execution_policy &policy, std::size_t rows, std::size_t cols, std::size_t depth,
+					  const T *a, const U *b, T *c, semiring::or_and) {
+  boolean_gemm(policy, rows, cols, depth, a, b, c);
+}
+
+/**
+ * out = op(x, y) element wise, out may be x or y
+ */
+template<typename T, typename Operation>
+void combine_blocks(std::size_t rows, std::size_t cols, const T *x, std::size_t ldx,
+					const T *y, std::size_t ldy, T *out, std::size_t ldo, Operation op) {
+  for (std::size_t row = 0; row != rows; ++row)
+	for (std::size_t col = 0; col != cols; ++col)
+	  out[row * ldo + col] = op(x[row * ldx + col], y[row * ldy + col]);
+}
+
+template<typename T>
+void zero_block(std::size_t rows, std::size_t cols, T *out, std::size_t ldo) {
+  for (std::size_t row = 0; row != rows; ++row)
+	std::fill(out + row * ldo, out + row * ldo + cols, T{});
+}
+
+inline std::size_t strassen_threshold(std::size_t threshold) noexcept {
+  return std::max(threshold, kStrassenMinThreshold);
+}
+
+/**
+ * Elements of the workspace used by all levels of the recursion, a level takes
+ * three blocks of half sizes and passes the rest of the workspace to the next one
+ */
+inline std::size_t strassen_workspace(std::size_t rows, std::size_t cols, std::size_t depth, std::size_t threshold) noexcept {
+  threshold = strassen_threshold(threshold);
+
+  std::size_t elements = 0;
+  while (rows >= threshold && cols >= threshold && depth >= threshold) {
+	rows /= 2, cols /= 2, depth /= 2;
+	elements += rows * depth + depth * cols + rows * cols;
+  }
+
+  return elements;
+}
+
+/**
+ * c = a * b by the Winograd form of Strassen's recursion (7 block products and
+ * 15 block additions per level). Odd dimensions are handled by peeling: the even
+ * part goes through the recursion, the last row, column and rank one update are
+ * computed with gemm. Blocks smaller than threshold are multiplied with gemm
+ */
+template<typename T>
+void strassen_winograd(const execution_policy &policy, std::size_t rows, std::size_t cols, std::size_t depth,
+					   const T *a, std::size_t lda, const T *b, std::size_t ldb, T *c, std::size_t ldc,
+					   std::size_t threshold, T *workspace) {
+  threshold = strassen_threshold(threshold);
+  if (rows < threshold || cols < threshold || depth < threshold) {
+	zero_block(rows, cols, c, ldc);
+	gemm(policy, rows, cols, depth, a, lda, b, ldb, c, ldc);
+	return;
+  }
+
+  const std::size_t m = rows / 2, n = cols / 2, k = depth / 2;
+
+  const T *a11 = a, *a12 = a + k, *a21 = a + m * lda, *a22 = a21 + k;
+  const T *b11 = b, *b12 = b + n, *b21 = b + k * ldb, *b22 = b21 + n;
+  T *c11 = c, *c12 = c + n, *c21 = c + m * ldc, *c22 = c21 + n;
+
+  T *x = workspace, *y = x + m * k, *z = y + k * n, *next = z + m * n;
+
+  auto plus = [](const T &lhs, const T &rhs) { return lhs + rhs; };
+  auto minus = [](const T &lhs, const T &rhs) { return lhs - rhs; };
+  auto product = [&](const T *lhs, std::size_t ldl, const T *rhs, std::size_t ldr, T *out, std::size_t ldo) {
+	strassen_winograd(policy, m, n, k, lhs, ldl, rhs, ldr, out, ldo, threshold, next);
+  };
+
+  // c21 = P7 = (A11 - A21)(B22 - B12)
+  combine_blocks(m, k, a11, lda, a21, lda, x, k, minus);
+  combine_blocks(k, n, b22, ldb, b12, ldb, y, n, minus);
+  product(x, k, y, n, c21, ldc);
+
+  // c22 = P5 = S1 T1 = (A21 + A22)(B12 - B11)
+  combine_blocks(m, k, a21, lda, a22, lda, x, k, plus);
+  combine_blocks(k, n, b12, ldb, b11, ldb, y, n, minus);
+  product(x, k, y, n, c22, ldc);
+
+  // c12 = P6 = S2 T2 = (S1 - A11)(B22 - T1)
+  combine_blocks(m, k, x, k, a11, lda, x, k, minus);
+  combine_blocks(k, n, b22, ldb, y, n, y, n, minus);
+  product(x, k, y, n, c12, ldc);
+
+  // z = P3 = S4 B22 = (A12 - S2) B22
+  combine_blocks(m, k, a12, lda, x, k, x, k, minus);
+  product(x, k, b22, ldb, z, n);
+
+  // c11 = P1 = A11 B11
+  product(a11, lda, b11, ldb, c11, ldc);
+
+  combine_blocks(m, n, c11, ldc, c12, ldc, c12, ldc, plus); // U2 = P1 + P6
+  combine_blocks(m, n, c12, ldc, c21, ldc, c21, ldc, plus); // U3 = U2 + P7
+  combine_blocks(m, n, c12, ldc, c22, ldc, c12, ldc, plus); // U4 = U2 + P5
+  combine_blocks(m, n, c21, ldc, c22, ldc, c22, ldc, plus); // C22 = U3 + P5
+  combine_blocks(m, n, c12, ldc, z, n, c12, ldc, plus);     // C12 = U4 + P3
+
+  // z = P4 = A22 T4 = A22 (T2 - B21), C21 = U3 - P4
+  combine_blocks(k, n, y, n, b21, ldb, y, n, minus);
+  product(a22, lda, y, n, z, n);
+  combine_blocks(m, n, c21, ldc, z, n, c21, ldc, minus);
+
+  // z = P2 = A12 B21, C11 = P1 + P2
+  product(a12, lda, b21, ldb, z, n);
+  combine_blocks(m, n, c11, ldc, z, n, c11, ldc, plus);
+
+  if (depth != 2 * k)
+	gemm(policy, 2 * m, 2 * n, 1, a + 2 * k, lda, b + 2 * k * ldb, ldb, c, ldc);
+
+  if (cols != 2 * n) {
+	zero_block(rows, 1, c + 2 * n, ldc);
+	gemm(policy, rows, 1, depth, a, lda, b + 2 * n, ldb, c + 2 * n, ldc);
+  }
+
+  if (rows != 2 * m) {
+	zero_block(1, 2 * n, c + 2 * m * ldc, ldc);
+	gemm(policy, 1, 2 * n, depth, a + 2 * m * lda, lda, b, ldb, c + 2 * m * ldc, ldc);
+  }
+}
+
+/**
+ * c = a * b for contiguous row major matrices, the workspace of the whole
+ * recursion is allocated once
+ */
+template<typename T>
+void strassen_winograd(const execution_policy &policy, std::size_t rows, std::size_t cols, std::size_t depth,
+					   const T *a, const T *b, T *c, std::size_t threshold) {
+  std::vector<T> workspace(strassen_workspace(rows, cols, depth, threshold));
+  strassen_winograd(policy, rows, cols, depth, a, depth, b, cols, c, cols, threshold, workspace.data());
+}
+
+} // namespace detail end
+
+} // namespace mtlt end
+
+#endif // MTLT_GEMM_H_
@@ -0,0 +1,223 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Graph algorithms on adjacency matrices: all pairs
+ *        shortest paths and transitive closure
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_GRAPH_H_
+#define MTLT_GRAPH_H_
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include <mtlt/gemm.h>
+#include <mtlt/matrix.h>
+#include <mtlt/parallel.h>
+#include <mtlt/semiring.h>
+#include <mtlt/execution.h>
+
+namespace mtlt {
+
+namespace detail {
+
+// Three blocks of the distances stay in L2 during a phase
+MATRIX_CXX17_INLINE constexpr std::size_t kFloydWarshallBlock = 64;
+
+// A block of pivots of the closure is one word of a packed row
+MATRIX_CXX17_INLINE constexpr std::size_t kClosureBlock = 64;
+
+/**
+ * Calls f(task) for every task in [0, tasks) on threads threads
+ */
+template<typename Function>
+void for_each_task(std::size_t threads, std::size_t tasks, Function &&f) {
+  if (threads == 1 || tasks < 2) {
+	for (std::size_t task = 0; task != tasks; ++task)
+	  f(task);
+	return;
+  }
+
+  parallel_ranges(std::min(threads, tasks), tasks, 1, [&f](std::size_t, std::size_t first, std::size_t last) {
+	for (; first != last; ++first)
+	  f(first);
+  });
+}
+
+/**
+ * c(i, j) = min(c(i, j), a(i, k) + b(k, j)) with k as the outermost loop,
+ * so a and b may be c itself, as the pivot blocks of Floyd-Warshall are
+ */
+template<typename T>
+void floyd_warshall_block(std::size_t rows, std::size_t cols, std::size_t depth,
+						  const T *a, std::size_t lda, const T *b, std::size_t ldb, T *c, std::size_t ldc) {
+  for (std::size_t k = 0; k != depth; ++k) {
+	const T *b_row = b + k * ldb;
+
+	for (std::size_t row = 0; row != rows; ++row) {
+	  const T a_value = a[row * lda + k];
+	  if (a_value == positive_infinity<T>())
+		continue;
+
+	  T *c_row = c + row * ldc;
+	  for (std::size_t col = 0; col != cols; ++col)
+		c_row[col] = semiring::min_plus::add(c_row[col], semiring::min_plus::mul(a_value, b_row[col]));
+	}
+  }
+}
+
+} // namespace detail end
+
+/**
+ * All pairs shortest paths in place: distances(i, j) is the length of the edge
+ * from i to j, infinity (max() for integers) where there is no edge and usually 0
+ * on the diagonal. The result is the length of the shortest path, the graph must
+ * not have negative cycles
+ *
+ * The matrix is split into blocks, for every block of pivots the pivot block is
+ * closed first, then the blocks of its row and column, then all the other blocks,
+ * which is a min-plus product of the pivot column and row. The blocks of the last
+ * two phases are independent and run on the threads of the policy
+ *
+ * @code
+ *
+ * mtlt::floyd_warshall(mtlt::execution::par, routes);
+ *
+ * @endcode
+ */
+template<typename T>
+matrix<T> &floyd_warshall(const execution_policy &policy, matrix<T> &distances) {
+  if (distances.rows() != distances.cols())
+	throw std::logic_error("Floyd-Warshall needs a square matrix");
+
+  const std::size_t n = distances.rows();
+  const std::size_t block = detail::kFloydWarshallBlock;
+  const std::size_t blocks = (n + block - 1) / block;
+  const std::size_t threads = policy.threads_for(n * n);
+
+  T *d = distances.data();
+  auto extent = [&](std::size_t index) { return std::min(block, n - index * block); };
+  auto at = [&](std::size_t row, std::size_t col) { return d + row * block * n + col * block; };
+
+  for (std::size_t pivot = 0; pivot != blocks; ++pivot) {
+	const std::size_t depth = extent(pivot);
+	T *pivot_block = at(pivot, pivot);
+
+	detail::floyd_warshall_block(depth, depth, depth, pivot_block, n, pivot_block, n, pivot_block, n);
+
+	detail::for_each_task(threads, 2 * blocks, [&](std::size_t task) {
+	  const std::size_t other = task / 2;
+	  if (other == pivot)
+		return;
+
+	  if (task % 2 == 0) {
+		T *row_block = at(pivot, other);
+		detail::floyd_warshall_block(depth, extent(other), depth, pivot_block, n, row_block, n, row_block, n);
+	  } else {
+		T *col_block = at(other, pivot);
+		detail::floyd_warshall_block(extent(other), depth, depth, col_block, n, pivot_block, n, col_block, n);
+	  }
+	});
+
+	detail::for_each_task(threads, blocks * blocks, [&](std::size_t task) {
+	  const std::size_t row = task / blocks, col = task % blocks;
+	  if (row == pivot || col == pivot)
+		return;
+
+	  detail::gemm_kernel<semiring::min_plus>(extent(row), extent(col), depth,
+											  at(row, pivot), n, at(pivot, col), n, at(row, col), n);
+	});
+  }
+
+  return distances;
+}
+
+template<typename T>
+matrix<T> &floyd_warshall(matrix<T> &distances) {
+  return floyd_warshall(execution::seq, distances);
+}
+
+/**
+ * Transitive closure in place: a nonzero adjacency(i, j) is an edge from i to j,
+ * the result is 1 where j is reachable from i by a path of at least one edge, 0 otherwise
+ *
+ * Warshall's algorithm on rows packed into bits: for every block of 64 pivots the
+ * rows of the pivots are closed first, then the other rows take the pivot rows they
+ * reach, 64 columns per instruction and in parallel as the policy says
+ */
+template<typename T>
+matrix<T> &transitive_closure(const execution_policy &policy, matrix<T> &adjacency) {
+  if (adjacency.rows() != adjacency.cols())
+	throw std::logic_error("Transitive closure needs a square matrix");
+
+  const std::size_t n = adjacency.rows();
+  const std::size_t words = (n + 63) / 64;
+
+  std::vector<std::uint64_t> bits(n * words);
+  for (std::size_t row = 0; row != n; ++row)
+	for (std::size_t col = 0; col != n; ++col)
+	  if (adjacency(row, col) != T{})
+		bits[row * words + col / 64] |= std::uint64_t{1} << (col % 64);
+
+  auto reaches = [&](std::size_t row, std::size_t col) {
+	return ((bits[row * words + col / 64] >> (col % 64)) & 1) != 0;
+  };
+
+  auto merge = [&](std::size_t row, std::size_t pivot) {
+	for (std::size_t index = 0; index != words; ++index)
+	  bits[row * words + index] |= bits[pivot * words + index];
+  };
+
+  const std::size_t threads = policy.threads_for(n * n);
+  for (std::size_t first = 0; first < n; first += detail::kClosureBlock) {
+	const std::size_t last = std::min(n, first + detail::kClosureBlock);
+	const std::size_t pivots = last - first;
+
+	for (std::size_t pivot = first; pivot != last; ++pivot)
+	  for (std::size_t row = first; row != last; ++row)
+		if (reaches(row, pivot))
+		  merge(row, pivot);
+
+	// The pivot rows are closed over the block, a row may take them in any order.
+	// The bits of the row may change while it goes over the pivots
+	detail::for_each_task(threads, n - pivots, [&](std::size_t task) {
+	  const std::size_t row = task < first ? task : task + pivots;
+	  for (std::size_t pivot = first; pivot != last; ++pivot)
+		if (reaches(row, pivot))
+		  merge(row, pivot);
+	});
+  }
+
+  for (std::size_t row = 0; row != n; ++row)
+	for (std::size_t col = 0; col != n; ++col)
+	  adjacency(row, col) = static_cast<T>(reaches(row, col));
+
+  return adjacency;
+}
+
+template<typename T>
+matrix<T> &transitive_closure(matrix<T> &adjacency) {
+  return transitive_closure(execution::seq, adjacency);
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_GRAPH_H_
@@ -0,0 +1,273 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Optional per operation counters of FLOPs, bytes,
+ *        allocations and wall time
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_INSTRUMENTATION_H_
+#define MTLT_INSTRUMENTATION_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#if __cplusplus > 201703L
+#include <type_traits>
+#endif
+
+#include <mtlt/matrix_config.h>
+#include <mtlt/tracing.h>
+
+/**
+ * Define MTLT_ENABLE_STATS before including any mtlt header (or pass -DMTLT_ENABLE_STATS)
+ * to count operations. Without it the instrumentation macros expand to nothing,
+ * their arguments are not evaluated and stats snapshots stay zero
+ *
+ * MTLT_OPERATION_SCOPE also reports the operation to the trace sink when
+ * MTLT_ENABLE_TRACING is defined, see mtlt/tracing.h
+ *
+ * static_matrix operations are constexpr, so they use MTLT_COUNT_OPERATION which
+ * counts calls, FLOPs and bytes but not wall time, and is skipped during constant evaluation (C++20)
+ */
+#if defined(MTLT_ENABLE_STATS)
+#  define MTLT_STATS_SCOPE_(op, flops, bytes_read, bytes_written) \
+	 const ::mtlt::detail::operation_scope mtlt_operation_scope_(op, flops, bytes_read, bytes_written);
+#  define MTLT_COUNT_ALLOCATION(bytes) ::mtlt::detail::count_allocation(bytes)
+#  if __cplusplus > 201703L
+#    define MTLT_COUNT_OPERATION(op, rows, cols, flops, bytes_read, bytes_written) \
+	   (std::is_constant_evaluated() ? void() : ::mtlt::detail::count_operation(op, flops, bytes_read, bytes_written))
+#  else
+#    define MTLT_COUNT_OPERATION(op, rows, cols, flops, bytes_read, bytes_written) \
+	   ::mtlt::detail::count_operation(op, flops, bytes_read, bytes_written)
+#  endif
+#else
+#  define MTLT_STATS_SCOPE_(op, flops, bytes_read, bytes_written)
+#  define MTLT_COUNT_ALLOCATION(bytes) static_cast<void>(0)
+#  define MTLT_COUNT_OPERATION(op, rows, cols, flops, bytes_read, bytes_written) static_cast<void>(0)
+#endif
+
+#if defined(MTLT_ENABLE_TRACING)
+#  define MTLT_TRACE_OPERATION_(op, rows, cols) MTLT_TRACE_SCOPE(::mtlt::operation_name(op), rows, cols);
+#else
+#  define MTLT_TRACE_OPERATION_(op, rows, cols)
+#endif
+
+#define MTLT_OPERATION_SCOPE(op, rows, cols, flops, bytes_read, bytes_written) \
+  MTLT_STATS_SCOPE_(op, flops, bytes_read, bytes_written) \
+  MTLT_TRACE_OPERATION_(op, rows, cols) \
+  static_cast<void>(0)
+
+namespace mtlt {
+
+/**
+ * @enum operation
+ * Kind of an instrumented operation, operation::other collects
+ * allocations made outside of any instrumented operation
+ */
+enum class operation : unsigned {
+  other,
+  add,
+  sub,
+  mul,
+  mul_by_element,
+  mul_by_number,
+  div_by_number,
+  transpose,
+  determinant,
+  complements,
+  inverse,
+  join,
+  resize,
+  fill,
+  sum,
+  count
+};
+
+inline const char *operation_name(operation op) noexcept {
+  static const char *const kNames[] = {
+	  "other", "add", "sub", "mul", "mul_by_element", "mul_by_number", "div_by_number",
+	  "transpose", "determinant", "complements", "inverse", "join", "resize", "fill", "sum"
+  };
+
+  return op < operation::count ? kNames[static_cast<unsigned>(op)] : "unknown";
+}
+
+/**
+ * @struct operation_stats
+ *
+ * Wall time of an operation includes the nested operations it calls,
+ * e.g. inverse includes the determinants of its minors,
+ * FLOPs and bytes are counted once by the operation that does the work
+ */
+struct operation_stats {
+  std::uint64_t calls = 0;
+  std::uint64_t flops = 0;
+  std::uint64_t bytes_read = 0;
+  std::uint64_t bytes_written = 0;
+  std::uint64_t allocations = 0;
+  std::uint64_t allocated_bytes = 0;
+  std::uint64_t nanoseconds = 0;
+};
+
+/**
+ * @struct stats_snapshot
+ * Copy of all counters taken at one moment
+ */
+struct stats_snapshot {
+  std::array<operation_stats, static_cast<std::size_t>(operation::count)> operations;
+
+  const operation_stats &operator[](operation op) const noexcept {
+	return operations[static_cast<std::size_t>(op)];
+  }
+
+  operation_stats total() const noexcept {
+	operation_stats sum;
+	for (const operation_stats &stats : operations) {
+	  sum.calls += stats.calls;
+	  sum.flops += stats.flops;
+	  sum.bytes_read += stats.bytes_read;
+	  sum.bytes_written += stats.bytes_written;
+	  sum.allocations += stats.allocations;
+	  sum.allocated_bytes += stats.allocated_bytes;
+	}
+	return sum;
+  }
+};
+
+namespace detail {
+
+struct atomic_operation_stats {
+  std::atomic<std::uint64_t> calls{0};
+  std::atomic<std::uint64_t> flops{0};
+  std::atomic<std::uint64_t> bytes_read{0};
+  std::atomic<std::uint64_t> bytes_written{0};
+  std::atomic<std::uint64_t> allocations{0};
+  std::atomic<std::uint64_t> allocated_bytes{0};
+  std::atomic<std::uint64_t> nanoseconds{0};
+};
+
+inline atomic_operation_stats *stats_registry() noexcept {
+  static atomic_operation_stats registry[static_cast<std::size_t>(operation::count)];
+  return registry;
+}
+
+/**
+ * Operation running on this thread, allocations are attributed to it
+ */
+inline operation &current_operation() noexcept {
+  static thread_local operation current = operation::other;
+  return current;
+}
+
+inline void count_operation(operation op, std::uint64_t flops,
+							std::uint64_t bytes_read, std::uint64_t bytes_written) noexcept {
+  atomic_operation_stats &stats = stats_registry()[static_cast<std::size_t>(op)];
+  stats.calls.fetch_add(1, std::memory_order_relaxed);
+  stats.flops.fetch_add(flops, std::memory_order_relaxed);
+  stats.bytes_read.fetch_add(bytes_read, std::memory_order_relaxed);
+  stats.bytes_written.fetch_add(bytes_written, std::memory_order_relaxed);
+}
+
+inline void count_allocation(std::uint64_t bytes) noexcept {
+  atomic_operation_stats &stats = stats_registry()[static_cast<std::size_t>(current_operation())];
+  stats.allocations.fetch_add(1, std::memory_order_relaxed);
+  stats.allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+/**
+ * Counts the operation and measures its wall time from construction to destruction
+ */
+class operation_scope {
+public:
+  operation_scope(operation op, std::uint64_t flops, std::uint64_t bytes_read, std::uint64_t bytes_written) noexcept
+	  : operation_(op), previous_(current_operation()), start_(std::chrono::steady_clock::now()) {
+	count_operation(op, flops, bytes_read, bytes_written);
+	current_operation() = op;
+  }
+
+  operation_scope(const operation_scope &) = delete;
+  operation_scope &operator=(const operation_scope &) = delete;
+
+  ~operation_scope() noexcept {
+	const auto elapsed = std::chrono::steady_clock::now() - start_;
+	stats_registry()[static_cast<std::size_t>(operation_)].nanoseconds.fetch_add(
+		static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+		std::memory_order_relaxed);
+
+	current_operation() = previous_;
+  }
+
+private:
+  operation operation_;
+  operation previous_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace detail end
+
+MATRIX_CXX17_NODISCARD
+constexpr bool stats_enabled() noexcept {
+#if defined(MTLT_ENABLE_STATS)
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Thread safe copy of the counters, every counter is read atomically,
+ * counters of operations running concurrently may be seen partially updated
+ */
+inline stats_snapshot take_stats_snapshot() noexcept {
+  stats_snapshot snapshot;
+  const detail::atomic_operation_stats *registry = detail::stats_registry();
+
+  for (std::size_t i = 0; i != snapshot.operations.size(); ++i) {
+	operation_stats &stats = snapshot.operations[i];
+	stats.calls = registry[i].calls.load(std::memory_order_relaxed);
+	stats.flops = registry[i].flops.load(std::memory_order_relaxed);
+	stats.bytes_read = registry[i].bytes_read.load(std::memory_order_relaxed);
+	stats.bytes_written = registry[i].bytes_written.load(std::memory_order_relaxed);
+	stats.allocations = registry[i].allocations.load(std::memory_order_relaxed);
+	stats.allocated_bytes = registry[i].allocated_bytes.load(std::memory_order_relaxed);
+	stats.nanoseconds = registry[i].nanoseconds.load(std::memory_order_relaxed);
+  }
+
+  return snapshot;
+}
+
+inline void reset_stats() noexcept {
+  detail::atomic_operation_stats *registry = detail::stats_registry();
+
+  for (std::size_t i = 0; i != static_cast<std::size_t>(operation::count); ++i) {
+	registry[i].calls.store(0, std::memory_order_relaxed);
+	registry[i].flops.store(0, std::memory_order_relaxed);
+	registry[i].bytes_read.store(0, std::memory_order_relaxed);
+	registry[i].bytes_written.store(0, std::memory_order_relaxed);
+	registry[i].allocations.store(0, std::memory_order_relaxed);
+	registry[i].allocated_bytes.store(0, std::memory_order_relaxed);
+	registry[i].nanoseconds.store(0, std::memory_order_relaxed);
+  }
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_INSTRUMENTATION_H_
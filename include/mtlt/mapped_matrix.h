@@ -0,0 +1,502 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        The mapped_matrix container class maps a file in the
+ *        MTLT binary format into memory instead of reading it
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_MAPPED_MATRIX_H_
+#define MTLT_MAPPED_MATRIX_H_
+
+#include <string>
+#include <numeric>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include <mtlt/matrix.h>
+#include <mtlt/reduce.h>
+#include <mtlt/matrix_config.h>
+#include <mtlt/file_mapping.h>
+#include <mtlt/serialization.h>
+#include <mtlt/matrix_normal_iterator.h>
+#include <mtlt/matrix_reverse_iterator.h>
+
+namespace mtlt {
+
+/**
+ * @class mapped_matrix
+ *
+ * Matrix whose elements live in a file written by mtlt::save. Opening does
+ * not read the elements, pages are loaded by the OS on first access,
+ * so the size of the matrix is limited by the address space, not by RAM
+ *
+ * map_mode::read_only  - changes are private to the process and never reach the file
+ * map_mode::read_write - changes are shared with other mappings and written to the file
+ *
+ * The matrix has fixed dimensions, operations that change them
+ * (mul by matrix, transpose) return a new mtlt::matrix
+ *
+ * @code
+ *
+ * mtlt::mapped_matrix<float> embeddings("embeddings.mtlt", mtlt::map_mode::read_only,
+ *                                       mtlt::access_hint::random);
+ * float value = embeddings(42, 7);
+ *
+ * auto scratch = mtlt::mapped_matrix<double>::create("scratch.mtlt", 100000, 1000);
+ * scratch.fill(1.0);
+ * scratch.flush();
+ *
+ * @endcode
+ */
+template<typename T>
+class mapped_matrix final {
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to be mapped from file");
+
+public:
+  using value_type = T;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using size_type = std::size_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = matrix_normal_iterator<pointer>;
+  using const_iterator = matrix_normal_iterator<const_pointer>;
+  using reverse_iterator = matrix_reverse_iterator<pointer>;
+  using const_reverse_iterator = matrix_reverse_iterator<const_pointer>;
+
+public:
+  mapped_matrix() noexcept = default;
+
+  /**
+   * Maps an existing file. Throws std::runtime_error if the file can't be mapped
+   * or is not in MTLT binary format, std::logic_error if the stored element type
+   * differs from T or the file was written with another byte order
+   */
+  explicit mapped_matrix(const std::string &path,
+						 map_mode mode = map_mode::read_only,
+						 access_hint hint = access_hint::normal)
+	  : mapping_(path, mode) {
+	if (mapping_.size() < binary_header::kSize)
+	  throw std::runtime_error("Can't map matrix because file " + path + " is too small");
+
+	const binary_header header =
+		detail::decode_header(*reinterpret_cast<const char (*)[binary_header::kSize]>(mapping_.data()));
+	detail::check_header<T>(header);
+
+	if (header.big_endian() != detail::is_big_endian())
+	  throw std::logic_error("Can't map matrix because it was saved with another byte order, use mtlt::load");
+
+	if (mapping_.size() < header.header_size + header.payload_size())
+	  throw std::runtime_error("Can't map matrix because file " + path + " is truncated");
+
+	// Elements are going to change, the stored checksum would be stale
+	if (mode == map_mode::read_write && header.has_checksum())
+	  mapping_.data()[7] = static_cast<char>(header.flags & ~binary_header::kChecksumFlag);
+
+	rows_ = static_cast<size_type>(header.rows);
+	cols_ = static_cast<size_type>(header.cols);
+	data_ = reinterpret_cast<pointer>(mapping_.data() + header.header_size);
+
+	advise(hint);
+  }
+
+  /**
+   * Views rows * cols elements that start offset bytes into an existing mapping,
+   * used by readers of other file formats. Throws std::logic_error if the elements
+   * don't fit into the mapping or are not aligned for T
+   */
+  mapped_matrix(detail::file_mapping mapping, size_type offset, size_type rows, size_type cols,
+				access_hint hint = access_hint::normal)
+	  : mapping_(std::move(mapping)), rows_(rows), cols_(cols) {
+	if (offset > mapping_.size() || (mapping_.size() - offset) / sizeof(value_type) < rows * cols)
+	  throw std::logic_error("Can't map matrix because file is smaller than rows * cols elements");
+
+	if (offset % alignof(value_type) != 0)
+	  throw std::logic_error("Can't map matrix because elements are not aligned in file");
+
+	data_ = reinterpret_cast<pointer>(mapping_.data() + offset);
+	advise(hint);
+  }
+
+  /**
+   * Creates a file with rows * cols zero elements and maps it in map_mode::read_write
+   */
+  static mapped_matrix create(const std::string &path, size_type rows, size_type cols) {
+	const binary_header header = detail::make_header<T>(rows, cols, matrix_binary_settings{});
+
+	mapped_matrix mapped;
+	mapped.mapping_ = detail::file_mapping::create(path, header.header_size + header.payload_size());
+	detail::encode_header(header, *reinterpret_cast<char (*)[binary_header::kSize]>(mapped.mapping_.data()));
+
+	mapped.rows_ = rows;
+	mapped.cols_ = cols;
+	mapped.data_ = reinterpret_cast<pointer>(mapped.mapping_.data() + header.header_size);
+
+	return mapped;
+  }
+
+  mapped_matrix(const mapped_matrix &) = delete;
+  mapped_matrix &operator=(const mapped_matrix &) = delete;
+
+  mapped_matrix(mapped_matrix &&other) noexcept
+	  : mapping_(std::move(other.mapping_)), rows_(other.rows_), cols_(other.cols_), data_(other.data_) {
+	other.rows_ = other.cols_ = size_type{};
+	other.data_ = nullptr;
+  }
+
+  mapped_matrix &operator=(mapped_matrix &&other) noexcept {
+	if (&other == this)
+	  return *this;
+
+	std::swap(mapping_, other.mapping_);
+	std::swap(rows_, other.rows_);
+	std::swap(cols_, other.cols_);
+	std::swap(data_, other.data_);
+
+	return *this;
+  }
+
+  ~mapped_matrix() noexcept = default;
+
+public:
+  iterator begin() noexcept { return iterator(data_); }
+
+  const_iterator begin() const noexcept { return const_iterator(data_); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(data_ + size() - 1); }
+
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(data_ + size() - 1); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+
+  const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+  iterator end() noexcept { return iterator(data_ + size()); }
+
+  const_iterator end() const noexcept { return const_iterator(data_ + size()); }
+
+  reverse_iterator rend() noexcept { return reverse_iterator(data_ - 1); }
+
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(data_ - 1); }
+
+  const_iterator cend() const noexcept { return end(); }
+
+  const_reverse_iterator crend() const noexcept { return rend(); }
+
+public:
+  reference operator()(size_type row, size_type col) {
+	return data_[row * cols_ + col];
+  }
+
+  const_reference operator()(size_type row, size_type col) const {
+	return data_[row * cols_ + col];
+  }
+
+  reference at(size_type row, size_type col) {
+	if (row >= rows_ || col >= cols_)
+	  throw std::out_of_range("row or col is out of range of matrix");
+
+	return (*this)(row, col);
+  }
+
+  const_reference at(size_type row, size_type col) const {
+	if (row >= rows_ || col >= cols_)
+	  throw std::out_of_range("row or col is out of range of matrix");
+
+	return (*this)(row, col);
+  }
+
+  MATRIX_CXX17_NODISCARD
+  size_type rows() const noexcept { return rows_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type cols() const noexcept { return cols_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type size() const noexcept { return rows_ * cols_; }
+
+  MATRIX_CXX17_NODISCARD
+  pointer data() noexcept { return data_; }
+
+  MATRIX_CXX17_NODISCARD
+  const_pointer data() const noexcept { return data_; }
+
+  MATRIX_CXX17_NODISCARD
+  map_mode mode() const noexcept { return mapping_.mode(); }
+
+public:
+  /**
+   * Tells the OS how the elements are going to be accessed:
+   * sequential enables aggressive read ahead, random disables it,
+   * will_need starts loading the pages in background
+   */
+  void advise(access_hint hint) const noexcept {
+	const char *base = mapping_.data();
+	mapping_.advise(hint, reinterpret_cast<const char *>(data_) - base, size() * sizeof(value_type));
+  }
+
+  /**
+   * Blocks until the changes of a read_write mapping are written to the file,
+   * does nothing for read_only
+   */
+  void flush() const {
+	mapping_.flush();
+  }
+
+  void print(std::ostream &os = std::cout, matrix_debug_settings s = matrix_debug_settings{}) const {
+	for (size_type row = 0; row != rows_; ++row) {
+	  for (size_type col = 0; col != cols_; ++col) {
+		os << std::setw(s.width)
+		   << std::setprecision(s.precision)
+		   << (*this)(row, col)
+		   << s.separator;
+	  }
+	  os << s.end;
+	}
+
+	if (s.is_double_end)
+	  os << s.end;
+  }
+
+public:
+  template<typename UnaryOperation>
+  void transform(UnaryOperation &&op) {
+	std::transform(begin(), end(), begin(), std::forward<UnaryOperation>(op));
+  }
+
+  template<typename Operation>
+  void generate(Operation &&op) {
+	std::generate(begin(), end(), std::forward<Operation>(op));
+  }
+
+  mapped_matrix &fill(const value_type &number) {
+	std::fill(begin(), end(), number);
+	return *this;
+  }
+
+  mapped_matrix &mul(const value_type &number) {
+	transform([&number](const value_type &item) { return item * number; });
+	return *this;
+  }
+
+  mapped_matrix &div(const value_type &number) {
+	if (std::is_integral<T>::value && number == 0)
+	  throw std::logic_error("Dividing by zero");
+
+	transform([&number](const value_type &item) { return item / number; });
+	return *this;
+  }
+
+  mapped_matrix &add(const value_type &number) {
+	transform([&number](const value_type &item) { return item + number; });
+	return *this;
+  }
+
+  mapped_matrix &sub(const value_type &number) {
+	transform([&number](const value_type &item) { return item - number; });
+	return *this;
+  }
+
+  template<typename U>
+  mapped_matrix &add(const matrix<U> &rhs) { return add_matrix(rhs); }
+
+  template<typename U>
+  mapped_matrix &add(const mapped_matrix<U> &rhs) { return add_matrix(rhs); }
+
+  template<typename U>
+  mapped_matrix &sub(const matrix<U> &rhs) { return sub_matrix(rhs); }
+
+  template<typename U>
+  mapped_matrix &sub(const mapped_matrix<U> &rhs) { return sub_matrix(rhs); }
+
+  template<typename U>
+  mapped_matrix &mul_by_element(const matrix<U> &rhs) { return mul_by_element_matrix(rhs); }
+
+  template<typename U>
+  mapped_matrix &mul_by_element(const mapped_matrix<U> &rhs) { return mul_by_element_matrix(rhs); }
+
+  /**
+   * Returns this * rhs, the product has other dimensions so it is not mapped
+   */
+  template<typename Matrix>
+  matrix<T> mul(const Matrix &rhs) const {
+	if (cols_ != rhs.rows())
+	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
+
+	const size_type cols = rhs.cols();
+	matrix<T> multiplied(rows_, cols);
+
+	for (size_type row = 0; row != rows_; ++row)
+	  for (size_type k = 0; k != cols_; ++k) {
+		const value_type a = (*this)(row, k);
+		for (size_type col = 0; col != cols; ++col)
+		  multiplied(row, col) += a * rhs(k, col);
+	  }
+
+	return multiplied;
+  }
+
+  value_type sum() const {
+	return detail::sum_elements<value_type>(data_, size());
+  }
+
+  value_type trace() const {
+	if (rows_ != cols_)
+	  throw std::logic_error("Can't calculate trace of non square matrix");
+
+	value_type trace_value{};
+	for (size_type i = 0; i != rows_; ++i)
+	  trace_value += (*this)(i, i);
+
+	return trace_value;
+  }
+
+  matrix<T> transpose() const {
+	matrix<T> transposed(cols_, rows_);
+
+	for (size_type row = 0; row != rows_; ++row)
+	  for (size_type col = 0; col != cols_; ++col)
+		transposed(col, row) = (*this)(row, col);
+
+	return transposed;
+  }
+
+  /**
+   * Copies the elements into a regular in memory matrix
+   */
+  matrix<T> to_matrix() const {
+	matrix<T> copy(rows_, cols_);
+	std::copy(begin(), end(), copy.begin());
+	return copy;
+  }
+
+  template<typename EqualCompare = std::equal_to<value_type>, typename Matrix>
+  bool equal_to(const Matrix &rhs) const {
+	return rows_ == rhs.rows() && cols_ == rhs.cols() && std::equal(begin(), end(), rhs.begin(), EqualCompare());
+  }
+
+private:
+  template<typename Matrix>
+  mapped_matrix &add_matrix(const Matrix &rhs) {
+	if (rhs.rows() != rows_ || rhs.cols() != cols_)
+	  throw std::logic_error("Can't add different sized matrices");
+
+	std::transform(begin(), end(), rhs.begin(), begin(),
+				   [](const value_type &lhs, const typename Matrix::value_type &rhs) { return lhs + rhs; });
+	return *this;
+  }
+
+  template<typename Matrix>
+  mapped_matrix &sub_matrix(const Matrix &rhs) {
+	if (rhs.rows() != rows_ || rhs.cols() != cols_)
+	  throw std::logic_error("Can't sub different sized matrices");
+
+	std::transform(begin(), end(), rhs.begin(), begin(),
+				   [](const value_type &lhs, const typename Matrix::value_type &rhs) { return lhs - rhs; });
+	return *this;
+  }
+
+  template<typename Matrix>
+  mapped_matrix &mul_by_element_matrix(const Matrix &rhs) {
+	if (rows_ != rhs.rows() or cols_ != rhs.cols())
+	  throw std::logic_error("Can't multiply by element two matrices because rows != rhs.rows() or cols != rhs.cols()");
+
+	std::transform(begin(), end(), rhs.begin(), begin(),
+				   [](const value_type &lhs, const typename Matrix::value_type &rhs) { return lhs * rhs; });
+	return *this;
+  }
+
+private:
+  detail::file_mapping mapping_;
+  size_type rows_{}, cols_{};
+  pointer data_ = nullptr;
+};
+
+template<typename T>
+std::ostream &operator<<(std::ostream &out, const mapped_matrix<T> &rhs) {
+  rhs.print(out);
+  return out;
+}
+
+template<typename T, typename U>
+mapped_matrix<T> inline &operator+=(mapped_matrix<T> &lhs, const matrix<U> &rhs) {
+  lhs.add(rhs);
+  return lhs;
+}
+
+template<typename T, typename U>
+mapped_matrix<T> inline &operator-=(mapped_matrix<T> &lhs, const matrix<U> &rhs) {
+  lhs.sub(rhs);
+  return lhs;
+}
+
+template<typename T>
+mapped_matrix<T> inline &operator+=(mapped_matrix<T> &lhs, const T &value) {
+  lhs.add(value);
+  return lhs;
+}
+
+template<typename T>
+mapped_matrix<T> inline &operator-=(mapped_matrix<T> &lhs, const T &value) {
+  lhs.sub(value);
+  return lhs;
+}
+
+template<typename T>
+mapped_matrix<T> inline &operator*=(mapped_matrix<T> &lhs, const T &value) {
+  lhs.mul(value);
+  return lhs;
+}
+
+template<typename T>
+mapped_matrix<T> inline &operator/=(mapped_matrix<T> &lhs, const T &value) {
+  lhs.div(value);
+  return lhs;
+}
+
+template<typename T, typename U>
+matrix<T> inline operator*(const mapped_matrix<T> &lhs, const matrix<U> &rhs) {
+  return lhs.mul(rhs);
+}
+
+template<typename T>
+bool inline operator==(const mapped_matrix<T> &lhs, const mapped_matrix<T> &rhs) {
+  return lhs.equal_to(rhs);
+}
+
+template<typename T>
+bool inline operator==(const mapped_matrix<T> &lhs, const matrix<T> &rhs) {
+  return lhs.equal_to(rhs);
+}
+
+template<typename T>
+bool inline operator!=(const mapped_matrix<T> &lhs, const mapped_matrix<T> &rhs) {
+  return !(lhs == rhs);
+}
+
+template<typename T>
+bool inline operator!=(const mapped_matrix<T> &lhs, const matrix<T> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_MAPPED_MATRIX_H_
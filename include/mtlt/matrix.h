@@ -27,6 +27,8 @@
 #include <random>
 #include <chrono>
 #include <vector>
+#include <memory>
+#include <utility>
 #include <iomanip>
 #include <numeric>
 #include <iostream>
@@ -40,8 +42,14 @@
 #include <mtlt/matrix_normal_iterator.h>
 #include <mtlt/matrix_reverse_iterator.h>
 
+#include <mtlt/reduce.h>
+#include <mtlt/random.h>
+#include <mtlt/execution.h>
+#include <mtlt/gemm.h>
+#include <mtlt/compare.h>
 #include <mtlt/matrix_config.h>
 #include <mtlt/matrix_type_traits.h>
+#include <mtlt/instrumentation.h>
 
 namespace mtlt {
 
@@ -112,11 +120,18 @@ public:
   MATRIX_CXX17_CONSTEXPR matrix() noexcept = default;
 
   MATRIX_CXX17_CONSTEXPR matrix(size_type rows, size_type cols, value_type f = {})
-	  : rows_(rows), cols_(cols), data_(new value_type[rows * cols]{}) {
+	  : rows_(rows), cols_(cols), capacity_(rows * cols), data_(allocate(rows * cols, f == value_type{})) {
 	if (f != value_type{})
 	  fill(f);
   }
 
+  /**
+   * Elements of trivially default constructible types are left uninitialized,
+   * use it for matrices which are overwritten right after construction
+   */
+  MATRIX_CXX17_CONSTEXPR matrix(size_type rows, size_type cols, uninitialized_t)
+	  : rows_(rows), cols_(cols), capacity_(rows * cols), data_(allocate(rows * cols, false)) {}
+
   MATRIX_CXX17_CONSTEXPR explicit matrix(size_type square) : matrix(square, square) {};
 
   MATRIX_CXX17_CONSTEXPR explicit matrix(const std::vector<std::vector<value_type>> &matrix_vector)
@@ -128,7 +143,7 @@ public:
 
   MATRIX_CXX20_CONSTEXPR matrix(size_type rows, size_type cols, const std::initializer_list<T> &initializer)
 	  : matrix(rows, cols) {
-	std::copy(initializer.begin(), initializer.end(), begin());
+	std::copy(initializer.begin(), initializer.end(), data_);
   }
 
 #if __cplusplus > 201703L
@@ -142,7 +157,7 @@ public:
   MATRIX_CXX20_CONSTEXPR matrix(size_type rows, size_type cols, const Container &container)
 	  : matrix(rows, cols) {
 #endif // C++ <= 201703L
-	std::copy(container.begin(), container.end(), begin());
+	std::copy(container.begin(), container.end(), data_);
   }
 
   static matrix identity(size_type rows, size_type cols) {
@@ -152,13 +167,13 @@ public:
   }
 
   MATRIX_CXX17_CONSTEXPR matrix(const matrix &other)
-	  : matrix(other.rows_, other.cols_) {
-	std::copy(other.begin(), other.end(), begin());
+	  : matrix(other.rows_, other.cols_, uninitialized) {
+	std::copy(other.data_, other.data_ + other.size(), data_);
   }
 
   MATRIX_CXX17_CONSTEXPR matrix(matrix &&other) noexcept
-	  : rows_(other.rows_), cols_(other.cols_), data_(other.data_) {
-	other.rows_ = other.cols_ = size_type{};
+	  : rows_(other.rows_), cols_(other.cols_), capacity_(other.capacity_), data_(other.data_) {
+	other.rows_ = other.cols_ = other.capacity_ = size_type{};
 	other.data_ = nullptr;
   }
 
@@ -178,6 +193,7 @@ public:
 
 	std::swap(rows_, other.rows_);
 	std::swap(cols_, other.cols_);
+	std::swap(capacity_, other.capacity_);
 	std::swap(data_, other.data_);
 
 	return *this;
@@ -280,50 +296,65 @@ public:
   MATRIX_CXX17_NODISCARD
   size_type size() const noexcept { return rows_ * cols_; }
 
-  void rows(size_type rows) {
-	if (rows_ == rows)
-	  return;
-
-	matrix tmp(rows, cols_);
-	const size_type min_rows = std::min(rows, rows_);
+  MATRIX_CXX17_CONSTEXPR
+  pointer data() noexcept { return data_; }
 
-	for (size_type row = 0; row != min_rows; ++row)
-	  for (size_type col = 0; col != cols_; ++col)
-		tmp(row, col) = (*this)(row, col);
+  MATRIX_CXX17_CONSTEXPR
+  const_pointer data() const noexcept { return data_; }
 
-	*this = std::move(tmp);
+  void rows(size_type rows) {
+	relayout(rows, cols_);
   }
 
   void cols(size_type cols) {
-	if (cols_ == cols)
+	relayout(rows_, cols);
+  }
+
+  void resize(size_type rows, size_type cols) {
+	if (cols_ == cols && rows_ == rows)
 	  return;
 
-	matrix tmp(rows_, cols);
-	const size_type min_cols = std::min(cols, cols_);
+	MTLT_OPERATION_SCOPE(operation::resize, rows, cols, 0, std::min(rows, rows_) * std::min(cols, cols_) * sizeof(value_type), rows * cols * sizeof(value_type));
 
-	for (size_type row = 0; row != rows_; ++row)
-	  for (size_type col = 0; col != min_cols; ++col)
-		tmp(row, col) = (*this)(row, col);
+	relayout(rows, cols);
+  }
 
-	*this = std::move(tmp);
+  /**
+   * Count of elements the matrix can hold without reallocation,
+   * rows(), cols(), resize(), joins and push_back_row() grow it geometrically
+   */
+  MATRIX_CXX17_NODISCARD
+  size_type capacity() const noexcept { return capacity_; }
+
+  void reserve(size_type rows, size_type cols) {
+	if (rows * cols > capacity_)
+	  reallocate(rows * cols);
   }
-  void resize(size_type rows, size_type cols) {
-	if (cols_ == cols && rows_ == rows)
-	  return;
 
-	matrix tmp(rows, cols);
-	const size_type min_cols = std::min(cols, cols_);
-	const size_type min_rows = std::min(rows, rows_);
+  void shrink_to_fit() {
+	if (capacity_ != size())
+	  reallocate(size());
+  }
 
-	for (size_type row = 0; row != min_rows; ++row)
-	  for (size_type col = 0; col != min_cols; ++col)
-		tmp(row, col) = (*this)(row, col);
+  /**
+   * Appends a row in amortized O(cols()), an empty matrix takes cols() from the row
+   */
+  template<typename ForwardIt>
+  void push_back_row(ForwardIt first, ForwardIt last) {
+	const size_type cols = static_cast<size_type>(std::distance(first, last));
+	if (rows_ != 0 && cols != cols_)
+	  throw std::logic_error("Can't push back row because row size != cols()");
 
-	*this = std::move(tmp);
+	relayout(rows_ + 1, cols);
+	std::copy(first, last, data_ + (rows_ - 1) * cols_);
+  }
+
+  void push_back_row(std::initializer_list<value_type> row) {
+	push_back_row(row.begin(), row.end());
   }
 
   void clear() noexcept {
-	rows_ = cols_ = size_type{};
+	rows_ = cols_ = capacity_ = size_type{};
 	delete[] data_;
 	data_ = nullptr;
   }
@@ -364,8 +395,42 @@ public:
 	std::generate(begin(), end(), std::forward<Operation>(op));
   }
 
+  /**
+   * Overloads taking an execution_policy may call op concurrently from
+   * several threads, op must not have data races
+   */
+  template<typename UnaryOperation>
+  void transform(const execution_policy &policy, UnaryOperation op) {
+	detail::for_each_range(policy, size(), [this, &op](size_type first, size_type last) {
+	  std::transform(data_ + first, data_ + last, data_ + first, op);
+	});
+  }
+
+  template<typename BinaryOperation>
+  void transform(const execution_policy &policy, const matrix &other, BinaryOperation op) {
+	detail::for_each_range(policy, size(), [this, &other, &op](size_type first, size_type last) {
+	  std::transform(data_ + first, data_ + last, other.data_ + first, data_ + first, op);
+	});
+  }
+
+  /**
+   * The order of op calls is unspecified for a parallel policy
+   */
+  template<typename Operation>
+  void generate(const execution_policy &policy, Operation op) {
+	detail::for_each_range(policy, size(), [this, &op](size_type first, size_type last) {
+	  std::generate(data_ + first, data_ + last, op);
+	});
+  }
+
   matrix &mul(const value_type &number) {
-	transform([&number](const value_type &item) { return item * number; });
+	return mul(execution::seq, number);
+  }
+
+  matrix &mul(const execution_policy &policy, const value_type &number) {
+	MTLT_OPERATION_SCOPE(operation::mul_by_number, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
+	transform(policy, [&number](const value_type &item) { return item * number; });
 	return *this;
   }
 
@@ -376,18 +441,60 @@ public:
   template<typename U>
   matrix &mul(const matrix<U> &rhs) {
 	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
+#endif
+	return mul(mul_policy(), rhs);
+  }
+
+  /**
+   * The policy chooses the threads and whether Strassen-Winograd is used,
+   * see mul_policy about its accuracy
+   */
+#if __cplusplus > 201703L
+  template<typename U> requires(std::convertible_to<U, T>)
+  matrix &mul(const mul_policy &policy, const matrix<U> &rhs) {
+#else
+  template<typename U>
+  matrix &mul(const mul_policy &policy, const matrix<U> &rhs) {
+	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
 #endif
 	if (cols_ != rhs.rows())
 	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
 
-	const size_type cols = rhs.cols();
-	const size_type rows = rows_;
+	MTLT_OPERATION_SCOPE(operation::mul, rows_, rhs.cols(), 2 * rows_ * cols_ * rhs.cols(), (size() + rhs.size()) * sizeof(value_type), rows_ * rhs.cols() * sizeof(value_type));
+
+	matrix multiplied(rows_, rhs.cols());
+	multiply(policy, rhs, multiplied);
+
+	*this = std::move(multiplied);
+	return *this;
+  }
+
+  /**
+   * Strassen-Winograd recursion down to blocks smaller than threshold,
+   * worth it for the products of thousands of rows
+   */
+  matrix &mul_strassen(const matrix &rhs, size_type threshold = mul_policy::kDefaultStrassenThreshold) {
+	return mul(mul_policy().with_strassen(threshold), rhs);
+  }
+
+  /**
+   * Product in the semiring (see mtlt::semiring), e.g. min_plus
+   * for the shortest paths of at most two edges
+   */
+  template<typename Semiring>
+  matrix &mul(const matrix &rhs) {
+	return mul<Semiring>(execution::seq, rhs);
+  }
+
+  template<typename Semiring>
+  matrix &mul(const execution_policy &policy, const matrix &rhs) {
+	if (cols_ != rhs.rows_)
+	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
+
+	MTLT_OPERATION_SCOPE(operation::mul, rows_, rhs.cols_, 2 * rows_ * cols_ * rhs.cols_, (size() + rhs.size()) * sizeof(value_type), rows_ * rhs.cols_ * sizeof(value_type));
 
-	matrix multiplied(rows, cols);
-	for (size_type row = 0; row != rows; ++row)
-	  for (size_type col = 0; col != cols; ++col)
-		for (size_type k = 0; k != cols_; ++k)
-		  multiplied(row, col) += (*this)(row, k) * rhs(k, col);
+	matrix multiplied(rows_, rhs.cols_, Semiring::template zero<value_type>());
+	detail::semiring_product(policy, rows_, rhs.cols_, cols_, data_, rhs.data_, multiplied.data_, Semiring());
 
 	*this = std::move(multiplied);
 	return *this;
@@ -400,27 +507,49 @@ public:
   template<typename U>
   matrix &mul_by_element(const matrix<U> &rhs) {
 	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
+#endif
+	return mul_by_element(execution::seq, rhs);
+  }
+
+#if __cplusplus > 201703L
+  template<typename U> requires(std::convertible_to<U, T>)
+  matrix &mul_by_element(const execution_policy &policy, const matrix<U> &rhs) {
+#else
+  template<typename U>
+  matrix &mul_by_element(const execution_policy &policy, const matrix<U> &rhs) {
+	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
 #endif
 	if (rows_ != rhs.rows() or cols_ != rhs.cols())
 	  throw std::logic_error("Can't multiply by element two matrices because rows != rhs.rows() or cols != rhs.cols()");
 
-	for (size_type row = 0; row != rows_; ++row)
-	  for (size_type col = 0; col != cols_; ++col)
-		(*this)(row, col) *= rhs(row, col);
+	MTLT_OPERATION_SCOPE(operation::mul_by_element, rows_, cols_, size(), 2 * size() * sizeof(value_type), size() * sizeof(value_type));
 
+	combine(policy, rhs, [](const T &lhs, const U &rhs) { return lhs * rhs; });
 	return *this;
   }
 
   matrix &div(const value_type &number) {
+	return div(execution::seq, number);
+  }
+
+  matrix &div(const execution_policy &policy, const value_type &number) {
 	if (std::is_integral<T>::value && number == 0)
 	  throw std::logic_error("Dividing by zero");
 
-	transform([&number](const value_type &item) { return item / number; });
+	MTLT_OPERATION_SCOPE(operation::div_by_number, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
+	transform(policy, [&number](const value_type &item) { return item / number; });
 	return *this;
   }
 
   matrix &add(const value_type &number) {
-	transform([&number](const value_type &item) { return item + number; });
+	return add(execution::seq, number);
+  }
+
+  matrix &add(const execution_policy &policy, const value_type &number) {
+	MTLT_OPERATION_SCOPE(operation::add, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
+	transform(policy, [&number](const value_type &item) { return item + number; });
 	return *this;
   }
 
@@ -431,16 +560,35 @@ public:
   template<typename U>
   matrix &add(const matrix<U> &rhs) {
 	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
+#endif
+	return add(execution::seq, rhs);
+  }
+
+#if __cplusplus > 201703L
+  template<typename U> requires(std::convertible_to<U, T>)
+  matrix &add(const execution_policy &policy, const matrix<U> &rhs) {
+#else
+  template<typename U>
+  matrix &add(const execution_policy &policy, const matrix<U> &rhs) {
+	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
 #endif
 	if (rhs.rows() != rows_ || rhs.cols() != cols_)
 	  throw std::logic_error("Can't add different sized matrices");
 
-	transform(rhs, [](const T &lhs, const U &rhs) { return lhs + rhs; });
+	MTLT_OPERATION_SCOPE(operation::add, rows_, cols_, size(), 2 * size() * sizeof(value_type), size() * sizeof(value_type));
+
+	combine(policy, rhs, [](const T &lhs, const U &rhs) { return lhs + rhs; });
 	return *this;
   }
 
   matrix &sub(const value_type &number) {
-	transform([&number](const value_type &item) { return item - number; });
+	return sub(execution::seq, number);
+  }
+
+  matrix &sub(const execution_policy &policy, const value_type &number) {
+	MTLT_OPERATION_SCOPE(operation::sub, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
+	transform(policy, [&number](const value_type &item) { return item - number; });
 	return *this;
   }
 
@@ -451,68 +599,135 @@ public:
   template<typename U>
   matrix &sub(const matrix<U> &rhs) {
 	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
+#endif
+	return sub(execution::seq, rhs);
+  }
+
+#if __cplusplus > 201703L
+  template<typename U> requires(std::convertible_to<U, T>)
+  matrix &sub(const execution_policy &policy, const matrix<U> &rhs) {
+#else
+  template<typename U>
+  matrix &sub(const execution_policy &policy, const matrix<U> &rhs) {
+	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
 #endif
 	if (rhs.rows() != rows_ || rhs.cols() != cols_)
 	  throw std::logic_error("Can't add different sized matrices");
 
-	transform(rhs, [](const T &lhs, const U &rhs) { return lhs - rhs; });
+	MTLT_OPERATION_SCOPE(operation::sub, rows_, cols_, size(), 2 * size() * sizeof(value_type), size() * sizeof(value_type));
+
+	combine(policy, rhs, [](const T &lhs, const U &rhs) { return lhs - rhs; });
 	return *this;
   }
 
   matrix &fill(const value_type &number) {
-	generate([&number]() { return number; });
+	return fill(execution::seq, number);
+  }
+
+  matrix &fill(const execution_policy &policy, const value_type &number) {
+	MTLT_OPERATION_SCOPE(operation::fill, rows_, cols_, 0, 0, size() * sizeof(value_type));
+
+	detail::for_each_range(policy, size(), [this, &number](size_type first, size_type last) {
+	  std::fill(data_ + first, data_ + last, number);
+	});
 
 	return *this;
   }
 
+  /**
+   * Uniform values, integers in [left, right] and floating point values in [left, right),
+   * every call uses a new seed
+   */
   matrix &fill_random(const value_type &left, const value_type &right) {
-	using namespace std::chrono;
-
-	std::default_random_engine re(system_clock::now().time_since_epoch().count());
-	auto distribution = typename std::conditional<std::is_integral<T>::value,
-												  std::uniform_int_distribution<T>,
-												  std::uniform_real_distribution<T>>::type(left, right);
-
-	generate([&]() {
-	  return distribution(re);
+	return fill_random(execution::seq, uniform_random<value_type>(detail::random_seed(), left, right));
+  }
+
+  /**
+   * Fills the matrix with a distribution of mtlt/random.h, the values depend
+   * on the seed of the distribution only, not on the policy
+   *
+   * @code
+   *
+   * m.fill_random(mtlt::execution::par, mtlt::uniform_random<float>(42, -1.0f, 1.0f));
+   *
+   * @endcode
+   */
+  template<typename Distribution>
+  matrix &fill_random(const Distribution &distribution) {
+	return fill_random(execution::seq, distribution);
+  }
+
+  template<typename Distribution>
+  matrix &fill_random(const execution_policy &policy, const Distribution &distribution) {
+	MTLT_OPERATION_SCOPE(operation::fill, rows_, cols_, 0, 0, size() * sizeof(value_type));
+
+	detail::for_each_range(policy, size(), [this, &distribution](size_type first, size_type last) {
+	  detail::random_range(distribution, first, last, [this](size_type i, const value_type &value) { data_[i] = value; });
 	});
 
 	return *this;
   }
 
   matrix &to_round() {
-	transform([](const value_type &item) { return std::round(item); });
+	return to_round(execution::seq);
+  }
+
+  matrix &to_round(const execution_policy &policy) {
+	transform(policy, [](const value_type &item) { return std::round(item); });
 	return *this;
   }
 
   matrix round() const {
-	matrix<T> rounded(*this);
-	rounded.transform([](const value_type &item) { return std::round(item); });
+	matrix<T> rounded;
+	round_into(rounded);
 	return rounded;
   }
 
+  void round_into(matrix &out) const {
+	out.prepare_output(rows_, cols_);
+	std::transform(begin(), end(), out.begin(), [](const value_type &item) { return std::round(item); });
+  }
+
   matrix &to_floor() {
-	transform([](const value_type &item) { return std::floor(item); });
+	return to_floor(execution::seq);
+  }
+
+  matrix &to_floor(const execution_policy &policy) {
+	transform(policy, [](const value_type &item) { return std::floor(item); });
 	return *this;
   }
 
   matrix floor() const {
-	matrix<T> floored(*this);
-	floored.transform([](const value_type &item) { return std::floor(item); });
+	matrix<T> floored;
+	floor_into(floored);
 	return floored;
   }
 
+  void floor_into(matrix &out) const {
+	out.prepare_output(rows_, cols_);
+	std::transform(begin(), end(), out.begin(), [](const value_type &item) { return std::floor(item); });
+  }
+
   matrix &to_ceil() {
-	transform([](const value_type &item) { return std::ceil(item); });
+	return to_ceil(execution::seq);
+  }
+
+  matrix &to_ceil(const execution_policy &policy) {
+	transform(policy, [](const value_type &item) { return std::ceil(item); });
 	return *this;
   }
 
   matrix ceil() const {
-	matrix<T> ceiled(*this);
-	ceiled.transform([](const value_type &item) { return std::ceil(item); });
+	matrix<T> ceiled;
+	ceil_into(ceiled);
 	return ceiled;
   }
 
+  void ceil_into(matrix &out) const {
+	out.prepare_output(rows_, cols_);
+	std::transform(begin(), end(), out.begin(), [](const value_type &item) { return std::ceil(item); });
+  }
+
   matrix &to_zero() {
 	generate([]() { return value_type{}; });
 	return *this;
@@ -533,8 +748,202 @@ public:
 	return *this;
   }
 
+  /**
+   * Floating point elements are summed pairwise, large matrices are summed
+   * on several threads, the result does not depend on the count of threads
+   */
   value_type sum() const {
-	return std::accumulate(begin(), end(), value_type{});
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, size(), size() * sizeof(value_type), 0);
+
+	return detail::sum_elements<value_type>(data_, size());
+  }
+
+  double mean() const {
+	if (size() == 0)
+	  throw std::logic_error("Can't calculate mean of empty matrix");
+
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, size(), size() * sizeof(value_type), 0);
+
+	return detail::sum_elements<double>(data_, size()) / static_cast<double>(size());
+  }
+
+  value_type min() const {
+	const std::pair<size_type, size_type> position = argmin();
+	return (*this)(position.first, position.second);
+  }
+
+  value_type max() const {
+	const std::pair<size_type, size_type> position = argmax();
+	return (*this)(position.first, position.second);
+  }
+
+  /**
+   * Row and col of the first smallest element
+   */
+  std::pair<size_type, size_type> argmin() const {
+	return extremum(std::less<value_type>());
+  }
+
+  /**
+   * Row and col of the first largest element
+   */
+  std::pair<size_type, size_type> argmax() const {
+	return extremum(std::greater<value_type>());
+  }
+
+  /**
+   * sqrt of the sum of squares of all elements
+   */
+  double frobenius_norm() const {
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, 2 * size(), size() * sizeof(value_type), 0);
+
+	return std::sqrt(detail::sum_elements<double>(data_, size(), detail::plain_load(), detail::square_transform()));
+  }
+
+  /**
+   * Largest sum of absolute values in a col
+   */
+  double l1_norm() const {
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, size(), size() * sizeof(value_type), 0);
+
+	return detail::max_col_abs_sum(data_, rows_, cols_, detail::plain_load());
+  }
+
+  /**
+   * Largest sum of absolute values in a row
+   */
+  double linf_norm() const {
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, size(), size() * sizeof(value_type), 0);
+
+	return detail::max_row_abs_sum(data_, rows_, cols_, detail::plain_load());
+  }
+
+  /**
+   * Reduces every row, the result is a rows() x 1 col vector
+   *
+   * @code
+   *
+   * mtlt::matrix<double> means = features.reduce_rows(mtlt::reduction::mean);
+   *
+   * @endcode
+   */
+  matrix<double> reduce_rows(reduction r) const {
+	check_reduction(r, cols_);
+
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, size(), size() * sizeof(value_type), rows_ * sizeof(double));
+
+	matrix<double> reduced(rows_, 1, uninitialized);
+	detail::reduce_each_row(data_, rows_, cols_, r, reduced.data(), detail::plain_load());
+	return reduced;
+  }
+
+  /**
+   * Reduces every col, the result is a 1 x cols() row vector
+   */
+  matrix<double> reduce_cols(reduction r) const {
+	check_reduction(r, rows_);
+
+	MTLT_OPERATION_SCOPE(operation::sum, rows_, cols_, size(), size() * sizeof(value_type), cols_ * sizeof(double));
+
+	matrix<double> reduced(1, cols_, uninitialized);
+	detail::reduce_each_col(data_, rows_, cols_, r, reduced.data(), detail::plain_load());
+	return reduced;
+  }
+
+public:
+  /**
+   * Broadcasting operations, a 1 x cols() row vector is applied to every row,
+   * a rows() x 1 col vector is applied to every col
+   */
+#if __cplusplus > 201703L
+  template<typename U> requires(std::convertible_to<U, T>)
+  matrix &add_row_vector(const matrix<U> &row) {
+#else
+  template<typename U>
+  matrix &add_row_vector(const matrix<U> &row) {
+	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
+#endif
+	MTLT_OPERATION_SCOPE(operation::add, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
+	broadcast_row(row, [](const T &lhs, const U &rhs) { return lhs + rhs; });
+	return *this;
+  }
+
+#if __cplusplus > 201703L
+  template<typename U> requires(std::convertible_to<U, T>)
+  matrix &sub_row_vector(const matrix<U> &row) {
+#else
+  template<typename U>
+  matrix &sub_row_vector(const matrix<U> &row) {
+	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
+#endif
+	MTLT_OPERATION_SCOPE(operation::sub, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
+	broadcast_row(row, [](const T &lhs, const U &rhs) { return lhs - rhs; });
+	return *this;
+  }
+
+#if __cplusplus > 201703L
+  template<typename U> requires(std::convertible_to<U, T>)
+  matrix &mul_row_vector(const matrix<U> &row) {
+#else
+  template<typename U>
+  matrix &mul_row_vector(const matrix<U> &row) {
+	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
+#endif
+	MTLT_OPERATION_SCOPE(operation::mul_by_element, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
+	broadcast_row(row, [](const T &lhs, const U &rhs) { return lhs * rhs; });
+	return *this;
+  }
+
+#if __cplusplus > 201703L
+  template<typename U> requires(std::convertible_to<U, T>)
+  matrix &add_col_vector(const matrix<U> &col) {
+#else
+  template<typename U>
+  matrix &add_col_vector(const matrix<U> &col) {
+	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
+#endif
+	MTLT_OPERATION_SCOPE(operation::add, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
+	broadcast_col(col, [](const T &lhs, const U &rhs) { return lhs + rhs; });
+	return *this;
+  }
+
+#if __cplusplus > 201703L
+  template<typename U> requires(std::convertible_to<U, T>)
+  matrix &sub_col_vector(const matrix<U> &col) {
+#else
+  template<typename U>
+  matrix &sub_col_vector(const matrix<U> &col) {
+	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
+#endif
+	MTLT_OPERATION_SCOPE(operation::sub, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
+	broadcast_col(col, [](const T &lhs, const U &rhs) { return lhs - rhs; });
+	return *this;
+  }
+
+#if __cplusplus > 201703L
+  template<typename U> requires(std::convertible_to<U, T>)
+  matrix &mul_col_vector(const matrix<U> &col) {
+#else
+  template<typename U>
+  matrix &mul_col_vector(const matrix<U> &col) {
+	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
+#endif
+	MTLT_OPERATION_SCOPE(operation::mul_by_element, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
+	broadcast_col(col, [](const T &lhs, const U &rhs) { return lhs * rhs; });
+	return *this;
+  }
+
+  /**
+   * Subtracts the mean of every row from the elements of that row
+   */
+  matrix &sub_row_mean() {
+	return sub_col_vector(reduce_rows(reduction::mean));
   }
 
 public:
@@ -546,145 +955,183 @@ public:
   }
 
   matrix join_left(const matrix &rhs) const {
+	matrix<T> join_matrix;
+	join_left_into(rhs, join_matrix);
+	return join_matrix;
+  }
+
+  void join_left_into(const matrix &rhs, matrix &out) const {
 	if (rhs.rows() != rows_)
 	  throw std::logic_error("Can't join left rhs matrix to lhs, because lhs.rows() != rhs.rows()");
 
-	matrix<T> join_matrix(rows_, cols_ + rhs.cols());
-
-	size_type cols2 = rhs.cols();
+	if (&out == this || &out == &rhs) {
+	  matrix<T> join_matrix;
+	  join_left_into(rhs, join_matrix);
+	  out = std::move(join_matrix);
+	  return;
+	}
 
-	for (size_type row = 0; row != join_matrix.rows(); ++row)
-	  for (size_type col = 0; col != join_matrix.cols(); ++col) {
-		if (col < cols2)
-		  join_matrix(row, col) = rhs(row, col);
-		else
-		  join_matrix(row, col) = (*this)(row, col - cols_);
-	  }
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
 
-	return join_matrix;
+	out.prepare_output(rows_, cols_ + rhs.cols_);
+	for (size_type row = 0; row != rows_; ++row) {
+	  const_pointer lhs_row = data_ + row * cols_, rhs_row = rhs.data_ + row * rhs.cols_;
+	  std::copy(lhs_row, lhs_row + cols_, std::copy(rhs_row, rhs_row + rhs.cols_, out.data_ + row * out.cols_));
+	}
   }
 
   void to_join_right(const matrix &rhs) {
 	if (rhs.rows() != rows_)
 	  throw std::logic_error("Can't join left rhs matrix to lhs, because lhs.rows() != rhs.rows()");
 
-	size_type old_cols = cols_;
-	size_type cols2 = rhs.cols();
+	if (&rhs == this) {
+	  *this = join_right(rhs);
+	  return;
+	}
 
-	this->cols(cols_ + rhs.cols());
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
+
+	const size_type old_cols = cols_;
+	relayout(rows_, cols_ + rhs.cols_);
 
 	for (size_type row = 0; row != rows_; ++row)
-	  for (size_type col = 0; col != cols_; ++col)
-		if (col >= old_cols)
-		  (*this)(row, col) = rhs(row, col - cols2);
+	  std::copy(rhs.data_ + row * rhs.cols_, rhs.data_ + (row + 1) * rhs.cols_, data_ + row * cols_ + old_cols);
   }
 
   matrix join_right(const matrix &rhs) const {
+	matrix<T> join_matrix;
+	join_right_into(rhs, join_matrix);
+	return join_matrix;
+  }
+
+  void join_right_into(const matrix &rhs, matrix &out) const {
 	if (rhs.rows() != rows_)
 	  throw std::logic_error("Can't join right rhs matrix to lhs, because lhs.rows() != rhs.rows()");
 
-	matrix<T> join_matrix(rows_, cols_ + rhs.cols());
-	size_type cols2 = rhs.cols();
+	if (&out == this || &out == &rhs) {
+	  matrix<T> join_matrix;
+	  join_right_into(rhs, join_matrix);
+	  out = std::move(join_matrix);
+	  return;
+	}
 
-	for (size_type row = 0; row != join_matrix.rows(); ++row)
-	  for (size_type col = 0; col != join_matrix.cols(); ++col) {
-		if (col < cols_)
-		  join_matrix(row, col) = (*this)(row, col);
-		else
-		  join_matrix(row, col) = rhs(row, col - cols2);
-	  }
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
 
-	return join_matrix;
+	out.prepare_output(rows_, cols_ + rhs.cols_);
+	for (size_type row = 0; row != rows_; ++row) {
+	  const_pointer lhs_row = data_ + row * cols_, rhs_row = rhs.data_ + row * rhs.cols_;
+	  std::copy(rhs_row, rhs_row + rhs.cols_, std::copy(lhs_row, lhs_row + cols_, out.data_ + row * out.cols_));
+	}
   }
 
   void to_join_top(const matrix &rhs) {
-	if (rhs.rows() != rows_)
+	if (rhs.cols() != cols_)
 	  throw std::logic_error("Can't join top rhs matrix to lhs, because lhs.cols() != rhs.cols()");
 
 	*this = join_top(rhs);
   }
 
   matrix join_top(const matrix &rhs) const {
-	if (rhs.rows() != rows_)
+	matrix<T> join_matrix;
+	join_top_into(rhs, join_matrix);
+	return join_matrix;
+  }
+
+  void join_top_into(const matrix &rhs, matrix &out) const {
+	if (rhs.cols() != cols_)
 	  throw std::logic_error("Can't join top rhs matrix to lhs, because lhs.cols() != rhs.cols()");
 
-	size_type old_rows = rows_;
-	size_type rows2 = rhs.rows();
-	matrix<T> join_matrix(rows_ + rhs.rows(), cols_);
+	if (&out == this || &out == &rhs) {
+	  matrix<T> join_matrix;
+	  join_top_into(rhs, join_matrix);
+	  out = std::move(join_matrix);
+	  return;
+	}
 
-	for (size_type row = 0; row != join_matrix.rows(); ++row)
-	  for (size_type col = 0; col != join_matrix.cols(); ++col) {
-		if (row < rows2)
-		  join_matrix(row, col) = rhs(row, col);
-		else
-		  join_matrix(row, col) = (*this)(row - old_rows, col);
-	  }
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
 
-	return join_matrix;
+	out.prepare_output(rows_ + rhs.rows_, cols_);
+	std::copy(data_, data_ + size(), std::copy(rhs.data_, rhs.data_ + rhs.size(), out.data_));
   }
 
   void to_join_bottom(const matrix &rhs) {
-	if (rhs.rows() != rows_)
+	if (rhs.cols() != cols_)
 	  throw std::logic_error("Can't join bottom rhs matrix to lhs, because lhs.cols() != rhs.cols()");
 
-	size_type old_rows = rows_;
-	size_type rows2 = rhs.rows();
-	this->rows(rows_ + rhs.rows());
+	if (&rhs == this) {
+	  *this = join_bottom(rhs);
+	  return;
+	}
 
-	for (size_type row = 0; row != rows_; ++row)
-	  for (size_type col = 0; col != cols_; ++col) {
-		if (row >= old_rows)
-		  (*this)(row, col) = rhs(row - rows2, col);
-	  }
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
+
+	const size_type old_size = size();
+	relayout(rows_ + rhs.rows_, cols_);
+
+	std::copy(rhs.data_, rhs.data_ + rhs.size(), data_ + old_size);
   }
 
   matrix join_bottom(const matrix &rhs) const {
-	if (rhs.rows() != rows_)
+	matrix<T> join_matrix;
+	join_bottom_into(rhs, join_matrix);
+	return join_matrix;
+  }
+
+  void join_bottom_into(const matrix &rhs, matrix &out) const {
+	if (rhs.cols() != cols_)
 	  throw std::logic_error("Can't join bottom rhs matrix to lhs, because lhs.cols() != rhs.cols()");
 
-	matrix<T> join_matrix(rows_ + rhs.rows(), cols_);
-	size_type rows2 = rhs.rows();
+	if (&out == this || &out == &rhs) {
+	  matrix<T> join_matrix;
+	  join_bottom_into(rhs, join_matrix);
+	  out = std::move(join_matrix);
+	  return;
+	}
 
-	for (size_type row = 0; row != join_matrix.rows(); ++row)
-	  for (size_type col = 0; col != join_matrix.cols(); ++col) {
-		if (row < rows_)
-		  join_matrix(row, col) = (*this)(row, col);
-		else
-		  join_matrix(row, col) = rhs(row - rows2, col);
-	  }
+	MTLT_OPERATION_SCOPE(operation::join, rows_, cols_, 0, (size() + rhs.size()) * sizeof(value_type), (size() + rhs.size()) * sizeof(value_type));
 
-	return join_matrix;
+	out.prepare_output(rows_ + rhs.rows_, cols_);
+	std::copy(rhs.data_, rhs.data_ + rhs.size(), std::copy(data_, data_ + size(), out.data_));
   }
 
 public:
   matrix transpose() const {
-	matrix transposed(cols_, rows_);
+	matrix transposed;
+	transpose_into(transposed);
+	return transposed;
+  }
+
+  void transpose_into(matrix &out) const {
+	if (&out == this) {
+	  matrix transposed;
+	  transpose_into(transposed);
+	  out = std::move(transposed);
+	  return;
+	}
 
+	MTLT_OPERATION_SCOPE(operation::transpose, rows_, cols_, 0, size() * sizeof(value_type), size() * sizeof(value_type));
+
+	out.prepare_output(cols_, rows_);
 	for (size_type row = 0; row != rows_; ++row)
 	  for (size_type col = 0; col != cols_; ++col)
-		transposed(col, row) = (*this)(row, col);
-
-	return transposed;
+		out(col, row) = (*this)(row, col);
   }
 
   matrix minor(size_type row, size_type col) const {
-	matrix minor(rows() - 1, cols() - 1);
-
-	size_type skip_row = 0, skip_col = 0;
-	for (size_type r = 0; r != minor.rows_; ++r) {
-	  if (row == r)
-		skip_row = 1;
-
-	  skip_col = 0;
-	  for (size_type c = 0; c != minor.cols_; ++c) {
-		if (col == c)
-		  skip_col = 1;
+	matrix minored;
+	minor_into(row, col, minored);
+	return minored;
+  }
 
-		minor(r, c) = (*this)(r + skip_row, c + skip_col);
-	  }
+  void minor_into(size_type row, size_type col, matrix &out) const {
+	if (&out == this) {
+	  matrix minored;
+	  minor_into(row, col, minored);
+	  out = std::move(minored);
+	  return;
 	}
 
-	return minor;
+	copy_minor(row, col, out);
   }
 
   double minor_item(size_type row, size_type col) const {
@@ -695,50 +1142,18 @@ public:
 	if (rows_ != cols_)
 	  throw std::logic_error("determinant_gaussian can be found only for square matrices");
 
-	double determinant_value = 1;
+	MTLT_OPERATION_SCOPE(operation::determinant, rows_, cols_, 2 * rows_ * rows_ * rows_ / 3, size() * sizeof(value_type), 0);
 
 	matrix<double> matrix(rows_, cols_, *this);
-	const size_type kN = matrix.rows();
-
-	for (size_type i = 0; i != kN; ++i) {
-	  double pivot = matrix(i, i);
-	  size_type pivot_row = i;
-	  for (size_type row = i + 1; row != kN; ++row) {
-		double row_i_item = matrix(row, i);
-		row_i_item = row_i_item < 0 ? -row_i_item : row_i_item;
-		double temp_pivot = pivot < 0 ? -pivot : pivot;
-
-		if (row_i_item > temp_pivot) {
-		  pivot = matrix(row, i);
-		  pivot_row = row;
-		}
-	  }
-
-	  if (pivot == value_type{}) {
-		return value_type{};
-	  }
-
-	  if (pivot_row != i) {
-		matrix.swap_rows(i, pivot_row);
-		determinant_value = -determinant_value;
-	  }
-
-	  determinant_value *= pivot;
-
-	  for (size_type row = i + 1; row != kN; ++row) {
-		for (size_type col = i + 1; col != kN; ++col) {
-		  matrix(row, col) -= matrix(row, i) * matrix(i, col) / pivot;
-		}
-	  }
-	}
-
-	return determinant_value;
+	return gaussian_elimination(matrix);
   }
 
   double determinant_laplacian() const {
 	if (rows_ != cols_)
 	  throw std::logic_error("determinant_laplacian can be found only for square matrices");
 
+	MTLT_OPERATION_SCOPE(operation::determinant, rows_, cols_, rows_ < 2 ? 0 : rows_ == 2 ? 3 : 3 * rows_, size() * sizeof(value_type), 0);
+
 	int sign = 1;
 	double determinant_value{};
 
@@ -771,6 +1186,8 @@ public:
 	if (rows_ != cols_)
 	  throw std::logic_error("Complements matrix can be found only for square matrices");
 
+	MTLT_OPERATION_SCOPE(operation::complements, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
 	matrix<T> complements(rows_, cols_);
 
 	for (size_type row = 0; row != rows_; ++row) {
@@ -786,6 +1203,8 @@ public:
   }
 
   matrix inverse() const {
+	MTLT_OPERATION_SCOPE(operation::inverse, rows_, cols_, 0, 0, 0);
+
 	double determinant = determinant_gaussian();
 
 	if (std::fabs(determinant) <= 1e-6)
@@ -795,12 +1214,59 @@ public:
   }
 
   matrix inverse(double determinant) const {
+	MTLT_OPERATION_SCOPE(operation::inverse, rows_, cols_, 0, 0, 0);
+
 	if (std::fabs(determinant) <= 1e-6)
 	  throw std::logic_error("Can't found inverse matrix because determinant is zero");
 
 	return calc_complements().transpose().mul(1 / determinant);
   }
 
+  /**
+   * Same as calc_complements(), the minors share one scratch buffer
+   */
+  void calc_complements_into(matrix &out) const {
+	if (rows_ != cols_)
+	  throw std::logic_error("Complements matrix can be found only for square matrices");
+
+	if (&out == this) {
+	  matrix complements;
+	  calc_complements_into(complements);
+	  out = std::move(complements);
+	  return;
+	}
+
+	MTLT_OPERATION_SCOPE(operation::complements, rows_, cols_, size(), size() * sizeof(value_type), size() * sizeof(value_type));
+
+	out.prepare_output(rows_, cols_);
+	write_complements(out, false);
+  }
+
+  void inverse_into(matrix &out) const {
+	inverse_into(determinant_gaussian(), out);
+  }
+
+  void inverse_into(double determinant, matrix &out) const {
+	if (rows_ != cols_)
+	  throw std::logic_error("Complements matrix can be found only for square matrices");
+
+	if (std::fabs(determinant) <= 1e-6)
+	  throw std::logic_error("Can't found inverse matrix because determinant is zero");
+
+	if (&out == this) {
+	  matrix inversed;
+	  inverse_into(determinant, inversed);
+	  out = std::move(inversed);
+	  return;
+	}
+
+	MTLT_OPERATION_SCOPE(operation::inverse, rows_, cols_, 0, 0, 0);
+
+	out.prepare_output(rows_, cols_);
+	write_complements(out, true);
+	out.mul(1 / determinant);
+  }
+
   void swap_rows(size_type row1, size_type row2) {
 	if (row1 >= rows_ || row2 >= rows_)
 	  throw std::logic_error("row1 or row2 is bigger that this->rows()");
@@ -822,13 +1288,35 @@ public:
 	if (rows_ != rhs.rows() || cols_ != rhs.cols())
 	  return false;
 
-	EqualCompare compare;
-	for (size_type row = 0; row != rows_; ++row)
-	  for (size_type col = 0; col != cols_; ++col)
-		if (!compare((*this)(row, col), rhs(row, col)))
-		  return false;
+	return detail::equal_elements(data_, rhs.data_, size(), EqualCompare());
+  }
+
+  /**
+   * Floating point comparison with tolerance, for every element
+   * |lhs - rhs| <= max(abs_tol, rel_tol * max(|lhs|, |rhs|)),
+   * stops at the first block containing a mismatch
+   *
+   * NaN elements are never equal, infinities of the same sign are
+   */
+  bool approx_equal(const matrix &rhs, value_type abs_tol = value_type(1e-8), value_type rel_tol = value_type(1e-5)) const {
+	static_assert(std::is_floating_point<value_type>::value, "approx_equal is defined only for floating point types");
 
-	return true;
+	if (rows_ != rhs.rows() || cols_ != rhs.cols())
+	  return false;
+
+	return detail::approx_equal_elements(data_, rhs.data_, size(), abs_tol, rel_tol);
+  }
+
+  /**
+   * Largest absolute element wise difference, NaN if any of the differences is NaN
+   */
+  value_type max_abs_diff(const matrix &rhs) const {
+	static_assert(std::is_floating_point<value_type>::value, "max_abs_diff is defined only for floating point types");
+
+	if (rows_ != rhs.rows() || cols_ != rhs.cols())
+	  throw std::logic_error("Can't compare matrices with different dimensions");
+
+	return detail::max_abs_diff_elements(data_, rhs.data_, size());
   }
 
 public:
@@ -841,8 +1329,8 @@ public:
   matrix<U> convert_to() const {
 	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
 #endif
-	matrix<U> convert(rows_, cols_);
-	std::copy(begin(), end(), convert.begin());
+	matrix<U> convert(rows_, cols_, uninitialized);
+	std::copy(data_, data_ + size(), convert.data());
 	return convert;
   }
 
@@ -854,9 +1342,7 @@ public:
   std::vector<U> to_vector() const {
 	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
 #endif
-	std::vector<U> v(rows_ *cols_);
-	std::copy(begin(), end(), v.begin());
-	return v;
+	return std::vector<U>(data_, data_ + size());
   }
 
 #if __cplusplus > 201703L
@@ -877,7 +1363,242 @@ public:
   }
 
 private:
-  size_type rows_{}, cols_{};
+  template<typename U>
+  friend class matrix;
+
+  void multiply(const mul_policy &policy, const matrix &rhs, matrix &out) const {
+	if (policy.uses_strassen(rows_, rhs.cols_, cols_)) {
+	  detail::strassen_winograd(policy.execution(), rows_, rhs.cols_, cols_, data_, rhs.data_, out.data_, policy.strassen_threshold());
+	  return;
+	}
+
+	detail::gemm(policy.execution(), rows_, rhs.cols_, cols_, data_, cols_, rhs.data_, rhs.cols_, out.data_, out.cols_);
+  }
+
+  template<typename U>
+  void multiply(const mul_policy &policy, const matrix<U> &rhs, matrix &out) const {
+	detail::gemm(policy.execution(), rows_, rhs.cols_, cols_, data_, cols_, rhs.data_, rhs.cols_, out.data_, out.cols_);
+  }
+
+  /**
+   * this[i] = op(this[i], rhs[i]) for matrices of the same shape
+   */
+  template<typename U, typename Operation>
+  void combine(const execution_policy &policy, const matrix<U> &rhs, Operation op) {
+	const U *values = rhs.data_;
+	detail::for_each_range(policy, size(), [this, values, &op](size_type first, size_type last) {
+	  for (; first != last; ++first)
+		data_[first] = op(data_[first], values[first]);
+	});
+  }
+
+  /**
+   * Only sums and norms are defined for rows or cols without elements
+   */
+  static void check_reduction(reduction r, size_type length) {
+	if (length == 0 && r != reduction::sum && r != reduction::norm)
+	  throw std::logic_error("Can't reduce empty rows or cols");
+  }
+
+  template<typename U, typename Operation>
+  void broadcast_row(const matrix<U> &row, Operation op) {
+	if (row.rows() != 1 || row.cols() != cols_)
+	  throw std::logic_error("Can't broadcast row vector because its shape is not 1 x cols()");
+
+	const U *vector = row.data_;
+	detail::parallel_ranges(detail::reduce_threads<value_type>(size()), rows_, 1, [&](std::size_t, size_type first, size_type last) {
+	  for (pointer values = data_ + first * cols_; first != last; ++first, values += cols_)
+		for (size_type col = 0; col != cols_; ++col)
+		  values[col] = op(values[col], vector[col]);
+	});
+  }
+
+  template<typename U, typename Operation>
+  void broadcast_col(const matrix<U> &col, Operation op) {
+	if (col.rows() != rows_ || col.cols() != 1)
+	  throw std::logic_error("Can't broadcast col vector because its shape is not rows() x 1");
+
+	const U *vector = col.data_;
+	detail::parallel_ranges(detail::reduce_threads<value_type>(size()), rows_, 1, [&](std::size_t, size_type first, size_type last) {
+	  for (pointer values = data_ + first * cols_; first != last; ++first, values += cols_) {
+		const U value = vector[first];
+		for (size_type col = 0; col != cols_; ++col)
+		  values[col] = op(values[col], value);
+	  }
+	});
+  }
+
+  template<typename Compare>
+  std::pair<size_type, size_type> extremum(Compare compare) const {
+	if (size() == 0)
+	  throw std::logic_error("Can't find extremum of empty matrix");
+
+	MTLT_OPERATION_SCOPE(operation::other, rows_, cols_, size(), size() * sizeof(value_type), 0);
+
+	const size_type index = detail::extremum_index<value_type>(data_, size(), detail::plain_load(), compare);
+	return std::make_pair(index / cols_, index % cols_);
+  }
+
+  /**
+   * Gives the matrix rows x cols shape for writing a result into it,
+   * the buffer is kept when its capacity is enough, the values are unspecified
+   */
+  void prepare_output(size_type rows, size_type cols) {
+	if (rows * cols > capacity_)
+	  *this = matrix(rows, cols, uninitialized);
+
+	rows_ = rows;
+	cols_ = cols;
+  }
+
+  /**
+   * Elements of trivially default constructible types are
+   * not initialized unless initialize is true
+   */
+  static pointer allocate(size_type count, bool initialize) {
+	MTLT_COUNT_ALLOCATION(count * sizeof(value_type));
+
+	if (!initialize && std::is_trivially_default_constructible<value_type>::value)
+	  return new value_type[count];
+
+	return new value_type[count]{};
+  }
+
+  /**
+   * Moves the buffer to a new one holding capacity elements, the shape is kept
+   */
+  void reallocate(size_type capacity) {
+	std::unique_ptr<value_type[]> data(allocate(capacity, false));
+
+	std::copy(data_, data_ + size(), data.get());
+	delete[] data_;
+	data_ = data.release();
+	capacity_ = capacity;
+  }
+
+  /**
+   * Changes the shape keeping the top left min(rows) x min(cols) elements,
+   * the new elements are value initialized. Works in place when the capacity
+   * is enough, otherwise grows it at least twice. Rows are moved with std::copy,
+   * which is a memmove for trivially copyable types
+   */
+  void relayout(size_type rows, size_type cols) {
+	if (rows == rows_ && cols == cols_)
+	  return;
+
+	const size_type min_rows = std::min(rows, rows_);
+	const size_type min_cols = std::min(cols, cols_);
+
+	if (rows * cols > capacity_) {
+	  const size_type capacity = std::max(rows * cols, 2 * capacity_);
+	  std::unique_ptr<value_type[]> data(allocate(capacity, false));
+
+	  for (size_type row = 0; row != min_rows; ++row) {
+		std::copy(data_ + row * cols_, data_ + row * cols_ + min_cols, data.get() + row * cols);
+		std::fill(data.get() + row * cols + min_cols, data.get() + (row + 1) * cols, value_type{});
+	  }
+
+	  std::fill(data.get() + min_rows * cols, data.get() + rows * cols, value_type{});
+
+	  delete[] data_;
+	  data_ = data.release();
+	  capacity_ = capacity;
+	} else {
+	  if (cols < cols_) {
+		for (size_type row = 1; row < min_rows; ++row)
+		  std::copy(data_ + row * cols_, data_ + row * cols_ + min_cols, data_ + row * cols);
+	  } else if (cols > cols_) {
+		for (size_type row = min_rows; row-- != 0;) {
+		  std::copy_backward(data_ + row * cols_, data_ + row * cols_ + min_cols, data_ + row * cols + min_cols);
+		  std::fill(data_ + row * cols + min_cols, data_ + (row + 1) * cols, value_type{});
+		}
+	  }
+
+	  std::fill(data_ + min_rows * cols, data_ + rows * cols, value_type{});
+	}
+
+	rows_ = rows;
+	cols_ = cols;
+  }
+
+  template<typename U>
+  void copy_minor(size_type row, size_type col, matrix<U> &out) const {
+	out.prepare_output(rows_ - 1, cols_ - 1);
+
+	typename matrix<U>::iterator item = out.begin();
+	for (size_type r = 0; r != rows_; ++r) {
+	  if (r == row)
+		continue;
+
+	  for (size_type c = 0; c != cols_; ++c)
+		if (c != col)
+		  *item++ = static_cast<U>((*this)(r, c));
+	}
+  }
+
+  /**
+   * Writes the algebraic complements into out, transposed for the inverse matrix
+   */
+  void write_complements(matrix &out, bool transposed) const {
+	matrix<double> minored;
+
+	for (size_type row = 0; row != rows_; ++row) {
+	  for (size_type col = 0; col != cols_; ++col) {
+		copy_minor(row, col, minored);
+
+		value_type complement = static_cast<value_type>(gaussian_elimination(minored));
+		if ((row + col) % 2 != 0)
+		  complement = -complement;
+
+		(transposed ? out(col, row) : out(row, col)) = complement;
+	  }
+	}
+  }
+
+  /**
+   * Determinant of a square matrix by gaussian elimination, the matrix is destroyed
+   */
+  static double gaussian_elimination(matrix<double> &matrix) {
+	double determinant_value = 1;
+	const size_type kN = matrix.rows();
+
+	for (size_type i = 0; i != kN; ++i) {
+	  double pivot = matrix(i, i);
+	  size_type pivot_row = i;
+	  for (size_type row = i + 1; row != kN; ++row) {
+		double row_i_item = matrix(row, i);
+		row_i_item = row_i_item < 0 ? -row_i_item : row_i_item;
+		double temp_pivot = pivot < 0 ? -pivot : pivot;
+
+		if (row_i_item > temp_pivot) {
+		  pivot = matrix(row, i);
+		  pivot_row = row;
+		}
+	  }
+
+	  if (pivot == value_type{}) {
+		return value_type{};
+	  }
+
+	  if (pivot_row != i) {
+		matrix.swap_rows(i, pivot_row);
+		determinant_value = -determinant_value;
+	  }
+
+	  determinant_value *= pivot;
+
+	  for (size_type row = i + 1; row != kN; ++row) {
+		for (size_type col = i + 1; col != kN; ++col) {
+		  matrix(row, col) -= matrix(row, i) * matrix(i, col) / pivot;
+		}
+	  }
+	}
+
+	return determinant_value;
+  }
+
+private:
+  size_type rows_{}, cols_{}, capacity_{};
   pointer data_ = nullptr;
 };
 
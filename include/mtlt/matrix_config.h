@@ -80,4 +80,24 @@ struct matrix_debug_settings {
 #  endif
 #endif
 
+namespace mtlt {
+
+/**
+ * Tag for constructors which leave trivially default constructible elements
+ * uninitialized, elements of other types are value initialized as usual
+ *
+ * @code
+ *
+ * mtlt::matrix<double> m(1000, 1000, mtlt::uninitialized); // garbage values
+ *
+ * @endcode
+ */
+struct uninitialized_t {
+  explicit uninitialized_t() = default;
+};
+
+MATRIX_CXX17_INLINE constexpr uninitialized_t uninitialized{};
+
+}
+
 #endif // MTLT_MATRIX_CONFIG_H_
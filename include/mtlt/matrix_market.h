@@ -0,0 +1,333 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Reading and writing matrices in Matrix Market .mtx format
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_MATRIX_MARKET_H_
+#define MTLT_MATRIX_MARKET_H_
+
+#include <string>
+#include <vector>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include <mtlt/csv.h>
+#include <mtlt/matrix.h>
+#include <mtlt/matrix_config.h>
+#include <mtlt/file_mapping.h>
+#include <mtlt/sparse_matrix.h>
+
+namespace mtlt {
+
+namespace detail {
+
+/**
+ * Banner line: %%MatrixMarket matrix <format> <field> <symmetry>
+ */
+struct mtx_banner {
+  bool coordinate = false;
+  bool pattern = false;
+  bool integer = false;
+  bool symmetric = false;
+  bool skew = false;
+};
+
+class mtx_reader {
+public:
+  mtx_reader(const char *first, const char *last) : current_(first), last_(last) {}
+
+  std::string line() {
+	const char *eol = line_end(current_, last_);
+	std::string text(current_, eol);
+	current_ = eol == last_ ? last_ : eol + 1;
+	return text;
+  }
+
+  void skip_comments() {
+	for (;;) {
+	  while (current_ != last_ && std::isspace(static_cast<unsigned char>(*current_)))
+		++current_;
+
+	  if (current_ == last_ || *current_ != '%')
+		return;
+
+	  line();
+	}
+  }
+
+  template<typename Number>
+  Number number() {
+	while (current_ != last_ && std::isspace(static_cast<unsigned char>(*current_)))
+	  ++current_;
+
+	Number value{};
+	const char *next = current_ == last_ ? nullptr : parse_number(current_, last_, value);
+	if (next == nullptr)
+	  throw std::runtime_error("Can't read mtx because of invalid or missing number");
+
+	current_ = next;
+	return value;
+  }
+
+private:
+  const char *current_;
+  const char *last_;
+};
+
+inline mtx_banner parse_mtx_banner(std::string banner) {
+  for (char &c : banner)
+	c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+  const std::string kPrefix = "%%matrixmarket matrix ";
+  if (banner.compare(0, kPrefix.size(), kPrefix) != 0)
+	throw std::runtime_error("Can't read matrix because data is not in Matrix Market format");
+
+  auto has = [&banner](const char *word) { return banner.find(word) != std::string::npos; };
+
+  mtx_banner parsed;
+  parsed.coordinate = has(" coordinate");
+  parsed.pattern = has(" pattern");
+  parsed.integer = has(" integer");
+  parsed.skew = has(" skew-symmetric");
+  parsed.symmetric = !parsed.skew && has(" symmetric");
+
+  if (!parsed.coordinate && !has(" array"))
+	throw std::runtime_error("Can't read mtx because format is neither coordinate nor array");
+
+  if (has(" complex") || has(" hermitian"))
+	throw std::runtime_error("Can't read mtx because complex matrices are not supported");
+
+  return parsed;
+}
+
+/**
+ * Parses the text and passes every element to emit(row, col, value)
+ * with zero based indices, mirrored elements of symmetric matrices included.
+ * init(rows, cols, entries) is called once before the first element
+ */
+template<typename T, typename Init, typename Emit>
+void parse_mtx_elements(const char *first, const char *last, Init &&init, Emit &&emit) {
+  mtx_reader reader(first, last);
+  const mtx_banner banner = parse_mtx_banner(reader.line());
+
+  reader.skip_comments();
+  const std::size_t rows = reader.number<std::size_t>();
+  const std::size_t cols = reader.number<std::size_t>();
+  const std::size_t entries = banner.coordinate ? reader.number<std::size_t>() : rows * cols;
+
+  init(rows, cols, entries);
+
+  auto value = [&reader, &banner]() -> T {
+	if (banner.pattern)
+	  return T(1);
+	return banner.integer ? static_cast<T>(reader.number<long long>()) : static_cast<T>(reader.number<double>());
+  };
+
+  auto store = [&](std::size_t row, std::size_t col, T item) {
+	emit(row, col, item);
+	if (row != col && (banner.symmetric || banner.skew))
+	  emit(col, row, banner.skew ? static_cast<T>(-item) : item);
+  };
+
+  if (banner.coordinate) {
+	for (std::size_t i = 0; i != entries; ++i) {
+	  reader.skip_comments();
+	  const std::size_t row = reader.number<std::size_t>();
+	  const std::size_t col = reader.number<std::size_t>();
+
+	  if (row == 0 || row > rows || col == 0 || col > cols)
+		throw std::runtime_error("Can't read mtx because entry " + std::to_string(i) + " is out of range of matrix");
+
+	  store(row - 1, col - 1, value());
+	}
+  } else {
+	// Column major, symmetric matrices keep only the lower triangle
+	for (std::size_t col = 0; col != cols; ++col) {
+	  const std::size_t first_row = banner.symmetric ? col : banner.skew ? col + 1 : 0;
+	  for (std::size_t row = first_row; row < rows; ++row) {
+		reader.skip_comments();
+		store(row, col, value());
+	  }
+	}
+  }
+}
+
+template<typename Function>
+auto with_text(const std::string &path, Function &&f) -> decltype(f(nullptr, nullptr)) {
+  const file_mapping mapping(path, map_mode::read_only);
+  mapping.advise(access_hint::sequential, 0, mapping.size());
+  return f(mapping.data(), mapping.data() + mapping.size());
+}
+
+template<typename T>
+const char *mtx_field() {
+  return std::is_integral<T>::value ? "integer" : "real";
+}
+
+template<typename T>
+void write_mtx_line(std::string &out, std::size_t row, std::size_t col, const T &value, bool with_indices) {
+  char buffer[512];
+  char *current = buffer;
+
+  if (with_indices) {
+	current = format_number(current, buffer + sizeof(buffer), row + 1, -1);
+	*current++ = ' ';
+	current = format_number(current, buffer + sizeof(buffer), col + 1, -1);
+	*current++ = ' ';
+  }
+
+  current = format_number(current, buffer + sizeof(buffer) - 1, value, -1);
+  if (current == nullptr)
+	throw std::runtime_error("Can't write mtx because number is too long");
+
+  *current++ = '\n';
+  out.append(buffer, current);
+}
+
+inline void flush_mtx(std::ostream &os, std::string &out, bool force) {
+  const std::size_t kFlushSize = 1 << 20;
+
+  if (force || out.size() >= kFlushSize) {
+	os.write(out.data(), static_cast<std::streamsize>(out.size()));
+	out.clear();
+  }
+}
+
+} // namespace detail end
+
+/**
+ * Reads coordinate or array .mtx text into a dense matrix,
+ * symmetric and skew-symmetric matrices are expanded
+ */
+template<typename T>
+matrix<T> parse_mtx(const char *data, std::size_t size) {
+  matrix<T> m;
+  detail::parse_mtx_elements<T>(data, data + size,
+					   [&m](std::size_t rows, std::size_t cols, std::size_t) { m = matrix<T>(rows, cols); },
+					   [&m](std::size_t row, std::size_t col, const T &value) { m(row, col) = value; });
+  return m;
+}
+
+/**
+ * Reads coordinate or array .mtx text into a sparse matrix,
+ * duplicated coordinates are summed
+ */
+template<typename T>
+sparse_matrix<T> parse_mtx_sparse(const char *data, std::size_t size) {
+  using entry = typename sparse_matrix<T>::entry;
+
+  std::size_t rows = 0, cols = 0;
+  std::vector<entry> entries;
+
+  detail::parse_mtx_elements<T>(data, data + size,
+					   [&](std::size_t r, std::size_t c, std::size_t count) {
+						 rows = r, cols = c;
+						 entries.reserve(count);
+					   },
+					   [&entries](std::size_t row, std::size_t col, const T &value) {
+						 if (value != T{})
+						   entries.push_back(entry{row, col, value});
+					   });
+
+  return sparse_matrix<T>(rows, cols, std::move(entries));
+}
+
+template<typename T>
+matrix<T> read_mtx(std::istream &is) {
+  const std::string text((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+  return parse_mtx<T>(text.data(), text.size());
+}
+
+template<typename T>
+matrix<T> read_mtx(const std::string &path) {
+  return detail::with_text(path, [](const char *first, const char *last) {
+	return parse_mtx<T>(first, static_cast<std::size_t>(last - first));
+  });
+}
+
+template<typename T>
+sparse_matrix<T> read_mtx_sparse(std::istream &is) {
+  const std::string text((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+  return parse_mtx_sparse<T>(text.data(), text.size());
+}
+
+template<typename T>
+sparse_matrix<T> read_mtx_sparse(const std::string &path) {
+  return detail::with_text(path, [](const char *first, const char *last) {
+	return parse_mtx_sparse<T>(first, static_cast<std::size_t>(last - first));
+  });
+}
+
+/**
+ * Dense matrices are written in array format (column major)
+ */
+template<typename T>
+void write_mtx(std::ostream &os, const matrix<T> &m) {
+  std::string out = std::string("%%MatrixMarket matrix array ") + detail::mtx_field<T>() + " general\n"
+	  + std::to_string(m.rows()) + ' ' + std::to_string(m.cols()) + '\n';
+
+  for (std::size_t col = 0; col != m.cols(); ++col) {
+	for (std::size_t row = 0; row != m.rows(); ++row) {
+	  detail::write_mtx_line(out, row, col, m(row, col), false);
+	  detail::flush_mtx(os, out, false);
+	}
+  }
+
+  detail::flush_mtx(os, out, true);
+  if (!os)
+	throw std::runtime_error("Can't write mtx to stream");
+}
+
+/**
+ * Sparse matrices are written in coordinate format
+ */
+template<typename T>
+void write_mtx(std::ostream &os, const sparse_matrix<T> &m) {
+  std::string out = std::string("%%MatrixMarket matrix coordinate ") + detail::mtx_field<T>() + " general\n"
+	  + std::to_string(m.rows()) + ' ' + std::to_string(m.cols()) + ' ' + std::to_string(m.nonzeros()) + '\n';
+
+  for (std::size_t row = 0; row != m.rows(); ++row) {
+	for (std::size_t i = m.row_offsets()[row]; i != m.row_offsets()[row + 1]; ++i) {
+	  detail::write_mtx_line(out, row, m.col_indices()[i], m.values()[i], true);
+	  detail::flush_mtx(os, out, false);
+	}
+  }
+
+  detail::flush_mtx(os, out, true);
+  if (!os)
+	throw std::runtime_error("Can't write mtx to stream");
+}
+
+template<typename Matrix>
+void write_mtx(const Matrix &m, const std::string &path) {
+  std::ofstream os(path, std::ios::binary | std::ios::trunc);
+  if (!os.is_open())
+	throw std::runtime_error("Can't open file " + path + " for writing");
+
+  write_mtx(os, m);
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_MATRIX_MARKET_H_
@@ -25,6 +25,15 @@
 #include <mtlt/matrix_config.h>
 
 namespace mtlt {
+
+/**
+ * @class matrix_normal_iterator
+ *
+ * Wrapper over a pointer to the matrix elements. The elements are contiguous,
+ * so since C++20 the iterator models std::contiguous_iterator and
+ * std::ranges algorithms reduce copies and comparisons to memmove and memcmp.
+ * Classic std algorithms only do it for raw pointers, which Base() returns
+ */
 template<typename Iterator>
 class matrix_normal_iterator {
 protected:
@@ -33,10 +42,13 @@ protected:
 public:
   using iterator_type = Iterator;
   using iterator_category = std::random_access_iterator_tag;
-  using value_type = typename std::remove_reference<decltype(*current_)>::type;
+#if __cplusplus > 201703L
+  using iterator_concept = std::contiguous_iterator_tag;
+#endif
+  using value_type = typename std::iterator_traits<Iterator>::value_type;
   using pointer = Iterator;
   using const_pointer = const Iterator;
-  using reference = value_type &;
+  using reference = typename std::iterator_traits<Iterator>::reference;
   using const_reference = const value_type &;
   using difference_type = std::ptrdiff_t;
 
@@ -49,24 +61,13 @@ public:
 
 public:
   MATRIX_CXX17_CONSTEXPR
-  reference operator*() noexcept { return *current_; }
-
-  MATRIX_CXX17_CONSTEXPR
-  const_reference operator*() const noexcept { return *current_; }
-
-  MATRIX_CXX17_CONSTEXPR
-  pointer operator->() noexcept { return current_; }
-
-  MATRIX_CXX17_CONSTEXPR
-  const_pointer operator->() const noexcept { return current_; }
+  reference operator*() const noexcept { return *current_; }
 
   MATRIX_CXX17_CONSTEXPR
-  reference operator[](difference_type n) noexcept {
-	return current_[n];
-  }
+  pointer operator->() const noexcept { return current_; }
 
   MATRIX_CXX17_CONSTEXPR
-  const_reference operator[](difference_type n) const noexcept {
+  reference operator[](difference_type n) const noexcept {
 	return current_[n];
   }
 
@@ -99,7 +100,7 @@ public:
   }
 
   MATRIX_CXX17_CONSTEXPR
-  matrix_normal_iterator operator+(difference_type n) noexcept {
+  matrix_normal_iterator operator+(difference_type n) const noexcept {
 	return matrix_normal_iterator(current_ + n);
   }
 
@@ -110,7 +111,7 @@ public:
   }
 
   MATRIX_CXX17_CONSTEXPR
-  matrix_normal_iterator operator-(difference_type n) noexcept {
+  matrix_normal_iterator operator-(difference_type n) const noexcept {
 	return matrix_normal_iterator(current_ - n);
   }
 
@@ -120,6 +121,13 @@ public:
   }
 };
 
+template<typename Iterator>
+MATRIX_CXX17_NODISCARD MATRIX_CXX17_CONSTEXPR
+matrix_normal_iterator<Iterator> operator+(typename matrix_normal_iterator<Iterator>::difference_type n,
+										   const matrix_normal_iterator<Iterator> &it) noexcept {
+  return it + n;
+}
+
 template<typename Iterator>
 MATRIX_CXX17_NODISCARD MATRIX_CXX17_CONSTEXPR
 bool operator==(const matrix_normal_iterator<Iterator> &lhs,
@@ -152,14 +160,14 @@ template<typename Iterator>
 MATRIX_CXX17_NODISCARD
 inline bool operator<=(const matrix_normal_iterator<Iterator> &lhs,
 					   const matrix_normal_iterator<Iterator> &rhs) {
-  return lhs.Base() < rhs.Base();
+  return lhs.Base() <= rhs.Base();
 }
 
 template<typename Iterator>
 MATRIX_CXX17_NODISCARD
 inline bool operator>=(const matrix_normal_iterator<Iterator> &lhs,
 					   const matrix_normal_iterator<Iterator> &rhs) {
-  return lhs.Base() > rhs.Base();
+  return lhs.Base() >= rhs.Base();
 }
 
 template<typename Iterator>
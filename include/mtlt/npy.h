@@ -0,0 +1,298 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Reading and writing matrices in NumPy .npy format
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_NPY_H_
+#define MTLT_NPY_H_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <mtlt/matrix.h>
+#include <mtlt/matrix_config.h>
+#include <mtlt/file_mapping.h>
+#include <mtlt/serialization.h>
+#include <mtlt/mapped_matrix.h>
+
+namespace mtlt {
+
+/**
+ * @struct npy_header
+ *
+ * Decoded header of a .npy file: numpy dtype string (e.g. "<f8"),
+ * memory order and shape, 1-D arrays are treated as a single row
+ * and 0-D arrays as 1 x 1
+ */
+struct npy_header {
+  std::string descr;
+  bool fortran_order = false;
+  std::uint64_t rows = 0;
+  std::uint64_t cols = 0;
+  std::uint64_t data_offset = 0;
+
+  MATRIX_CXX17_NODISCARD
+  bool big_endian() const noexcept { return !descr.empty() && descr[0] == '>'; }
+};
+
+namespace detail {
+
+const char kNpyMagic[] = "\x93NUMPY";
+const std::size_t kNpyMagicSize = 6;
+const std::size_t kNpyAlignment = 64;
+
+template<typename T>
+std::string npy_descr() {
+  static_assert(std::is_arithmetic<T>::value, "npy supports only numeric matrices");
+
+  const char kind = std::is_same<T, bool>::value ? 'b'
+	  : std::is_floating_point<T>::value ? 'f'
+	  : std::is_signed<T>::value ? 'i' : 'u';
+  const char order = sizeof(T) == 1 ? '|' : is_big_endian() ? '>' : '<';
+
+  return std::string(1, order) + kind + std::to_string(sizeof(T));
+}
+
+/**
+ * Finds the value of 'key' in the python dict literal of the header
+ */
+inline std::string::size_type npy_find_value(const std::string &dict, const char *key) {
+  const std::string quoted = std::string("'") + key + "'";
+  std::string::size_type position = dict.find(quoted);
+  if (position == std::string::npos)
+	throw std::runtime_error(std::string("Can't read npy because header has no ") + key);
+
+  position = dict.find(':', position + quoted.size());
+  position = dict.find_first_not_of(" ", position + 1);
+  if (position == std::string::npos)
+	throw std::runtime_error("Can't read npy because header is corrupted");
+
+  return position;
+}
+
+inline npy_header parse_npy_dict(const std::string &dict) {
+  npy_header header;
+
+  std::string::size_type position = npy_find_value(dict, "descr");
+  const char quote = dict[position];
+  std::string::size_type end = dict.find(quote, position + 1);
+  if (end == std::string::npos)
+	throw std::runtime_error("Can't read npy because header is corrupted");
+  header.descr = dict.substr(position + 1, end - position - 1);
+
+  position = npy_find_value(dict, "fortran_order");
+  header.fortran_order = dict.compare(position, 4, "True") == 0;
+
+  position = npy_find_value(dict, "shape");
+  end = dict.find(')', position);
+  if (dict[position] != '(' || end == std::string::npos)
+	throw std::runtime_error("Can't read npy because header is corrupted");
+
+  std::vector<std::uint64_t> shape;
+  const std::string dims = dict.substr(position + 1, end - position - 1);
+  for (std::string::size_type i = 0; i != dims.size();) {
+	if (dims[i] >= '0' && dims[i] <= '9') {
+	  std::uint64_t dim = 0;
+	  for (; i != dims.size() && dims[i] >= '0' && dims[i] <= '9'; ++i)
+		dim = dim * 10 + static_cast<std::uint64_t>(dims[i] - '0');
+	  shape.push_back(dim);
+	} else {
+	  ++i;
+	}
+  }
+
+  if (shape.size() > 2)
+	throw std::runtime_error("Can't read npy because only 1-D and 2-D arrays can be read as matrix");
+
+  header.rows = shape.size() == 2 ? shape[0] : 1;
+  header.cols = shape.empty() ? 1 : shape.back();
+
+  return header;
+}
+
+/**
+ * Decodes magic, version and the header dict from the first bytes of a file,
+ * size is the count of available bytes. Returns 0 in data_offset if more bytes are needed
+ */
+inline npy_header decode_npy_header(const char *bytes, std::size_t size) {
+  if (size < kNpyMagicSize + 2 || std::memcmp(bytes, kNpyMagic, kNpyMagicSize) != 0)
+	throw std::runtime_error("Can't read matrix because data is not in npy format");
+
+  const unsigned char major = static_cast<unsigned char>(bytes[kNpyMagicSize]);
+  if (major < 1 || major > 3)
+	throw std::runtime_error("Can't read npy because format version is not supported");
+
+  const std::size_t length_size = major == 1 ? 2 : 4;
+  const std::size_t prefix = kNpyMagicSize + 2 + length_size;
+  if (size < prefix)
+	return npy_header{};
+
+  std::uint64_t length = 0;
+  for (std::size_t i = 0; i != length_size; ++i)
+	length |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[kNpyMagicSize + 2 + i])) << (8 * i);
+
+  if (size < prefix + length)
+	return npy_header{};
+
+  npy_header header = parse_npy_dict(std::string(bytes + prefix, static_cast<std::size_t>(length)));
+  header.data_offset = prefix + length;
+
+  return header;
+}
+
+template<typename T>
+void check_npy_header(const npy_header &header) {
+  const std::string expected = npy_descr<T>();
+
+  if (header.descr.size() != expected.size() || header.descr.compare(1, std::string::npos, expected, 1, std::string::npos) != 0)
+	throw std::logic_error("Can't read npy because stored dtype " + header.descr + " differs from matrix value_type");
+}
+
+inline npy_header read_npy_header(std::istream &is) {
+  std::string bytes(kNpyMagicSize + 6, '\0');
+  if (!is.read(&bytes[0], static_cast<std::streamsize>(bytes.size())))
+	throw std::runtime_error("Can't read npy header from stream");
+
+  npy_header header = decode_npy_header(bytes.data(), kNpyMagicSize + 2);
+  const std::size_t length_size = bytes[kNpyMagicSize] == 1 ? 2 : 4;
+
+  std::uint64_t length = 0;
+  for (std::size_t i = 0; i != length_size; ++i)
+	length |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[kNpyMagicSize + 2 + i])) << (8 * i);
+
+  const std::size_t prefix = kNpyMagicSize + 2 + length_size;
+  bytes.resize(prefix + static_cast<std::size_t>(length));
+
+  // 6 bytes after the magic were read ahead, v1 header length takes only 2 of them
+  const std::size_t read_ahead = kNpyMagicSize + 6 - prefix;
+  if (!is.read(&bytes[kNpyMagicSize + 6], static_cast<std::streamsize>(length - read_ahead)))
+	throw std::runtime_error("Can't read npy header from stream");
+
+  header = decode_npy_header(bytes.data(), bytes.size());
+  return header;
+}
+
+} // namespace detail end
+
+/**
+ * Reads a .npy array of the same dtype as T. Arrays in fortran order
+ * and in foreign byte order are converted while reading.
+ * Throws std::runtime_error for malformed input and
+ * std::logic_error if the dtype differs from T
+ */
+template<typename T>
+matrix<T> read_npy(std::istream &is) {
+  const npy_header header = detail::read_npy_header(is);
+  detail::check_npy_header<T>(header);
+
+  const std::size_t rows = static_cast<std::size_t>(header.rows);
+  const std::size_t cols = static_cast<std::size_t>(header.cols);
+
+  matrix<T> m(header.fortran_order ? cols : rows, header.fortran_order ? rows : cols);
+  if (!is.read(reinterpret_cast<char *>(m.data()), static_cast<std::streamsize>(m.size() * sizeof(T))))
+	throw std::runtime_error("Can't read npy elements from stream");
+
+  if (sizeof(T) > 1 && header.big_endian() != detail::is_big_endian())
+	for (T &item : m)
+	  detail::byte_swap(&item, sizeof(T));
+
+  return header.fortran_order ? m.transpose() : m;
+}
+
+template<typename T>
+matrix<T> read_npy(const std::string &path) {
+  std::ifstream is = detail::open_binary_input(path);
+  return read_npy<T>(is);
+}
+
+/**
+ * Maps a .npy file without copying the elements. Works only for C ordered
+ * arrays of the same dtype and byte order as T, std::logic_error is thrown
+ * otherwise and read_npy has to be used instead
+ */
+template<typename T>
+mapped_matrix<T> map_npy(const std::string &path,
+						 map_mode mode = map_mode::read_only,
+						 access_hint hint = access_hint::normal) {
+  detail::file_mapping mapping(path, mode);
+
+  const npy_header header = detail::decode_npy_header(mapping.data(), mapping.size());
+  if (header.data_offset == 0)
+	throw std::runtime_error("Can't map npy because file " + path + " is truncated");
+
+  detail::check_npy_header<T>(header);
+
+  if (header.fortran_order)
+	throw std::logic_error("Can't map npy because array is in fortran order, use read_npy");
+
+  if (sizeof(T) > 1 && header.big_endian() != detail::is_big_endian())
+	throw std::logic_error("Can't map npy because array has another byte order, use read_npy");
+
+  return mapped_matrix<T>(std::move(mapping), static_cast<std::size_t>(header.data_offset),
+						  static_cast<std::size_t>(header.rows), static_cast<std::size_t>(header.cols), hint);
+}
+
+/**
+ * Writes a 2-D C ordered array of any matrix with contiguous data(),
+ * the header is padded so that the elements start at a 64 byte boundary
+ */
+template<typename Matrix>
+void write_npy(std::ostream &os, const Matrix &m) {
+  using value_type = typename std::remove_cv<typename std::remove_reference<decltype(*m.data())>::type>::type;
+
+  std::string dict = "{'descr': '" + detail::npy_descr<value_type>() + "', 'fortran_order': False, 'shape': ("
+	  + std::to_string(m.rows()) + ", " + std::to_string(m.cols()) + "), }";
+
+  const std::size_t prefix = detail::kNpyMagicSize + 4;
+  const std::size_t total = (prefix + dict.size() + 1 + detail::kNpyAlignment - 1) / detail::kNpyAlignment * detail::kNpyAlignment;
+  dict.append(total - prefix - dict.size() - 1, ' ');
+  dict.push_back('\n');
+
+  const std::size_t length = dict.size();
+  if (length > 0xFFFF)
+	throw std::runtime_error("Can't write npy because header is too long");
+
+  const char version[2] = {1, 0};
+  const char length_bytes[2] = {static_cast<char>(length & 0xFF), static_cast<char>(length >> 8)};
+
+  os.write(detail::kNpyMagic, detail::kNpyMagicSize);
+  os.write(version, 2);
+  os.write(length_bytes, 2);
+  os.write(dict.data(), static_cast<std::streamsize>(dict.size()));
+  os.write(reinterpret_cast<const char *>(m.data()), static_cast<std::streamsize>(m.rows() * m.cols() * sizeof(value_type)));
+
+  if (!os)
+	throw std::runtime_error("Can't write npy to stream");
+}
+
+template<typename Matrix>
+void write_npy(const Matrix &m, const std::string &path) {
+  std::ofstream os = detail::open_binary_output(path);
+  write_npy(os, m);
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_NPY_H_
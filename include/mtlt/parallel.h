@@ -0,0 +1,391 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Work stealing executor and fork/join helpers for running
+ *        independent parts of a matrix operation on several threads
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_PARALLEL_H_
+#define MTLT_PARALLEL_H_
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace mtlt {
+
+namespace detail {
+
+inline unsigned hardware_threads() noexcept {
+  const unsigned threads = std::thread::hardware_concurrency();
+  return threads == 0 ? 1 : threads;
+}
+
+} // namespace detail end
+
+/**
+ * @class executor
+ *
+ * Runs the jobs of the parallel kernels of the library. By default the jobs go
+ * to a work_stealing_executor with a worker per hardware thread, set_executor
+ * hands them to the thread pool of the application instead
+ *
+ * A thread waiting for its jobs runs the ones nobody has started itself,
+ * so the kernels finish even if the executor never runs a job, and nested
+ * parallel kernels never wait for a blocked worker
+ */
+class executor {
+public:
+  virtual ~executor() = default;
+
+  /**
+   * Count of threads running the jobs, the waiting thread included
+   */
+  virtual std::size_t concurrency() const noexcept = 0;
+
+  virtual void submit(std::function<void()> job) = 0;
+
+  /**
+   * Runs one of the submitted jobs on the calling thread, returns false
+   * when there is nothing to run. Lets a waiting thread help the workers
+   */
+  virtual bool try_run_one() { return false; }
+};
+
+/**
+ * @class work_stealing_executor
+ *
+ * Every worker has its own deque, a worker pushes and pops the jobs
+ * at the back of its deque (the last forked job is the hottest in cache)
+ * and steals from the front of the others when its deque is empty.
+ * Jobs submitted from the other threads go to a shared deque
+ */
+class work_stealing_executor final : public executor {
+public:
+  explicit work_stealing_executor(std::size_t workers = detail::hardware_threads() - 1) {
+	for (std::size_t index = 0; index != workers + 1; ++index)
+	  queues_.emplace_back(new queue);
+
+	threads_.reserve(workers);
+	for (std::size_t index = 0; index != workers; ++index)
+	  threads_.emplace_back(&work_stealing_executor::work, this, index);
+  }
+
+  work_stealing_executor(const work_stealing_executor &) = delete;
+  work_stealing_executor &operator=(const work_stealing_executor &) = delete;
+
+  ~work_stealing_executor() override {
+	{
+	  std::lock_guard<std::mutex> lock(sleep_mutex_);
+	  stop_ = true;
+	}
+	wake_.notify_all();
+
+	for (auto &thread : threads_)
+	  thread.join();
+  }
+
+public:
+  std::size_t concurrency() const noexcept override { return threads_.size() + 1; }
+
+  void submit(std::function<void()> job) override {
+	queue &target = *queues_[own_queue()];
+	{
+	  std::lock_guard<std::mutex> lock(target.mutex);
+	  target.jobs.push_back(std::move(job));
+	  queued_.fetch_add(1, std::memory_order_release);
+	}
+
+	{
+	  std::lock_guard<std::mutex> lock(sleep_mutex_);
+	}
+	wake_.notify_one();
+  }
+
+  bool try_run_one() override {
+	std::function<void()> job;
+	if (!take(own_queue(), job))
+	  return false;
+
+	job();
+	return true;
+  }
+
+private:
+  struct queue {
+	std::mutex mutex;
+	std::deque<std::function<void()>> jobs;
+  };
+
+  struct worker_identity {
+	const work_stealing_executor *owner = nullptr;
+	std::size_t index = 0;
+  };
+
+  static worker_identity &current_worker() noexcept {
+	static thread_local worker_identity identity;
+	return identity;
+  }
+
+  /**
+   * Deque of the calling worker, the shared one for the other threads
+   */
+  std::size_t own_queue() const noexcept {
+	const worker_identity &identity = current_worker();
+	return identity.owner == this ? identity.index : threads_.size();
+  }
+
+  bool take(std::size_t own, std::function<void()> &job) {
+	if (queued_.load(std::memory_order_acquire) == 0)
+	  return false;
+
+	for (std::size_t offset = 0; offset != queues_.size(); ++offset) {
+	  queue &victim = *queues_[(own + offset) % queues_.size()];
+	  std::lock_guard<std::mutex> lock(victim.mutex);
+	  if (victim.jobs.empty())
+		continue;
+
+	  if (offset == 0) {
+		job = std::move(victim.jobs.back());
+		victim.jobs.pop_back();
+	  } else {
+		job = std::move(victim.jobs.front());
+		victim.jobs.pop_front();
+	  }
+
+	  queued_.fetch_sub(1, std::memory_order_relaxed);
+	  return true;
+	}
+
+	return false;
+  }
+
+  void work(std::size_t index) {
+	current_worker().owner = this;
+	current_worker().index = index;
+
+	std::function<void()> job;
+	for (;;) {
+	  if (take(index, job)) {
+		job();
+		job = nullptr;
+		continue;
+	  }
+
+	  std::unique_lock<std::mutex> lock(sleep_mutex_);
+	  wake_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_acquire) != 0; });
+	  if (stop_ && queued_.load(std::memory_order_acquire) == 0)
+		return;
+	}
+  }
+
+private:
+  std::vector<std::unique_ptr<queue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<std::size_t> queued_{0};
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+};
+
+namespace detail {
+
+inline executor &default_executor() {
+  static work_stealing_executor instance;
+  return instance;
+}
+
+inline std::atomic<executor *> &installed_executor() noexcept {
+  static std::atomic<executor *> installed{nullptr};
+  return installed;
+}
+
+} // namespace detail end
+
+/**
+ * Installs the executor used by the library, nullptr restores the default one.
+ * The executor must outlive the parallel kernels started while it is installed
+ */
+inline void set_executor(executor *e) noexcept {
+  detail::installed_executor().store(e, std::memory_order_release);
+}
+
+inline executor &get_executor() {
+  executor *installed = detail::installed_executor().load(std::memory_order_acquire);
+  return installed != nullptr ? *installed : detail::default_executor();
+}
+
+namespace detail {
+
+inline std::size_t available_threads() {
+  return get_executor().concurrency();
+}
+
+/**
+ * Part of a range given away to the executor, whoever moves state
+ * from kPending to kClaimed runs it
+ */
+struct fork_piece {
+  static constexpr int kPending = 0, kClaimed = 1, kDone = 2;
+
+  std::atomic<int> state{kPending};
+  std::exception_ptr error;
+
+  bool claim() noexcept {
+	int expected = kPending;
+	return state.compare_exchange_strong(expected, kClaimed, std::memory_order_acq_rel);
+  }
+};
+
+/**
+ * Halves [first, last) until it is not bigger than grain, the right halves are
+ * submitted as jobs, the left one is run in place. Then every submitted half
+ * is either claimed back and run in place or waited for
+ */
+template<typename Function>
+void fork_join(executor &ex, std::size_t first, std::size_t last, std::size_t grain, Function &f) {
+  struct forked {
+	std::shared_ptr<fork_piece> piece;
+	std::size_t first, last;
+  };
+
+  std::vector<forked> pieces;
+  while (last - first > grain) {
+	const std::size_t middle = first + (last - first) / 2;
+	std::shared_ptr<fork_piece> piece = std::make_shared<fork_piece>();
+
+	try {
+	  // f and ex are touched only by the job which claims the piece,
+	  // this call does not return before the piece is claimed and done
+	  ex.submit([piece, middle, last, grain, &ex, &f]() {
+		if (!piece->claim())
+		  return;
+
+		try {
+		  fork_join(ex, middle, last, grain, f);
+		} catch (...) {
+		  piece->error = std::current_exception();
+		}
+		piece->state.store(fork_piece::kDone, std::memory_order_release);
+	  });
+	} catch (...) {
+	  break; // Not forked, the whole rest is run in place
+	}
+
+	pieces.push_back(forked{std::move(piece), middle, last});
+	last = middle;
+  }
+
+  std::exception_ptr error;
+  try {
+	f(first, last);
+  } catch (...) {
+	error = std::current_exception();
+  }
+
+  for (auto it = pieces.rbegin(); it != pieces.rend(); ++it) {
+	if (it->piece->claim()) {
+	  try {
+		fork_join(ex, it->first, it->last, grain, f);
+	  } catch (...) {
+		if (!error)
+		  error = std::current_exception();
+	  }
+	  continue;
+	}
+
+	while (it->piece->state.load(std::memory_order_acquire) != fork_piece::kDone)
+	  if (!ex.try_run_one())
+		std::this_thread::yield();
+
+	if (it->piece->error && !error)
+	  error = it->piece->error;
+  }
+
+  if (error)
+	std::rethrow_exception(error);
+}
+
+} // namespace detail end
+
+/**
+ * Calls f(begin, end) for parts of [first, last) not bigger than grain
+ * (except when the executor has a single thread) on the threads of the executor.
+ * Returns when all parts are done, an exception of a part is rethrown.
+ * f may start nested parallel_for calls
+ */
+template<typename Function>
+void parallel_for(std::size_t first, std::size_t last, std::size_t grain, Function &&f) {
+  if (first >= last)
+	return;
+
+  executor &ex = get_executor();
+  grain = std::max<std::size_t>(grain, 1);
+
+  if (last - first <= grain || ex.concurrency() <= 1) {
+	f(first, last);
+	return;
+  }
+
+  detail::fork_join(ex, first, last, grain, f);
+}
+
+namespace detail {
+
+/**
+ * Calls f(task) for every task in [0, tasks) on the threads of the executor.
+ * Returns when all tasks are finished, an exception of a failed task is rethrown
+ */
+template<typename Function>
+void parallel_tasks(std::size_t tasks, Function &&f) {
+  parallel_for(0, tasks, 1, [&f](std::size_t first, std::size_t last) {
+	for (; first != last; ++first)
+	  f(first);
+  });
+}
+
+/**
+ * Calls f(task, first, last) for consecutive parts of [0, count) on threads threads,
+ * the parts are cut at multiples of granularity
+ */
+template<typename Function>
+void parallel_ranges(std::size_t threads, std::size_t count, std::size_t granularity, Function &&f) {
+  const std::size_t units = (count + granularity - 1) / granularity;
+
+  parallel_tasks(threads, [&](std::size_t task) {
+	const std::size_t first = std::min(count, units * task / threads * granularity);
+	const std::size_t last = std::min(count, units * (task + 1) / threads * granularity);
+	f(task, first, last);
+  });
+}
+
+} // namespace detail end
+
+} // namespace mtlt end
+
+#endif // MTLT_PARALLEL_H_
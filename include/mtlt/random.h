@@ -0,0 +1,271 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Counter based random number generation (Philox4x32-10)
+ *        for reproducible parallel filling of matrices
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_RANDOM_H_
+#define MTLT_RANDOM_H_
+
+#include <cmath>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mtlt {
+
+namespace detail {
+
+/**
+ * Philox4x32-10 block function of Salmon et al. "Parallel random numbers:
+ * as easy as 1, 2, 3", maps a 128 bit counter and a 64 bit key to 128 random bits
+ */
+inline void philox4x32(const std::uint32_t (&counter)[4], const std::uint32_t (&key)[2], std::uint32_t (&out)[4]) noexcept {
+  constexpr std::uint32_t kMultiplier0 = 0xD2511F53, kMultiplier1 = 0xCD9E8D57;
+  constexpr std::uint32_t kWeyl0 = 0x9E3779B9, kWeyl1 = 0xBB67AE85;
+
+  std::uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+  std::uint32_t k0 = key[0], k1 = key[1];
+
+  for (int round = 0; round != 10; ++round) {
+	const std::uint64_t product0 = static_cast<std::uint64_t>(kMultiplier0) * c0;
+	const std::uint64_t product1 = static_cast<std::uint64_t>(kMultiplier1) * c2;
+
+	c0 = static_cast<std::uint32_t>(product1 >> 32) ^ c1 ^ k0;
+	c1 = static_cast<std::uint32_t>(product1);
+	c2 = static_cast<std::uint32_t>(product0 >> 32) ^ c3 ^ k1;
+	c3 = static_cast<std::uint32_t>(product0);
+
+	k0 += kWeyl0;
+	k1 += kWeyl1;
+  }
+
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+/**
+ * Seed for the unseeded fill_random, the calls made in the same clock tick get different seeds
+ */
+inline std::uint64_t random_seed() noexcept {
+  static std::atomic<std::uint64_t> calls{0};
+
+  const std::uint64_t now = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+  std::uint64_t seed = now ^ (calls.fetch_add(1, std::memory_order_relaxed) * 0x9E3779B97F4A7C15ull);
+
+  // splitmix64 finalizer
+  seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ull;
+  seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBull;
+  return seed ^ (seed >> 31);
+}
+
+/**
+ * Uniform double in [0, 1) from 53 bits of two words
+ */
+inline double uniform_unit(std::uint32_t high, std::uint32_t low) noexcept {
+  return static_cast<double>(((static_cast<std::uint64_t>(high) << 32) | low) >> 11) / 9007199254740992.0;
+}
+
+} // namespace detail end
+
+/**
+ * @class philox_engine
+ *
+ * Counter based generator, block(n) is a pure function of the seed, the stream
+ * and n, so any part of a random sequence is computed without generating
+ * the preceding values and the result does not depend on the count of threads
+ */
+class philox_engine {
+public:
+  explicit philox_engine(std::uint64_t seed, std::uint64_t stream = 0) noexcept
+	  : key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+		stream_{static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)} {}
+
+  /**
+   * 128 random bits of the block with index n
+   */
+  void block(std::uint64_t n, std::uint32_t (&out)[4]) const noexcept {
+	const std::uint32_t counter[4] = {static_cast<std::uint32_t>(n), static_cast<std::uint32_t>(n >> 32), stream_[0], stream_[1]};
+	detail::philox4x32(counter, key_, out);
+  }
+
+private:
+  std::uint32_t key_[2];
+  std::uint32_t stream_[2];
+};
+
+/**
+ * Random distributions for fill_random of the matrix containers
+ *
+ * Element i of a matrix always gets the same value for the same seed and stream,
+ * every distribution makes kValuesPerBlock values out of one Philox block
+ *
+ * @code
+ *
+ * m.fill_random(mtlt::execution::par, mtlt::normal_random<double>(42, 0.0, 1.0));
+ *
+ * @endcode
+ */
+template<typename T>
+class uniform_random {
+public:
+  using result_type = T;
+
+  static constexpr std::size_t kValuesPerBlock = 2;
+
+public:
+  /**
+   * Integers are uniform in [left, right], floating point values in [left, right)
+   */
+  uniform_random(std::uint64_t seed, T left, T right, std::uint64_t stream = 0)
+	  : engine_(seed, stream), left_(left), right_(right) {
+	if (right < left)
+	  throw std::logic_error("Can't make uniform distribution because right < left");
+  }
+
+  void generate(std::uint64_t block, T (&values)[kValuesPerBlock]) const noexcept {
+	std::uint32_t bits[4];
+	engine_.block(block, bits);
+
+	for (std::size_t i = 0; i != kValuesPerBlock; ++i)
+	  values[i] = value(bits[2 * i], bits[2 * i + 1], std::is_integral<T>());
+  }
+
+private:
+  T value(std::uint32_t high, std::uint32_t low, std::true_type) const noexcept {
+	const std::uint64_t range = static_cast<std::uint64_t>(right_) - static_cast<std::uint64_t>(left_) + 1;
+	const std::uint64_t bits = (static_cast<std::uint64_t>(high) << 32) | low;
+	return static_cast<T>(static_cast<std::uint64_t>(left_) + (range == 0 ? bits : bits % range));
+  }
+
+  T value(std::uint32_t high, std::uint32_t low, std::false_type) const noexcept {
+	const T value = static_cast<T>(left_ + (right_ - left_) * detail::uniform_unit(high, low));
+	return value < right_ ? value : left_;
+  }
+
+private:
+  philox_engine engine_;
+  T left_, right_;
+};
+
+/**
+ * Normal distribution by the Box-Muller transform
+ */
+template<typename T>
+class normal_random {
+public:
+  static_assert(std::is_floating_point<T>::value, "normal_random is defined only for floating point types");
+
+  using result_type = T;
+
+  static constexpr std::size_t kValuesPerBlock = 2;
+
+public:
+  normal_random(std::uint64_t seed, T mean, T stddev, std::uint64_t stream = 0)
+	  : engine_(seed, stream), mean_(mean), stddev_(stddev) {
+	if (!(stddev >= T{}))
+	  throw std::logic_error("Can't make normal distribution with negative stddev");
+  }
+
+  void generate(std::uint64_t block, T (&values)[kValuesPerBlock]) const noexcept {
+	std::uint32_t bits[4];
+	engine_.block(block, bits);
+
+	const double radius = std::sqrt(-2.0 * std::log(1.0 - detail::uniform_unit(bits[0], bits[1])));
+	const double angle = 6.283185307179586476925 * detail::uniform_unit(bits[2], bits[3]);
+
+	values[0] = static_cast<T>(mean_ + stddev_ * radius * std::cos(angle));
+	values[1] = static_cast<T>(mean_ + stddev_ * radius * std::sin(angle));
+  }
+
+private:
+  philox_engine engine_;
+  T mean_, stddev_;
+};
+
+/**
+ * T(1) with probability p, T(0) otherwise
+ */
+template<typename T>
+class bernoulli_random {
+public:
+  using result_type = T;
+
+  static constexpr std::size_t kValuesPerBlock = 4;
+
+public:
+  bernoulli_random(std::uint64_t seed, double p, std::uint64_t stream = 0)
+	  : engine_(seed, stream), threshold_(static_cast<std::uint64_t>(std::ldexp(p, 32))) {
+	if (!(p >= 0.0 && p <= 1.0))
+	  throw std::logic_error("Can't make bernoulli distribution because p is not in [0, 1]");
+  }
+
+  void generate(std::uint64_t block, T (&values)[kValuesPerBlock]) const noexcept {
+	std::uint32_t bits[4];
+	engine_.block(block, bits);
+
+	for (std::size_t i = 0; i != kValuesPerBlock; ++i)
+	  values[i] = bits[i] < threshold_ ? T(1) : T(0);
+  }
+
+private:
+  philox_engine engine_;
+  std::uint64_t threshold_;
+};
+
+template<typename T>
+constexpr std::size_t uniform_random<T>::kValuesPerBlock;
+
+template<typename T>
+constexpr std::size_t normal_random<T>::kValuesPerBlock;
+
+template<typename T>
+constexpr std::size_t bernoulli_random<T>::kValuesPerBlock;
+
+namespace detail {
+
+/**
+ * Calls store(i, value) for i in [first, last) with the values of the distribution
+ */
+template<typename Distribution, typename Store>
+void random_range(const Distribution &distribution, std::size_t first, std::size_t last, Store store) {
+  constexpr std::size_t kValuesPerBlock = Distribution::kValuesPerBlock;
+  typename Distribution::result_type values[kValuesPerBlock];
+
+  while (first != last) {
+	const std::size_t block = first / kValuesPerBlock;
+	distribution.generate(block, values);
+
+	const std::size_t end = std::min(last, (block + 1) * kValuesPerBlock);
+	for (; first != end; ++first)
+	  store(first, values[first % kValuesPerBlock]);
+  }
+}
+
+} // namespace detail end
+
+} // namespace mtlt end
+
+#endif // MTLT_RANDOM_H_
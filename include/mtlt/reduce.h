@@ -0,0 +1,368 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Reduction kernels (sums, extrema, norms) over contiguous
+ *        storage shared by the matrix containers
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_REDUCE_H_
+#define MTLT_REDUCE_H_
+
+#include <cmath>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include <mtlt/parallel.h>
+#include <mtlt/matrix_config.h>
+
+namespace mtlt {
+
+/**
+ * Reductions of matrix::reduce_rows and matrix::reduce_cols,
+ * argmin and argmax give the position inside of the row or col
+ */
+enum class reduction {
+  sum,
+  mean,
+  min,
+  max,
+  argmin,
+  argmax,
+  norm
+};
+
+namespace detail {
+
+/**
+ * Leaf size of the pairwise summation, the leaf is summed in kSumLanes
+ * independent accumulators which the compiler keeps in vector registers
+ */
+constexpr std::size_t kPairwiseLeaf = 128;
+constexpr std::size_t kSumLanes = 8;
+
+/**
+ * Large reductions are cut into blocks of kReduceBlock elements, the partial
+ * results of the blocks are combined in the same order whatever the count of
+ * threads is, so the result does not depend on the machine
+ */
+constexpr std::size_t kReduceBlock = 1 << 14;
+constexpr std::size_t kParallelReduceMin = 1 << 20;
+
+struct plain_load {
+  template<typename T>
+  MATRIX_CXX17_CONSTEXPR const T &operator()(const T &value) const noexcept { return value; }
+};
+
+/**
+ * atomic_matrix elements are read with relaxed loads, a reduction running
+ * concurrently with writers sees some of the written values
+ */
+struct relaxed_load {
+  template<typename Atomic>
+  auto operator()(const Atomic &value) const noexcept -> decltype(value.load(std::memory_order_relaxed)) {
+	return value.load(std::memory_order_relaxed);
+  }
+};
+
+struct identity_transform {
+  template<typename T>
+  MATRIX_CXX17_CONSTEXPR const T &operator()(const T &value) const noexcept { return value; }
+};
+
+struct abs_transform {
+  double operator()(double value) const noexcept { return std::fabs(value); }
+};
+
+struct square_transform {
+  double operator()(double value) const noexcept { return value * value; }
+};
+
+struct less_compare {
+  template<typename T>
+  MATRIX_CXX17_CONSTEXPR bool operator()(const T &lhs, const T &rhs) const { return lhs < rhs; }
+};
+
+struct greater_compare {
+  template<typename T>
+  MATRIX_CXX17_CONSTEXPR bool operator()(const T &lhs, const T &rhs) const { return rhs < lhs; }
+};
+
+template<typename T>
+struct is_parallel_reducible : std::is_arithmetic<T> {};
+
+/**
+ * Floating point values are summed pairwise, the rounding error grows
+ * as O(log n) instead of O(n) of the sequential sum
+ */
+template<typename R, typename E, typename Load, typename Transform>
+MATRIX_CXX17_CONSTEXPR R pairwise_sum(const E *first, std::size_t count, Load load, Transform transform) {
+  if (count > kPairwiseLeaf) {
+	const std::size_t half = count / 2 / kSumLanes * kSumLanes;
+	return pairwise_sum<R>(first, half, load, transform) + pairwise_sum<R>(first + half, count - half, load, transform);
+  }
+
+  R lanes[kSumLanes]{};
+  std::size_t i = 0;
+  for (; i + kSumLanes <= count; i += kSumLanes)
+	for (std::size_t lane = 0; lane != kSumLanes; ++lane)
+	  lanes[lane] += static_cast<R>(transform(static_cast<R>(load(first[i + lane]))));
+
+  R sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+  for (; i != count; ++i)
+	sum += static_cast<R>(transform(static_cast<R>(load(first[i]))));
+
+  return sum;
+}
+
+template<typename R, typename E, typename Load, typename Transform>
+MATRIX_CXX17_CONSTEXPR R sum_range(const E *first, std::size_t count, Load load, Transform transform, std::true_type) {
+  return pairwise_sum<R>(first, count, load, transform);
+}
+
+/**
+ * Everything else is summed in order, so operator+ does not have to be associative
+ */
+template<typename R, typename E, typename Load, typename Transform>
+MATRIX_CXX17_CONSTEXPR R sum_range(const E *first, std::size_t count, Load load, Transform transform, std::false_type) {
+  R sum{};
+  for (std::size_t i = 0; i != count; ++i)
+	sum += transform(load(first[i]));
+  return sum;
+}
+
+template<typename R, typename E, typename Load = plain_load, typename Transform = identity_transform>
+MATRIX_CXX17_CONSTEXPR R sum_range(const E *first, std::size_t count, Load load = Load(), Transform transform = Transform()) {
+  return sum_range<R>(first, count, load, transform, std::is_floating_point<R>());
+}
+
+/**
+ * Count of threads for a reduction over count elements of type T
+ */
+template<typename T>
+std::size_t reduce_threads(std::size_t count) {
+  if (!is_parallel_reducible<T>::value || count < kParallelReduceMin)
+	return 1;
+
+  return std::min<std::size_t>(available_threads(), count / kReduceBlock);
+}
+
+template<typename R, typename E, typename Load = plain_load, typename Transform = identity_transform>
+R sum_elements(const E *first, std::size_t count, Load load = Load(), Transform transform = Transform()) {
+  const std::size_t threads = reduce_threads<R>(count);
+  if (count <= kReduceBlock || (threads == 1 && !std::is_floating_point<R>::value))
+	return sum_range<R>(first, count, load, transform);
+
+  const std::size_t blocks = (count + kReduceBlock - 1) / kReduceBlock;
+  std::vector<R> partial(blocks);
+
+  parallel_ranges(threads, count, kReduceBlock, [&](std::size_t, std::size_t begin, std::size_t end) {
+	for (std::size_t block = begin / kReduceBlock; begin != end; ++block, begin += std::min(kReduceBlock, end - begin))
+	  partial[block] = sum_range<R>(first + begin, std::min(kReduceBlock, end - begin), load, transform);
+  });
+
+  return sum_range<R>(partial.data(), blocks);
+}
+
+/**
+ * Index of the first smallest (Compare = std::less) or the first largest
+ * (Compare = std::greater) element, like std::min_element
+ */
+template<typename E, typename Load, typename Compare>
+MATRIX_CXX17_CONSTEXPR std::size_t extremum_range(const E *first, std::size_t count, Load load, Compare compare) {
+  std::size_t best = 0;
+  for (std::size_t i = 1; i < count; ++i)
+	if (compare(load(first[i]), load(first[best])))
+	  best = i;
+  return best;
+}
+
+template<typename T, typename E, typename Load, typename Compare>
+std::size_t extremum_index(const E *first, std::size_t count, Load load, Compare compare) {
+  const std::size_t threads = reduce_threads<T>(count);
+  if (threads == 1)
+	return extremum_range(first, count, load, compare);
+
+  std::vector<std::size_t> best(threads, count);
+  parallel_ranges(threads, count, kReduceBlock, [&](std::size_t task, std::size_t begin, std::size_t end) {
+	if (begin != end)
+	  best[task] = begin + extremum_range(first + begin, end - begin, load, compare);
+  });
+
+  std::size_t result = count;
+  for (std::size_t index : best)
+	if (index != count && (result == count || compare(load(first[index]), load(first[result]))))
+	  result = index;
+
+  return result;
+}
+
+/**
+ * Largest sum of |element| over the rows of a rows x cols block (infinity norm)
+ */
+template<typename E, typename Load>
+double max_row_abs_sum(const E *first, std::size_t rows, std::size_t cols, Load load) {
+  const std::size_t threads = reduce_threads<double>(rows * cols);
+  std::vector<double> row_sums(rows);
+
+  parallel_ranges(threads, rows * cols, cols == 0 ? 1 : cols, [&](std::size_t, std::size_t begin, std::size_t end) {
+	for (std::size_t row = begin / cols; begin != end; ++row, begin += cols)
+	  row_sums[row] = sum_range<double>(first + begin, cols, load, abs_transform());
+  });
+
+  return rows == 0 ? 0.0 : *std::max_element(row_sums.begin(), row_sums.end());
+}
+
+/**
+ * Largest sum of |element| over the cols of a rows x cols block (one norm),
+ * the block is walked row by row, every thread keeps its own column sums
+ */
+template<typename E, typename Load>
+double max_col_abs_sum(const E *first, std::size_t rows, std::size_t cols, Load load) {
+  const std::size_t threads = reduce_threads<double>(rows * cols);
+  std::vector<std::vector<double>> col_sums(threads, std::vector<double>(cols));
+
+  parallel_ranges(threads, rows * cols, cols == 0 ? 1 : cols, [&](std::size_t task, std::size_t begin, std::size_t end) {
+	double *sums = col_sums[task].data();
+	for (; begin != end; begin += cols)
+	  for (std::size_t col = 0; col != cols; ++col)
+		sums[col] += std::fabs(static_cast<double>(load(first[begin + col])));
+  });
+
+  double result = 0.0;
+  for (std::size_t col = 0; col != cols; ++col) {
+	double sum = 0.0;
+	for (std::size_t thread = 0; thread != threads; ++thread)
+	  sum += col_sums[thread][col];
+	result = std::max(result, sum);
+  }
+
+  return result;
+}
+
+/**
+ * Reduces every row of a rows x cols block, out has rows elements
+ */
+template<typename E, typename Load>
+void reduce_each_row(const E *first, std::size_t rows, std::size_t cols, reduction r, double *out, Load load) {
+  parallel_ranges(reduce_threads<double>(rows * cols), rows, 1, [&](std::size_t, std::size_t row, std::size_t last) {
+	for (const E *values = first + row * cols; row != last; ++row, values += cols) {
+	  switch (r) {
+		case reduction::sum:
+		  out[row] = sum_range<double>(values, cols, load);
+		  break;
+		case reduction::mean:
+		  out[row] = sum_range<double>(values, cols, load) / static_cast<double>(cols);
+		  break;
+		case reduction::norm:
+		  out[row] = std::sqrt(sum_range<double>(values, cols, load, square_transform()));
+		  break;
+		case reduction::min:
+		  out[row] = static_cast<double>(load(values[extremum_range(values, cols, load, less_compare())]));
+		  break;
+		case reduction::max:
+		  out[row] = static_cast<double>(load(values[extremum_range(values, cols, load, greater_compare())]));
+		  break;
+		case reduction::argmin:
+		  out[row] = static_cast<double>(extremum_range(values, cols, load, less_compare()));
+		  break;
+		case reduction::argmax:
+		  out[row] = static_cast<double>(extremum_range(values, cols, load, greater_compare()));
+		  break;
+	  }
+	}
+  });
+}
+
+template<typename E, typename Load, typename Transform>
+void accumulate_cols(const E *first, std::size_t rows, std::size_t cols, double *sums, Load load, Transform transform) {
+  for (std::size_t row = 0; row != rows; ++row, first += cols)
+	for (std::size_t col = 0; col != cols; ++col)
+	  sums[col] += transform(static_cast<double>(load(first[col])));
+}
+
+/**
+ * Reduces every col of a rows x cols block, out has cols elements
+ *
+ * The block is walked row by row, so the inner loop runs over contiguous
+ * memory, every thread reduces its rows into its own accumulators
+ */
+template<typename E, typename Load>
+void reduce_each_col(const E *first, std::size_t rows, std::size_t cols, reduction r, double *out, Load load) {
+  const bool extremum = r == reduction::min || r == reduction::max || r == reduction::argmin || r == reduction::argmax;
+  const bool greater = r == reduction::max || r == reduction::argmax;
+
+  const std::size_t threads = std::max<std::size_t>(1, std::min(reduce_threads<double>(rows * cols), rows));
+  std::vector<std::vector<double>> values(threads, std::vector<double>(cols));
+  std::vector<std::vector<std::size_t>> positions(extremum ? threads : 0, std::vector<std::size_t>(cols));
+
+  parallel_ranges(threads, rows, 1, [&](std::size_t task, std::size_t row, std::size_t last) {
+	double *accumulated = values[task].data();
+
+	if (!extremum) {
+	  if (r == reduction::norm)
+		accumulate_cols(first + row * cols, last - row, cols, accumulated, load, square_transform());
+	  else
+		accumulate_cols(first + row * cols, last - row, cols, accumulated, load, identity_transform());
+	  return;
+	}
+
+	std::size_t *position = positions[task].data();
+	for (std::size_t col = 0; row != last && col != cols; ++col) {
+	  accumulated[col] = static_cast<double>(load(first[row * cols + col]));
+	  position[col] = row;
+	}
+
+	for (++row; row < last; ++row)
+	  for (std::size_t col = 0; col != cols; ++col) {
+		const double value = static_cast<double>(load(first[row * cols + col]));
+		if (greater ? accumulated[col] < value : value < accumulated[col]) {
+		  accumulated[col] = value;
+		  position[col] = row;
+		}
+	  }
+  });
+
+  for (std::size_t col = 0; col != cols; ++col) {
+	if (!extremum) {
+	  double sum = 0.0;
+	  for (std::size_t task = 0; task != threads; ++task)
+		sum += values[task][col];
+
+	  out[col] = r == reduction::norm ? std::sqrt(sum) : r == reduction::mean ? sum / static_cast<double>(rows) : sum;
+	  continue;
+	}
+
+	// Tasks own increasing row ranges, the first of equal extrema is kept
+	std::size_t best = 0;
+	for (std::size_t task = 1; task != threads; ++task)
+	  if (greater ? values[best][col] < values[task][col] : values[task][col] < values[best][col])
+		best = task;
+
+	const bool position = r == reduction::argmin || r == reduction::argmax;
+	out[col] = position ? static_cast<double>(positions[best][col]) : values[best][col];
+  }
+}
+
+} // namespace detail end
+
+} // namespace mtlt end
+
+#endif // MTLT_REDUCE_H_
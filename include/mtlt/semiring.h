@@ -0,0 +1,174 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Semirings defining the addition and multiplication
+ *        of the generalized matrix product
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_SEMIRING_H_
+#define MTLT_SEMIRING_H_
+
+#include <limits>
+#include <type_traits>
+
+#include <mtlt/matrix_config.h>
+
+namespace mtlt {
+
+namespace detail {
+
+template<typename T>
+constexpr T positive_infinity(std::true_type) noexcept { return std::numeric_limits<T>::infinity(); }
+
+template<typename T>
+constexpr T positive_infinity(std::false_type) noexcept { return std::numeric_limits<T>::max(); }
+
+template<typename T>
+constexpr T negative_infinity(std::true_type) noexcept { return -std::numeric_limits<T>::infinity(); }
+
+template<typename T>
+constexpr T negative_infinity(std::false_type) noexcept { return std::numeric_limits<T>::lowest(); }
+
+/**
+ * The largest value of T, infinity when T has one
+ */
+template<typename T>
+constexpr T positive_infinity() noexcept {
+  return positive_infinity<T>(std::integral_constant<bool, std::numeric_limits<T>::has_infinity>());
+}
+
+template<typename T>
+constexpr T negative_infinity() noexcept {
+  return negative_infinity<T>(std::integral_constant<bool, std::numeric_limits<T>::has_infinity>());
+}
+
+/**
+ * a + b where the infinity absorbs the other operand,
+ * integers use max() or lowest() as the infinity and do not overflow on it
+ */
+template<typename T>
+constexpr T absorbing_add(const T &a, const T &b, const T &, std::true_type) noexcept {
+  return a + b;
+}
+
+template<typename T>
+constexpr T absorbing_add(const T &a, const T &b, const T &infinity, std::false_type) noexcept {
+  return (a == infinity) | (b == infinity) ? infinity : a + b;
+}
+
+template<typename T>
+constexpr T absorbing_add(const T &a, const T &b, const T &infinity) noexcept {
+  return absorbing_add(a, b, infinity, std::integral_constant<bool, std::numeric_limits<T>::has_infinity>());
+}
+
+} // namespace detail end
+
+/**
+ * Semirings of mtlt::matrix::mul<Semiring>: c(i, j) = add over k of mul(a(i, k), b(k, j)),
+ * starting from zero<T>()
+ *
+ * @code
+ *
+ * // edges holds max() where there is no edge
+ * mtlt::matrix<int> distances = edges;
+ * distances.mul<mtlt::semiring::min_plus>(edges); // Paths of at most two edges
+ *
+ * mtlt::matrix<int> reachable = adjacency.mul<mtlt::semiring::or_and>(adjacency);
+ *
+ * @endcode
+ */
+namespace semiring {
+
+/**
+ * The usual product
+ */
+struct plus_times {
+  template<typename T>
+  static constexpr T zero() noexcept { return T{}; }
+
+  template<typename T, typename U>
+  static constexpr T add(const T &c, const U &value) { return c + value; }
+
+  template<typename T, typename U>
+  static constexpr auto mul(const T &a, const U &b) -> decltype(a * b) { return a * b; }
+};
+
+/**
+ * Shortest paths: the lengths of the edges are added and the shortest
+ * path is chosen, the infinity (max() for integers) is no path
+ */
+struct min_plus {
+  template<typename T>
+  static constexpr T zero() noexcept { return detail::positive_infinity<T>(); }
+
+  template<typename T>
+  static constexpr T add(const T &c, const T &value) { return value < c ? value : c; }
+
+  template<typename T>
+  static constexpr T mul(const T &a, const T &b) { return detail::absorbing_add(a, b, detail::positive_infinity<T>()); }
+};
+
+/**
+ * Longest (critical) paths, the negative infinity (lowest() for integers) is no path
+ */
+struct max_plus {
+  template<typename T>
+  static constexpr T zero() noexcept { return detail::negative_infinity<T>(); }
+
+  template<typename T>
+  static constexpr T add(const T &c, const T &value) { return c < value ? value : c; }
+
+  template<typename T>
+  static constexpr T mul(const T &a, const T &b) { return detail::absorbing_add(a, b, detail::negative_infinity<T>()); }
+};
+
+/**
+ * Widest paths: the capacity of a path is its narrowest edge
+ * and the widest path is chosen
+ */
+struct max_min {
+  template<typename T>
+  static constexpr T zero() noexcept { return detail::negative_infinity<T>(); }
+
+  template<typename T>
+  static constexpr T add(const T &c, const T &value) { return c < value ? value : c; }
+
+  template<typename T>
+  static constexpr T mul(const T &a, const T &b) { return b < a ? b : a; }
+};
+
+/**
+ * Reachability, any nonzero element is true. The elements of the product are 0 or 1,
+ * the product is computed on rows packed into bits
+ */
+struct or_and {
+  template<typename T>
+  static constexpr T zero() noexcept { return T{}; }
+
+  template<typename T>
+  static constexpr T add(const T &c, const T &value) { return static_cast<T>(c != T{} || value != T{}); }
+
+  template<typename T, typename U>
+  static constexpr T mul(const T &a, const U &b) { return static_cast<T>(a != T{} && b != U{}); }
+};
+
+} // namespace semiring end
+
+} // namespace mtlt end
+
+#endif // MTLT_SEMIRING_H_
@@ -0,0 +1,416 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Binary serialization of matrix, static_matrix and atomic_matrix
+ *        to files and streams in the versioned MTLT binary format
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_SERIALIZATION_H_
+#define MTLT_SERIALIZATION_H_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include <mtlt/matrix.h>
+#include <mtlt/atomic_matrix.h>
+#include <mtlt/static_matrix.h>
+#include <mtlt/matrix_config.h>
+
+namespace mtlt {
+
+/**
+ * @enum dtype
+ *
+ * Element type tag stored in the binary header.
+ * Trivially copyable types without own tag are stored as dtype::opaque,
+ * for them only the element size is checked on load
+ */
+enum class dtype : std::uint8_t {
+  opaque = 0,
+  boolean = 1,
+  int8 = 2,
+  uint8 = 3,
+  int16 = 4,
+  uint16 = 5,
+  int32 = 6,
+  uint32 = 7,
+  int64 = 8,
+  uint64 = 9,
+  float32 = 10,
+  float64 = 11
+};
+
+/**
+ * @struct dtype_of
+ * Maps element type T to its dtype tag
+ */
+template<typename T>
+struct dtype_of : std::integral_constant<dtype,
+	std::is_same<T, bool>::value ? dtype::boolean :
+	std::is_integral<T>::value ?
+		(sizeof(T) == 1 ? (std::is_signed<T>::value ? dtype::int8 : dtype::uint8) :
+		 sizeof(T) == 2 ? (std::is_signed<T>::value ? dtype::int16 : dtype::uint16) :
+		 sizeof(T) == 4 ? (std::is_signed<T>::value ? dtype::int32 : dtype::uint32) :
+		 sizeof(T) == 8 ? (std::is_signed<T>::value ? dtype::int64 : dtype::uint64) : dtype::opaque) :
+	std::is_floating_point<T>::value ?
+		(sizeof(T) == 4 ? dtype::float32 : sizeof(T) == 8 ? dtype::float64 : dtype::opaque) :
+	dtype::opaque> {
+};
+
+/**
+ * @struct matrix_binary_settings
+ *
+ * checksum - store FNV-1a checksum of the payload in the header
+ * and verify it on load, costs one extra pass over the elements
+ */
+struct matrix_binary_settings {
+  bool checksum = false;
+};
+
+/**
+ * @struct binary_header
+ *
+ * Decoded header of the MTLT binary format. On disk the header takes
+ * binary_header::kSize bytes, the elements follow right after it
+ * in row major order and in the byte order of the writer
+ *
+ * offset  size  field
+ *      0     4  magic "MTLT"
+ *      4     2  version
+ *      6     1  dtype
+ *      7     1  flags: bit 0 - big endian, bit 1 - checksum present
+ *      8     4  element size in bytes
+ *     12     4  header size in bytes
+ *     16     8  rows
+ *     24     8  cols
+ *     32     8  checksum
+ *     40    24  reserved, zero
+ */
+struct binary_header {
+  static constexpr std::uint16_t kVersion = 1;
+  static constexpr std::uint32_t kSize = 64;
+  static constexpr std::uint8_t kBigEndianFlag = 1;
+  static constexpr std::uint8_t kChecksumFlag = 2;
+
+  std::uint16_t version = kVersion;
+  dtype type = dtype::opaque;
+  std::uint8_t flags = 0;
+  std::uint32_t element_size = 0;
+  std::uint32_t header_size = kSize;
+  std::uint64_t rows = 0;
+  std::uint64_t cols = 0;
+  std::uint64_t checksum = 0;
+
+  MATRIX_CXX17_NODISCARD
+  bool big_endian() const noexcept { return (flags & kBigEndianFlag) != 0; }
+
+  MATRIX_CXX17_NODISCARD
+  bool has_checksum() const noexcept { return (flags & kChecksumFlag) != 0; }
+
+  MATRIX_CXX17_NODISCARD
+  std::uint64_t payload_size() const noexcept { return rows * cols * element_size; }
+};
+
+namespace detail {
+
+inline bool is_big_endian() noexcept {
+  const std::uint16_t probe = 1;
+  unsigned char first;
+  std::memcpy(&first, &probe, 1);
+  return first == 0;
+}
+
+inline void byte_swap(void *value, std::size_t size) noexcept {
+  auto bytes = static_cast<unsigned char *>(value);
+  std::reverse(bytes, bytes + size);
+}
+
+template<typename Integer>
+inline Integer byte_swapped(Integer value) noexcept {
+  byte_swap(&value, sizeof(value));
+  return value;
+}
+
+/**
+ * FNV-1a over 64 bit words of the payload, the tail is hashed by bytes.
+ * Words are taken in the byte order of the writer
+ */
+inline std::uint64_t checksum(const void *data, std::size_t size, bool swap_words = false) noexcept {
+  const std::uint64_t kPrime = 1099511628211ULL;
+  std::uint64_t hash = 14695981039346656037ULL;
+
+  auto bytes = static_cast<const unsigned char *>(data);
+  const std::size_t words = size / sizeof(std::uint64_t);
+
+  for (std::size_t i = 0; i != words; ++i) {
+	std::uint64_t word;
+	std::memcpy(&word, bytes + i * sizeof(word), sizeof(word));
+	hash = (hash ^ (swap_words ? byte_swapped(word) : word)) * kPrime;
+  }
+
+  for (std::size_t i = words * sizeof(std::uint64_t); i != size; ++i)
+	hash = (hash ^ bytes[i]) * kPrime;
+
+  return hash;
+}
+
+template<typename T>
+binary_header make_header(std::size_t rows, std::size_t cols, matrix_binary_settings settings) {
+  binary_header header;
+  header.type = dtype_of<T>::value;
+  header.element_size = sizeof(T);
+  header.rows = rows;
+  header.cols = cols;
+  header.flags = is_big_endian() ? binary_header::kBigEndianFlag : 0;
+
+  if (settings.checksum)
+	header.flags |= binary_header::kChecksumFlag;
+
+  return header;
+}
+
+template<typename Integer>
+inline void put(char *buffer, std::size_t offset, Integer value) noexcept {
+  std::memcpy(buffer + offset, &value, sizeof(value));
+}
+
+template<typename Integer>
+inline Integer get(const char *buffer, std::size_t offset, bool swap) noexcept {
+  Integer value;
+  std::memcpy(&value, buffer + offset, sizeof(value));
+  return swap ? byte_swapped(value) : value;
+}
+
+inline void encode_header(const binary_header &header, char (&buffer)[binary_header::kSize]) noexcept {
+  std::memset(buffer, 0, sizeof(buffer));
+  std::memcpy(buffer, "MTLT", 4);
+  put(buffer, 4, header.version);
+  put(buffer, 6, static_cast<std::uint8_t>(header.type));
+  put(buffer, 7, header.flags);
+  put(buffer, 8, header.element_size);
+  put(buffer, 12, header.header_size);
+  put(buffer, 16, header.rows);
+  put(buffer, 24, header.cols);
+  put(buffer, 32, header.checksum);
+}
+
+inline binary_header decode_header(const char (&buffer)[binary_header::kSize]) {
+  if (std::memcmp(buffer, "MTLT", 4) != 0)
+	throw std::runtime_error("Can't read matrix because stream is not in MTLT binary format");
+
+  binary_header header;
+  header.flags = get<std::uint8_t>(buffer, 7, false);
+
+  const bool swap = header.big_endian() != is_big_endian();
+  header.version = get<std::uint16_t>(buffer, 4, swap);
+  header.type = static_cast<dtype>(get<std::uint8_t>(buffer, 6, false));
+  header.element_size = get<std::uint32_t>(buffer, 8, swap);
+  header.header_size = get<std::uint32_t>(buffer, 12, swap);
+  header.rows = get<std::uint64_t>(buffer, 16, swap);
+  header.cols = get<std::uint64_t>(buffer, 24, swap);
+  header.checksum = get<std::uint64_t>(buffer, 32, swap);
+
+  if (header.version > binary_header::kVersion)
+	throw std::runtime_error("Can't read matrix because binary format version is newer than supported");
+
+  if (header.header_size < binary_header::kSize)
+	throw std::runtime_error("Can't read matrix because binary header is corrupted");
+
+  return header;
+}
+
+/**
+ * Header and payload are handed to the stream back to back, so a file stream
+ * passes a large payload to the OS in a single write together with the header
+ */
+inline void write_binary(std::ostream &os, binary_header header, const void *data) {
+  const std::size_t size = header.payload_size();
+
+  if (header.has_checksum())
+	header.checksum = checksum(data, size);
+
+  char buffer[binary_header::kSize];
+  encode_header(header, buffer);
+
+  os.write(buffer, sizeof(buffer));
+  os.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+
+  if (!os)
+	throw std::runtime_error("Can't write matrix to stream");
+}
+
+inline binary_header read_binary_header(std::istream &is) {
+  char buffer[binary_header::kSize];
+  if (!is.read(buffer, sizeof(buffer)))
+	throw std::runtime_error("Can't read matrix header from stream");
+
+  binary_header header = decode_header(buffer);
+  is.ignore(header.header_size - binary_header::kSize);
+
+  return header;
+}
+
+template<typename T>
+void check_header(const binary_header &header) {
+  if (header.element_size != sizeof(T) || header.type != dtype_of<T>::value)
+	throw std::logic_error("Can't read matrix because stored element type differs from matrix value_type");
+}
+
+template<typename T>
+void read_binary_payload(std::istream &is, const binary_header &header, T *data) {
+  const std::size_t size = header.payload_size();
+  if (!is.read(reinterpret_cast<char *>(data), static_cast<std::streamsize>(size)))
+	throw std::runtime_error("Can't read matrix elements from stream");
+
+  const bool swap = header.big_endian() != is_big_endian();
+
+  if (header.has_checksum() && checksum(data, size, swap) != header.checksum)
+	throw std::runtime_error("Can't read matrix because checksum doesn't match");
+
+  if (swap && sizeof(T) > 1)
+	for (std::size_t i = 0, count = header.rows * header.cols; i != count; ++i)
+	  byte_swap(data + i, sizeof(T));
+}
+
+inline std::ofstream open_binary_output(const std::string &path) {
+  std::ofstream os(path, std::ios::binary | std::ios::trunc);
+  if (!os.is_open())
+	throw std::runtime_error("Can't open file " + path + " for writing");
+  return os;
+}
+
+inline std::ifstream open_binary_input(const std::string &path) {
+  std::ifstream is(path, std::ios::binary);
+  if (!is.is_open())
+	throw std::runtime_error("Can't open file " + path + " for reading");
+  return is;
+}
+
+} // namespace detail end
+
+template<typename T>
+void save(std::ostream &os, const matrix<T> &m, matrix_binary_settings settings = matrix_binary_settings{}) {
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to be saved in binary format");
+
+  detail::write_binary(os, detail::make_header<T>(m.rows(), m.cols(), settings), m.data());
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+void save(std::ostream &os, const static_matrix<T, Rows, Cols> &m,
+		  matrix_binary_settings settings = matrix_binary_settings{}) {
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to be saved in binary format");
+
+  detail::write_binary(os, detail::make_header<T>(Rows, Cols, settings), m.data());
+}
+
+/**
+ * Atomic elements are loaded one by one into a snapshot buffer
+ * which is then written as a plain matrix of T
+ */
+template<typename T, template<typename> class Atomic>
+void save(std::ostream &os, const atomic_matrix<T, Atomic> &m,
+		  matrix_binary_settings settings = matrix_binary_settings{}) {
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to be saved in binary format");
+
+  std::vector<T> snapshot(m.begin(), m.end());
+  detail::write_binary(os, detail::make_header<T>(m.rows(), m.cols(), settings), snapshot.data());
+}
+
+template<typename T>
+void load(std::istream &is, matrix<T> &m) {
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to be loaded from binary format");
+
+  const binary_header header = detail::read_binary_header(is);
+  detail::check_header<T>(header);
+
+  matrix<T> loaded(header.rows, header.cols);
+  detail::read_binary_payload(is, header, loaded.data());
+  m = std::move(loaded);
+}
+
+template<typename T, std::size_t Rows, std::size_t Cols>
+void load(std::istream &is, static_matrix<T, Rows, Cols> &m) {
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to be loaded from binary format");
+
+  const binary_header header = detail::read_binary_header(is);
+  detail::check_header<T>(header);
+
+  if (header.rows != Rows || header.cols != Cols)
+	throw std::logic_error("Can't read static_matrix because stored rows or cols differ from Rows or Cols");
+
+  static_matrix<T, Rows, Cols> loaded;
+  detail::read_binary_payload(is, header, loaded.data());
+  m = loaded;
+}
+
+template<typename T, template<typename> class Atomic>
+void load(std::istream &is, atomic_matrix<T, Atomic> &m) {
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to be loaded from binary format");
+
+  const binary_header header = detail::read_binary_header(is);
+  detail::check_header<T>(header);
+
+  std::vector<T> snapshot(header.rows * header.cols);
+  detail::read_binary_payload(is, header, snapshot.data());
+  m = atomic_matrix<T, Atomic>(header.rows, header.cols, snapshot);
+}
+
+template<typename Matrix>
+void save(const Matrix &m, const std::string &path, matrix_binary_settings settings = matrix_binary_settings{}) {
+  std::ofstream os = detail::open_binary_output(path);
+  save(os, m, settings);
+}
+
+template<typename Matrix>
+void load(const std::string &path, Matrix &m) {
+  std::ifstream is = detail::open_binary_input(path);
+  load(is, m);
+}
+
+/**
+ * @code
+ *
+ * mtlt::save(matrix, "checkpoint.mtlt");
+ * auto restored = mtlt::load<mtlt::matrix<double>>("checkpoint.mtlt");
+ *
+ * @endcode
+ */
+template<typename Matrix>
+Matrix load(const std::string &path) {
+  Matrix m;
+  load(path, m);
+  return m;
+}
+
+template<typename Matrix>
+Matrix load(std::istream &is) {
+  Matrix m;
+  load(is, m);
+  return m;
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_SERIALIZATION_H_
@@ -0,0 +1,300 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        The sparse_matrix container class stores only non zero
+ *        elements in compressed sparse row (CSR) form
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_SPARSE_MATRIX_H_
+#define MTLT_SPARSE_MATRIX_H_
+
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <mtlt/matrix.h>
+#include <mtlt/matrix_config.h>
+
+namespace mtlt {
+
+/**
+ * @class sparse_matrix
+ *
+ * rows x cols matrix that keeps only the stored (non zero) elements.
+ * Elements of row i are values()[row_offsets()[i] .. row_offsets()[i + 1]),
+ * their columns are in col_indices() in ascending order
+ *
+ * @code
+ *
+ * mtlt::sparse_matrix<double> s(1000, 1000, {
+ *     {0, 0, 4.0},
+ *     {10, 999, -1.0}
+ * });
+ *
+ * mtlt::matrix<double> y = s.mul(x); // SpMM, work is proportional to nonzeros()
+ *
+ * @endcode
+ */
+template<typename T>
+class sparse_matrix final {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  /**
+   * @struct entry
+   * Coordinate (COO) form of a stored element
+   */
+  struct entry {
+	size_type row;
+	size_type col;
+	value_type value;
+  };
+
+public:
+  sparse_matrix() = default;
+
+  sparse_matrix(size_type rows, size_type cols)
+	  : rows_(rows), cols_(cols), row_offsets_(rows + 1) {}
+
+  /**
+   * Builds CSR from entries in any order, values of duplicated
+   * coordinates are summed. Throws std::out_of_range for an entry
+   * outside of rows x cols
+   */
+  sparse_matrix(size_type rows, size_type cols, std::vector<entry> entries)
+	  : sparse_matrix(rows, cols) {
+	for (const entry &e : entries)
+	  if (e.row >= rows_ || e.col >= cols_)
+		throw std::out_of_range("sparse matrix entry is out of range of matrix");
+
+	std::sort(entries.begin(), entries.end(), [](const entry &lhs, const entry &rhs) {
+	  return lhs.row != rhs.row ? lhs.row < rhs.row : lhs.col < rhs.col;
+	});
+
+	col_indices_.reserve(entries.size());
+	values_.reserve(entries.size());
+
+	for (size_type i = 0; i != entries.size(); ++i) {
+	  const entry &e = entries[i];
+
+	  if (i != 0 && e.row == entries[i - 1].row && e.col == entries[i - 1].col) {
+		values_.back() += e.value;
+		continue;
+	  }
+
+	  col_indices_.push_back(e.col);
+	  values_.push_back(e.value);
+	  ++row_offsets_[e.row + 1];
+	}
+
+	for (size_type row = 0; row != rows_; ++row)
+	  row_offsets_[row + 1] += row_offsets_[row];
+  }
+
+  /**
+   * Keeps only the non zero elements of a dense matrix
+   */
+  explicit sparse_matrix(const matrix<T> &dense)
+	  : sparse_matrix(dense.rows(), dense.cols()) {
+	for (size_type row = 0; row != rows_; ++row) {
+	  for (size_type col = 0; col != cols_; ++col) {
+		if (dense(row, col) != value_type{}) {
+		  col_indices_.push_back(col);
+		  values_.push_back(dense(row, col));
+		}
+	  }
+	  row_offsets_[row + 1] = values_.size();
+	}
+  }
+
+public:
+  /**
+   * Returns the stored element or zero, binary search in the row
+   */
+  value_type operator()(size_type row, size_type col) const {
+	const auto first = col_indices_.begin() + static_cast<std::ptrdiff_t>(row_offsets_[row]);
+	const auto last = col_indices_.begin() + static_cast<std::ptrdiff_t>(row_offsets_[row + 1]);
+	const auto found = std::lower_bound(first, last, col);
+
+	return found != last && *found == col ? values_[static_cast<size_type>(found - col_indices_.begin())] : value_type{};
+  }
+
+  value_type at(size_type row, size_type col) const {
+	if (row >= rows_ || col >= cols_)
+	  throw std::out_of_range("row or col is out of range of matrix");
+
+	return (*this)(row, col);
+  }
+
+  MATRIX_CXX17_NODISCARD
+  size_type rows() const noexcept { return rows_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type cols() const noexcept { return cols_; }
+
+  /**
+   * Count of stored elements
+   */
+  MATRIX_CXX17_NODISCARD
+  size_type nonzeros() const noexcept { return values_.size(); }
+
+  MATRIX_CXX17_NODISCARD
+  const std::vector<size_type> &row_offsets() const noexcept { return row_offsets_; }
+
+  MATRIX_CXX17_NODISCARD
+  const std::vector<size_type> &col_indices() const noexcept { return col_indices_; }
+
+  MATRIX_CXX17_NODISCARD
+  const std::vector<value_type> &values() const noexcept { return values_; }
+
+  MATRIX_CXX17_NODISCARD
+  std::vector<value_type> &values() noexcept { return values_; }
+
+  /**
+   * Stored elements in coordinate form, row by row
+   */
+  std::vector<entry> entries() const {
+	std::vector<entry> coordinates;
+	coordinates.reserve(nonzeros());
+
+	for (size_type row = 0; row != rows_; ++row)
+	  for (size_type i = row_offsets_[row]; i != row_offsets_[row + 1]; ++i)
+		coordinates.push_back(entry{row, col_indices_[i], values_[i]});
+
+	return coordinates;
+  }
+
+public:
+  void print(std::ostream &os = std::cout, matrix_debug_settings s = matrix_debug_settings{}) const {
+	for (size_type row = 0; row != rows_; ++row) {
+	  for (size_type col = 0; col != cols_; ++col) {
+		os << std::setw(s.width)
+		   << std::setprecision(s.precision)
+		   << (*this)(row, col)
+		   << s.separator;
+	  }
+	  os << s.end;
+	}
+
+	if (s.is_double_end)
+	  os << s.end;
+  }
+
+  matrix<T> to_matrix() const {
+	matrix<T> dense(rows_, cols_);
+
+	for (size_type row = 0; row != rows_; ++row)
+	  for (size_type i = row_offsets_[row]; i != row_offsets_[row + 1]; ++i)
+		dense(row, col_indices_[i]) = values_[i];
+
+	return dense;
+  }
+
+  /**
+   * SpMM: returns this * rhs
+   */
+  matrix<T> mul(const matrix<T> &rhs) const {
+	if (cols_ != rhs.rows())
+	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
+
+	const size_type cols = rhs.cols();
+	matrix<T> multiplied(rows_, cols);
+
+	for (size_type row = 0; row != rows_; ++row) {
+	  for (size_type i = row_offsets_[row]; i != row_offsets_[row + 1]; ++i) {
+		const value_type a = values_[i];
+		const size_type k = col_indices_[i];
+
+		for (size_type col = 0; col != cols; ++col)
+		  multiplied(row, col) += a * rhs(k, col);
+	  }
+	}
+
+	return multiplied;
+  }
+
+  sparse_matrix &mul(const value_type &number) {
+	for (value_type &value : values_)
+	  value *= number;
+	return *this;
+  }
+
+  sparse_matrix transpose() const {
+	sparse_matrix transposed(cols_, rows_);
+	transposed.col_indices_.resize(nonzeros());
+	transposed.values_.resize(nonzeros());
+
+	for (size_type col : col_indices_)
+	  ++transposed.row_offsets_[col + 1];
+
+	for (size_type col = 0; col != cols_; ++col)
+	  transposed.row_offsets_[col + 1] += transposed.row_offsets_[col];
+
+	std::vector<size_type> next(transposed.row_offsets_.begin(), transposed.row_offsets_.end() - 1);
+	for (size_type row = 0; row != rows_; ++row) {
+	  for (size_type i = row_offsets_[row]; i != row_offsets_[row + 1]; ++i) {
+		const size_type position = next[col_indices_[i]]++;
+		transposed.col_indices_[position] = row;
+		transposed.values_[position] = values_[i];
+	  }
+	}
+
+	return transposed;
+  }
+
+  template<typename EqualCompare = std::equal_to<value_type>>
+  bool equal_to(const sparse_matrix &rhs) const {
+	return rows_ == rhs.rows_ && cols_ == rhs.cols_
+		&& row_offsets_ == rhs.row_offsets_ && col_indices_ == rhs.col_indices_
+		&& std::equal(values_.begin(), values_.end(), rhs.values_.begin(), EqualCompare());
+  }
+
+private:
+  size_type rows_{}, cols_{};
+  std::vector<size_type> row_offsets_ = std::vector<size_type>(1);
+  std::vector<size_type> col_indices_;
+  std::vector<value_type> values_;
+};
+
+template<typename T>
+std::ostream &operator<<(std::ostream &out, const sparse_matrix<T> &rhs) {
+  rhs.print(out);
+  return out;
+}
+
+template<typename T>
+matrix<T> inline operator*(const sparse_matrix<T> &lhs, const matrix<T> &rhs) {
+  return lhs.mul(rhs);
+}
+
+template<typename T>
+bool inline operator==(const sparse_matrix<T> &lhs, const sparse_matrix<T> &rhs) {
+  return lhs.equal_to(rhs);
+}
+
+template<typename T>
+bool inline operator!=(const sparse_matrix<T> &lhs, const sparse_matrix<T> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_SPARSE_MATRIX_H_
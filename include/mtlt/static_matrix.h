@@ -32,14 +32,20 @@
 #include <numeric>
 #include <iostream>
 #include <algorithm>
+#include <utility>
+#include <functional>
 #include <type_traits>
 
 #if __cplusplus > 201703L
 #include <concepts>
 #endif
 
+#include <mtlt/reduce.h>
+#include <mtlt/random.h>
+#include <mtlt/compare.h>
 #include <mtlt/matrix_config.h>
 #include <mtlt/matrix_type_traits.h>
+#include <mtlt/instrumentation.h>
 #include <mtlt/matrix_normal_iterator.h>
 #include <mtlt/matrix_reverse_iterator.h>
 
@@ -126,7 +132,7 @@ public:
 	if (Rows * Cols != container.size())
 	  throw std::logic_error("container has more/less items than in matrix");
 
-	std::copy(container.begin(), container.end(), begin());
+	std::copy(container.begin(), container.end(), data_);
   }
 
   template<typename Container> requires(std::convertible_to<typename Container::value_type, T>)
@@ -134,7 +140,7 @@ public:
 	if (Rows * Cols != container.size())
 	  throw std::logic_error("");
 
-	std::copy(container.begin(), container.end(), begin());
+	std::copy(container.begin(), container.end(), data_);
   }
 #else
   template<typename Container,
@@ -147,7 +153,7 @@ public:
 	if (Rows * Cols != container.size())
 	  throw std::logic_error("container has more/less items than in matrix");
 
-	std::copy(container.begin(), container.end(), begin());
+	std::copy(container.begin(), container.end(), data_);
   }
 
   template<typename Container,
@@ -160,7 +166,7 @@ public:
 	if (Rows * Cols != container.size())
 	  throw std::logic_error("container has more/less items than in matrix");
 
-	std::copy(container.begin(), container.end(), begin());
+	std::copy(container.begin(), container.end(), data_);
   }
 #endif // C++ <= 201703L
 
@@ -259,6 +265,12 @@ public:
   MATRIX_CXX17_CONSTEXPR
   size_type size() const noexcept { return rows_ * cols_; }
 
+  MATRIX_CXX17_CONSTEXPR
+  pointer data() noexcept { return data_; }
+
+  MATRIX_CXX17_CONSTEXPR
+  const_pointer data() const noexcept { return data_; }
+
 public:
   void print(std::ostream &os = std::cout, matrix_debug_settings s = matrix_debug_settings{}) const {
 	int width = s.width, precision = s.precision;
@@ -294,22 +306,22 @@ public:
   }
 
   static_matrix &fill(const value_type &v) {
-	std::fill(begin(), end(), v);
+	MTLT_COUNT_OPERATION(operation::fill, Rows, Cols, 0, 0, Rows * Cols * sizeof(value_type));
+
+	std::fill(data_, data_ + Rows * Cols, v);
 	return *this;
   }
 
   static_matrix &fill_random(const value_type &left, const value_type &right) {
-	using namespace std::chrono;
-
-	std::default_random_engine re(system_clock::now().time_since_epoch().count());
-	auto distribution = typename std::conditional<std::is_integral<T>::value,
-												  std::uniform_int_distribution<T>,
-												  std::uniform_real_distribution<T>>::type(left, right);
-
-	generate([&]() {
-	  return distribution(re);
-	});
+	return fill_random(uniform_random<value_type>(detail::random_seed(), left, right));
+  }
 
+  /**
+   * Fills the matrix with a distribution of mtlt/random.h, see matrix::fill_random
+   */
+  template<typename Distribution>
+  static_matrix &fill_random(const Distribution &distribution) {
+	detail::random_range(distribution, 0, Rows * Cols, [this](size_type i, const value_type &value) { data_[i] = value; });
 	return *this;
   }
 
@@ -390,21 +402,29 @@ public:
   }
 
   static_matrix &mul(const value_type &value) {
+	MTLT_COUNT_OPERATION(operation::mul_by_number, Rows, Cols, Rows * Cols, Rows * Cols * sizeof(value_type), Rows * Cols * sizeof(value_type));
+
 	transform([&value](const value_type &item) { return item * value; });
 	return *this;
   }
 
   static_matrix &add(const value_type &value) {
+	MTLT_COUNT_OPERATION(operation::add, Rows, Cols, Rows * Cols, Rows * Cols * sizeof(value_type), Rows * Cols * sizeof(value_type));
+
 	transform([&value](const value_type &item) { return item + value; });
 	return *this;
   }
 
   static_matrix &sub(const value_type &value) {
+	MTLT_COUNT_OPERATION(operation::sub, Rows, Cols, Rows * Cols, Rows * Cols * sizeof(value_type), Rows * Cols * sizeof(value_type));
+
 	transform([&value](const value_type &item) { return item - value; });
 	return *this;
   }
 
   static_matrix &div(const value_type &value) {
+	MTLT_COUNT_OPERATION(operation::div_by_number, Rows, Cols, Rows * Cols, Rows * Cols * sizeof(value_type), Rows * Cols * sizeof(value_type));
+
 	transform([&value](const value_type &item) { return item / value; });
 	return *this;
   }
@@ -418,6 +438,8 @@ public:
   MATRIX_CXX17_CONSTEXPR static_matrix<T, Rows, Cols2> mul(const static_matrix<U, Rows2, Cols2> &rhs) const {
 	static_assert(is_non_zero_dimension<Rows2, Cols2>::value && std::is_convertible<U, T>::value && Cols == Rows2);
 #endif // C++ <= 201703L
+	MTLT_COUNT_OPERATION(operation::mul, Rows, Cols2, 2 * Rows * Cols * Cols2, (Rows * Cols + Rows2 * Cols2) * sizeof(value_type), Rows * Cols2 * sizeof(value_type));
+
 	static_matrix<T, Rows, Cols2> multiplied;
 
 	for (size_type row = 0; row != Rows; ++row)
@@ -437,6 +459,8 @@ public:
   static_matrix<T, Rows, Cols> add(const static_matrix<U, Rows, Cols> &rhs) const {
 	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
 #endif // C++ <= 201703L
+	MTLT_COUNT_OPERATION(operation::add, Rows, Cols, Rows * Cols, 2 * Rows * Cols * sizeof(value_type), Rows * Cols * sizeof(value_type));
+
 	static_matrix<T, Rows, Cols> addition;
 
 	for (size_type row = 0; row != Rows; ++row)
@@ -455,6 +479,8 @@ public:
   static_matrix<T, Rows, Cols> sub(const static_matrix<U, Rows, Cols> &rhs) const {
 	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
 #endif // C++ <= 201703L
+	MTLT_COUNT_OPERATION(operation::sub, Rows, Cols, Rows * Cols, 2 * Rows * Cols * sizeof(value_type), Rows * Cols * sizeof(value_type));
+
 	static_matrix<T, Rows, Cols> substraction;
 
 	for (size_type row = 0; row != Rows; ++row)
@@ -491,6 +517,8 @@ public:
   static_matrix<T, Rows, Cols> mul_by_element(const static_matrix<U, Rows, Cols> &rhs) const {
 	static_assert(std::is_convertible<U, T>::value, "U must be convertible to T");
 #endif // C++ <= 201703L
+	MTLT_COUNT_OPERATION(operation::mul_by_element, Rows, Cols, Rows * Cols, 2 * Rows * Cols * sizeof(value_type), Rows * Cols * sizeof(value_type));
+
 	static_matrix<T, Rows, Cols> multpipled;
 
 	for (size_type row = 0; row != Rows; ++row)
@@ -502,13 +530,54 @@ public:
 
   MATRIX_CXX17_CONSTEXPR
   value_type sum() const {
-	return std::accumulate(begin(), end(), value_type{});
+	MTLT_COUNT_OPERATION(operation::sum, Rows, Cols, Rows * Cols, Rows * Cols * sizeof(value_type), 0);
+
+	return detail::sum_range<value_type>(data_, Rows * Cols);
+  }
+
+  MATRIX_CXX17_CONSTEXPR
+  double mean() const {
+	MTLT_COUNT_OPERATION(operation::sum, Rows, Cols, Rows * Cols, Rows * Cols * sizeof(value_type), 0);
+
+	return detail::sum_range<double>(data_, Rows * Cols) / static_cast<double>(Rows * Cols);
+  }
+
+  MATRIX_CXX17_CONSTEXPR
+  value_type min() const { return data_[detail::extremum_range(data_, Rows * Cols, detail::plain_load(), std::less<value_type>())]; }
+
+  MATRIX_CXX17_CONSTEXPR
+  value_type max() const { return data_[detail::extremum_range(data_, Rows * Cols, detail::plain_load(), std::greater<value_type>())]; }
+
+  MATRIX_CXX17_CONSTEXPR
+  std::pair<size_type, size_type> argmin() const {
+	const size_type index = detail::extremum_range(data_, Rows * Cols, detail::plain_load(), std::less<value_type>());
+	return std::make_pair(index / Cols, index % Cols);
+  }
+
+  MATRIX_CXX17_CONSTEXPR
+  std::pair<size_type, size_type> argmax() const {
+	const size_type index = detail::extremum_range(data_, Rows * Cols, detail::plain_load(), std::greater<value_type>());
+	return std::make_pair(index / Cols, index % Cols);
+  }
+
+  double frobenius_norm() const {
+	return std::sqrt(detail::sum_range<double>(data_, Rows * Cols, detail::plain_load(), detail::square_transform()));
+  }
+
+  double l1_norm() const {
+	return detail::max_col_abs_sum(data_, Rows, Cols, detail::plain_load());
+  }
+
+  double linf_norm() const {
+	return detail::max_row_abs_sum(data_, Rows, Cols, detail::plain_load());
   }
 
 public:
   template<std::size_t Cols2>
   MATRIX_CXX17_CONSTEXPR
   static_matrix<T, Rows, Cols + Cols2> join_right(const static_matrix<T, Rows, Cols2> &rhs) {
+	MTLT_COUNT_OPERATION(operation::join, Rows, Cols, 0, (Rows * Cols + Rows * Cols2) * sizeof(value_type), (Rows * Cols + Rows * Cols2) * sizeof(value_type));
+
 	static_matrix<T, Rows, Cols + Cols2> join_matrix;
 
 	for (size_type row = 0; row != join_matrix.rows(); ++row)
@@ -525,6 +594,8 @@ public:
   template<std::size_t Cols2>
   MATRIX_CXX17_CONSTEXPR
   static_matrix<T, Rows, Cols + Cols2> join_left(const static_matrix<T, Rows, Cols2> &rhs) {
+	MTLT_COUNT_OPERATION(operation::join, Rows, Cols, 0, (Rows * Cols + Rows * Cols2) * sizeof(value_type), (Rows * Cols + Rows * Cols2) * sizeof(value_type));
+
 	static_matrix<T, Rows, Cols + Cols2> join_matrix;
 
 	for (size_type row = 0; row != join_matrix.rows(); ++row)
@@ -541,6 +612,8 @@ public:
   template<std::size_t Rows2>
   MATRIX_CXX17_CONSTEXPR
   static_matrix<T, Rows + Rows2, Cols> join_top(const static_matrix<T, Rows2, Cols> &rhs) {
+	MTLT_COUNT_OPERATION(operation::join, Rows, Cols, 0, (Rows * Cols + Rows2 * Cols) * sizeof(value_type), (Rows * Cols + Rows2 * Cols) * sizeof(value_type));
+
 	static_matrix<T, Rows + Rows2, Cols> join_matrix;
 
 	for (size_type row = 0; row != join_matrix.rows(); ++row)
@@ -557,6 +630,8 @@ public:
   template<std::size_t Rows2>
   MATRIX_CXX17_CONSTEXPR
   static_matrix<T, Rows + Rows2, Cols> join_bottom(const static_matrix<T, Rows2, Cols> &rhs) {
+	MTLT_COUNT_OPERATION(operation::join, Rows, Cols, 0, (Rows * Cols + Rows2 * Cols) * sizeof(value_type), (Rows * Cols + Rows2 * Cols) * sizeof(value_type));
+
 	static_matrix<T, Rows + Rows2, Cols> join_matrix;
 
 	for (size_type row = 0; row != join_matrix.rows(); ++row)
@@ -573,6 +648,8 @@ public:
 public:
   MATRIX_CXX17_CONSTEXPR
   static_matrix<T, Cols, Rows> transpose() const {
+	MTLT_COUNT_OPERATION(operation::transpose, Rows, Cols, 0, Rows * Cols * sizeof(value_type), Rows * Cols * sizeof(value_type));
+
 	static_matrix<T, Cols, Rows> transposed;
 
 	for (size_type row = 0; row != rows_; ++row)
@@ -646,6 +723,8 @@ public:
   double determinant_gaussian() const {
 	static_assert(Rows == Cols, "Matrix must be square");
 #endif // C++ <= 201703L
+	MTLT_COUNT_OPERATION(operation::determinant, Rows, Cols, 2 * Rows * Rows * Rows / 3, Rows * Cols * sizeof(value_type), 0);
+
 	double determinant_value = 1;
 
 	static_matrix<double, Rows, Cols> matrix = convert_to<double>();
@@ -693,6 +772,8 @@ public:
   double determinant_laplacian() const {
 	static_assert(Rows == Cols, "Matrix must be square");
 #endif // C++ <= 201703L
+	MTLT_COUNT_OPERATION(operation::determinant, Rows, Cols, Rows < 2 ? 0 : Rows == 2 ? 3 : 3 * Rows, Rows * Cols * sizeof(value_type), 0);
+
 	double determinant_value{};
 	int sign = 1;
 
@@ -725,6 +806,8 @@ public:
   static_matrix calc_complements() const {
 	static_assert(Rows == Cols, "Matrix must be square");
 #endif // C++ <= 201703L
+	MTLT_COUNT_OPERATION(operation::complements, Rows, Cols, Rows * Cols, Rows * Cols * sizeof(value_type), Rows * Cols * sizeof(value_type));
+
 	static_matrix<value_type, Rows, Cols> complements;
 	for (size_type row = 0; row != Rows; ++row) {
 	  for (size_type col = 0; col != Cols; ++col) {
@@ -744,6 +827,8 @@ public:
   static_matrix inverse() const {
 	static_assert(Rows == Cols, "Matrix must be square");
 #endif // C++ <= 201703L
+	MTLT_COUNT_OPERATION(operation::inverse, Rows, Cols, 0, 0, 0);
+
 	double determinant = determinant_gaussian();
 
 	double tmp = determinant < 0 ? -determinant : determinant;
@@ -761,6 +846,8 @@ public:
   static_matrix inverse(double determinant) const {
 	static_assert(Rows == Cols, "Matrix must be square");
 #endif // C++ <= 201703L
+	MTLT_COUNT_OPERATION(operation::inverse, Rows, Cols, 0, 0, 0);
+
 	double tmp = determinant < 0 ? -determinant : determinant;
 	if (tmp <= 1e-6)
 	  return zero();
@@ -834,6 +921,19 @@ public:
 	return true;
   }
 
+  /**
+   * Floating point comparison with tolerance, see matrix::approx_equal
+   */
+  bool approx_equal(const static_matrix &rhs, value_type abs_tol = value_type(1e-8), value_type rel_tol = value_type(1e-5)) const {
+	static_assert(std::is_floating_point<value_type>::value, "approx_equal is defined only for floating point types");
+	return detail::approx_equal_elements(data_, rhs.data_, Rows * Cols, abs_tol, rel_tol);
+  }
+
+  value_type max_abs_diff(const static_matrix &rhs) const {
+	static_assert(std::is_floating_point<value_type>::value, "max_abs_diff is defined only for floating point types");
+	return detail::max_abs_diff_elements(data_, rhs.data_, Rows * Cols);
+  }
+
 private:
   size_type rows_ = Rows, cols_ = Cols;
   value_type data_[Rows * Cols]{};
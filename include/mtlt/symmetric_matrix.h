@@ -0,0 +1,275 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        The symmetric_matrix container class stores only the lower
+ *        triangle of a square symmetric matrix in a packed dynamic array
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_SYMMETRIC_MATRIX_H_
+#define MTLT_SYMMETRIC_MATRIX_H_
+
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <mtlt/matrix.h>
+#include <mtlt/matrix_config.h>
+#include <mtlt/matrix_normal_iterator.h>
+
+namespace mtlt {
+
+/**
+ * @class symmetric_matrix
+ *
+ * Square matrix with A(i, j) == A(j, i). Only the lower triangle is stored,
+ * row by row, so an n x n matrix keeps n * (n + 1) / 2 elements.
+ * operator()(i, j) and operator()(j, i) refer to the same element
+ *
+ * @code
+ *
+ * mtlt::matrix<double> covariance(3, 3, {...});
+ * mtlt::symmetric_matrix<double> packed(covariance); // lower triangle is taken
+ *
+ * packed(0, 2) = 1.5; // packed(2, 0) == 1.5 too
+ * mtlt::matrix<double> product = packed.mul(other); // SYMM
+ *
+ * @endcode
+ */
+template<typename T>
+class symmetric_matrix final {
+public:
+  using value_type = T;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using size_type = std::size_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = matrix_normal_iterator<pointer>;
+  using const_iterator = matrix_normal_iterator<const_pointer>;
+
+public:
+  MATRIX_CXX17_CONSTEXPR symmetric_matrix() noexcept = default;
+
+  MATRIX_CXX17_CONSTEXPR explicit symmetric_matrix(size_type order, value_type f = {})
+	  : order_(order), data_(new value_type[packed_size(order)]{}) {
+	if (f != value_type{})
+	  std::fill(begin(), end(), f);
+  }
+
+  /**
+   * Packs the lower triangle of a square matrix, the upper triangle is ignored
+   */
+  explicit symmetric_matrix(const matrix<T> &full)
+	  : symmetric_matrix(full.rows()) {
+	if (full.rows() != full.cols())
+	  throw std::logic_error("Only square matrices can be packed as symmetric");
+
+	pointer packed = data_;
+	for (size_type row = 0; row != order_; ++row)
+	  for (size_type col = 0; col <= row; ++col)
+		*packed++ = full(row, col);
+  }
+
+  MATRIX_CXX17_CONSTEXPR symmetric_matrix(const symmetric_matrix &other)
+	  : symmetric_matrix(other.order_) {
+	std::copy(other.begin(), other.end(), begin());
+  }
+
+  MATRIX_CXX17_CONSTEXPR symmetric_matrix(symmetric_matrix &&other) noexcept
+	  : order_(other.order_), data_(other.data_) {
+	other.order_ = size_type{};
+	other.data_ = nullptr;
+  }
+
+  MATRIX_CXX17_CONSTEXPR symmetric_matrix &operator=(const symmetric_matrix &other) {
+	if (&other == this)
+	  return *this;
+
+	symmetric_matrix tmp(other);
+	*this = std::move(tmp);
+
+	return *this;
+  }
+
+  MATRIX_CXX17_CONSTEXPR symmetric_matrix &operator=(symmetric_matrix &&other) noexcept {
+	if (&other == this)
+	  return *this;
+
+	std::swap(order_, other.order_);
+	std::swap(data_, other.data_);
+
+	return *this;
+  }
+
+  ~symmetric_matrix() noexcept {
+	delete[] data_;
+  }
+
+public:
+  MATRIX_CXX17_CONSTEXPR
+  iterator begin() noexcept { return iterator(data_); }
+
+  MATRIX_CXX17_CONSTEXPR
+  const_iterator begin() const noexcept { return const_iterator(data_); }
+
+  MATRIX_CXX17_CONSTEXPR
+  iterator end() noexcept { return iterator(data_ + size()); }
+
+  MATRIX_CXX17_CONSTEXPR
+  const_iterator end() const noexcept { return const_iterator(data_ + size()); }
+
+public:
+  reference operator()(size_type row, size_type col) {
+	return data_[index(row, col)];
+  }
+
+  const_reference operator()(size_type row, size_type col) const {
+	return data_[index(row, col)];
+  }
+
+  reference at(size_type row, size_type col) {
+	if (row >= order_ || col >= order_)
+	  throw std::out_of_range("row or col is out of range of matrix");
+
+	return (*this)(row, col);
+  }
+
+  const_reference at(size_type row, size_type col) const {
+	if (row >= order_ || col >= order_)
+	  throw std::out_of_range("row or col is out of range of matrix");
+
+	return (*this)(row, col);
+  }
+
+  MATRIX_CXX17_NODISCARD
+  size_type rows() const noexcept { return order_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type cols() const noexcept { return order_; }
+
+  /**
+   * Count of stored (packed) elements, not rows() * cols()
+   */
+  MATRIX_CXX17_NODISCARD
+  size_type size() const noexcept { return packed_size(order_); }
+
+public:
+  void print(std::ostream &os = std::cout, matrix_debug_settings s = matrix_debug_settings{}) const {
+	for (size_type row = 0; row != order_; ++row) {
+	  for (size_type col = 0; col != order_; ++col) {
+		os << std::setw(s.width)
+		   << std::setprecision(s.precision)
+		   << (*this)(row, col)
+		   << s.separator;
+	  }
+	  os << s.end;
+	}
+
+	if (s.is_double_end)
+	  os << s.end;
+  }
+
+  matrix<T> to_matrix() const {
+	matrix<T> full(order_, order_);
+
+	const_pointer packed = data_;
+	for (size_type row = 0; row != order_; ++row)
+	  for (size_type col = 0; col <= row; ++col, ++packed)
+		full(row, col) = full(col, row) = *packed;
+
+	return full;
+  }
+
+  /**
+   * SYMM: returns this * rhs. Every packed element is loaded once
+   * and applied to both rows it belongs to
+   */
+  matrix<T> mul(const matrix<T> &rhs) const {
+	if (order_ != rhs.rows())
+	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
+
+	const size_type cols = rhs.cols();
+	matrix<T> multiplied(order_, cols);
+
+	const_pointer packed = data_;
+	for (size_type row = 0; row != order_; ++row) {
+	  for (size_type k = 0; k != row; ++k, ++packed) {
+		const value_type a = *packed;
+		for (size_type col = 0; col != cols; ++col) {
+		  multiplied(row, col) += a * rhs(k, col);
+		  multiplied(k, col) += a * rhs(row, col);
+		}
+	  }
+
+	  const value_type diagonal = *packed++;
+	  for (size_type col = 0; col != cols; ++col)
+		multiplied(row, col) += diagonal * rhs(row, col);
+	}
+
+	return multiplied;
+  }
+
+  symmetric_matrix &mul(const value_type &number) {
+	std::transform(begin(), end(), begin(), [&number](const value_type &item) { return item * number; });
+	return *this;
+  }
+
+  template<typename EqualCompare = std::equal_to<value_type>>
+  bool equal_to(const symmetric_matrix &rhs) const {
+	return order_ == rhs.order_ && std::equal(begin(), end(), rhs.begin(), EqualCompare());
+  }
+
+private:
+  static MATRIX_CXX17_CONSTEXPR size_type packed_size(size_type order) noexcept {
+	return order * (order + 1) / 2;
+  }
+
+  static MATRIX_CXX17_CONSTEXPR size_type index(size_type row, size_type col) noexcept {
+	return row >= col ? row * (row + 1) / 2 + col : col * (col + 1) / 2 + row;
+  }
+
+private:
+  size_type order_{};
+  pointer data_ = nullptr;
+};
+
+template<typename T>
+std::ostream &operator<<(std::ostream &out, const symmetric_matrix<T> &rhs) {
+  rhs.print(out);
+  return out;
+}
+
+template<typename T>
+matrix<T> inline operator*(const symmetric_matrix<T> &lhs, const matrix<T> &rhs) {
+  return lhs.mul(rhs);
+}
+
+template<typename T>
+bool inline operator==(const symmetric_matrix<T> &lhs, const symmetric_matrix<T> &rhs) {
+  return lhs.equal_to(rhs);
+}
+
+template<typename T>
+bool inline operator!=(const symmetric_matrix<T> &lhs, const symmetric_matrix<T> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_SYMMETRIC_MATRIX_H_
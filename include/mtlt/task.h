@@ -0,0 +1,373 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        C++20 coroutine tasks awaiting the asynchronous operations
+ *        of the library and pipelines of row tiles
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_TASK_H_
+#define MTLT_TASK_H_
+
+#include <mtlt/async.h>
+
+#if __cplusplus > 201703L && defined(__cpp_impl_coroutine)
+
+#include <tuple>
+#include <memory>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <coroutine>
+#include <algorithm>
+#include <type_traits>
+
+namespace mtlt {
+
+template<typename T = void>
+class task;
+
+namespace detail {
+
+class task_promise_base {
+public:
+  struct final_awaiter {
+	bool await_ready() const noexcept { return false; }
+
+	template<typename Promise>
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finished) const noexcept {
+	  return finished.promise().continuation_;
+	}
+
+	void await_resume() const noexcept {}
+  };
+
+public:
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  final_awaiter final_suspend() const noexcept { return {}; }
+
+  void unhandled_exception() noexcept { error_ = std::current_exception(); }
+
+  void set_continuation(std::coroutine_handle<> continuation) noexcept { continuation_ = continuation; }
+
+protected:
+  void rethrow_error() const {
+	if (error_)
+	  std::rethrow_exception(error_);
+  }
+
+private:
+  std::coroutine_handle<> continuation_ = std::noop_coroutine();
+  std::exception_ptr error_;
+};
+
+template<typename T>
+class task_promise final : public task_promise_base {
+public:
+  task<T> get_return_object() noexcept;
+
+  template<typename U>
+  void return_value(U &&value) { value_.emplace(std::forward<U>(value)); }
+
+  T &result() {
+	rethrow_error();
+	return *value_;
+  }
+
+private:
+  std::optional<T> value_;
+};
+
+template<>
+class task_promise<void> final : public task_promise_base {
+public:
+  task<void> get_return_object() noexcept;
+
+  void return_void() noexcept {}
+
+  void result() { rethrow_error(); }
+};
+
+} // namespace detail end
+
+/**
+ * @class task
+ *
+ * Lazy coroutine, starts when it is awaited and resumes the awaiting
+ * coroutine when it returns. Inside a task the futures of the library
+ * (mul_async, load_async, ...) and the other tasks are awaited with co_await
+ * without blocking a thread, mtlt::spawn starts a task from the usual code
+ *
+ * @code
+ *
+ * mtlt::task<double> score(std::string path, mtlt::matrix<double> weights) {
+ *   mtlt::matrix<double> x = co_await mtlt::load_async<mtlt::matrix<double>>(path);
+ *   x.sub_row_mean();
+ *
+ *   mtlt::matrix<double> y = co_await mtlt::mul_async(std::move(x), std::move(weights));
+ *   co_return y.sum();
+ * }
+ *
+ * double result = mtlt::spawn(score("x.mtlt", weights)).get();
+ *
+ * @endcode
+ */
+template<typename T>
+class task final {
+public:
+  using promise_type = detail::task_promise<T>;
+  using handle_type = std::coroutine_handle<promise_type>;
+
+public:
+  task() noexcept = default;
+
+  explicit task(handle_type handle) noexcept : handle_(handle) {}
+
+  task(task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  task &operator=(task &&other) noexcept {
+	if (this != &other) {
+	  if (handle_)
+		handle_.destroy();
+	  handle_ = std::exchange(other.handle_, nullptr);
+	}
+
+	return *this;
+  }
+
+  task(const task &) = delete;
+  task &operator=(const task &) = delete;
+
+  ~task() {
+	if (handle_)
+	  handle_.destroy();
+  }
+
+public:
+  [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(handle_); }
+
+  /**
+   * Starts the task, the awaiting coroutine is resumed with its result
+   */
+  auto operator co_await() && noexcept {
+	struct awaiter {
+	  handle_type handle;
+
+	  bool await_ready() const noexcept { return handle.done(); }
+
+	  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+		handle.promise().set_continuation(awaiting);
+		return handle;
+	  }
+
+	  decltype(auto) await_resume() const {
+		if constexpr (std::is_void_v<T>)
+		  handle.promise().result();
+		else
+		  return std::move(handle.promise().result());
+	  }
+	};
+
+	return awaiter{handle_};
+  }
+
+private:
+  handle_type handle_ = nullptr;
+};
+
+namespace detail {
+
+template<typename T>
+task<T> task_promise<T>::get_return_object() noexcept {
+  return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+  return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+}
+
+template<typename T, bool Move>
+class future_awaiter {
+public:
+  explicit future_awaiter(std::shared_ptr<future_state<T>> state) noexcept : state_(std::move(state)) {}
+
+public:
+  bool await_ready() const { return state_->is_ready(); }
+
+  /**
+   * The coroutine is resumed on the thread completing the future
+   */
+  void await_suspend(std::coroutine_handle<> awaiting) const {
+	state_->on_ready([awaiting]() { awaiting.resume(); });
+  }
+
+  decltype(auto) await_resume() const {
+	if (state_->error())
+	  std::rethrow_exception(state_->error());
+
+	if constexpr (std::is_void_v<T>)
+	  return;
+	else if constexpr (Move)
+	  return T(std::move(state_->get()));
+	else
+	  return static_cast<T &>(state_->get());
+  }
+
+private:
+  std::shared_ptr<future_state<T>> state_;
+};
+
+/**
+ * Coroutine started right away and destroyed when it returns
+ */
+struct detached_coroutine {
+  struct promise_type {
+	detached_coroutine get_return_object() const noexcept { return {}; }
+	std::suspend_never initial_suspend() const noexcept { return {}; }
+	std::suspend_never final_suspend() const noexcept { return {}; }
+	void return_void() const noexcept {}
+	void unhandled_exception() const noexcept { std::terminate(); }
+  };
+};
+
+} // namespace detail end
+
+/**
+ * co_await of a future resumes the coroutine with the value when the
+ * future is ready, an exception of the operation is rethrown.
+ * The value is moved out of a temporary future, a named one keeps it
+ */
+template<typename T>
+detail::future_awaiter<T, true> operator co_await(future<T> &&f) {
+  return detail::future_awaiter<T, true>(detail::future_access<T>::state(f));
+}
+
+template<typename T>
+detail::future_awaiter<T, false> operator co_await(const future<T> &f) {
+  return detail::future_awaiter<T, false>(detail::future_access<T>::state(f));
+}
+
+/**
+ * co_await resume_on_executor() moves the coroutine to a job of the executor
+ * of the library, the calling thread goes on
+ */
+inline auto resume_on_executor() noexcept {
+  struct awaiter {
+	bool await_ready() const noexcept { return false; }
+
+	bool await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+	  try {
+		get_executor().submit([awaiting]() { awaiting.resume(); });
+	  } catch (...) {
+		return false; // Not submitted, goes on in place
+	  }
+	  return true;
+	}
+
+	void await_resume() const noexcept {}
+  };
+
+  return awaiter{};
+}
+
+namespace detail {
+
+template<typename T>
+detached_coroutine run_detached(task<T> t, std::shared_ptr<future_state<T>> state) {
+  co_await resume_on_executor();
+
+  try {
+	if constexpr (std::is_void_v<T>) {
+	  co_await std::move(t);
+	  state->set();
+	} else {
+	  state->set(co_await std::move(t));
+	}
+  } catch (...) {
+	state->fail(std::current_exception());
+  }
+
+  state->complete();
+}
+
+} // namespace detail end
+
+/**
+ * Starts t on the executor of the library, the returned future gets its result.
+ * get() of the future helps the executor while the task runs
+ */
+template<typename T>
+future<T> spawn(task<T> t) {
+  std::shared_ptr<detail::future_state<T>> state = std::make_shared<detail::future_state<T>>();
+  detail::run_detached(std::move(t), state);
+  return future<T>(std::move(state));
+}
+
+/**
+ * Splits [0, rows) into tiles of tile_rows rows and runs the stages one after
+ * another on every tile, calling stage(first_row, last_row). The tiles go
+ * through the stages independently on the executor, so the next stage starts
+ * on the finished tiles while the previous one still works on the others.
+ * Every stage has to touch only the rows of its tile (or synchronize itself).
+ * Completes when every tile passed all stages, the first exception is rethrown
+ *
+ * @code
+ *
+ * co_await mtlt::pipeline_rows(x.rows(), 64,
+ *     [&](std::size_t first, std::size_t last) { normalize(x, first, last); },
+ *     [&](std::size_t first, std::size_t last) { multiply(x, weights, y, first, last); },
+ *     [&](std::size_t first, std::size_t last) { partial[first / 64] = row_sums(y, first, last); });
+ *
+ * @endcode
+ */
+template<typename... Stages>
+task<void> pipeline_rows(std::size_t rows, std::size_t tile_rows, Stages... stages) {
+  static_assert(sizeof...(Stages) != 0, "pipeline_rows needs at least one stage");
+
+  tile_rows = std::max<std::size_t>(tile_rows, 1);
+  std::shared_ptr<std::tuple<Stages...>> shared = std::make_shared<std::tuple<Stages...>>(std::move(stages)...);
+
+  std::vector<future<void>> tiles;
+  tiles.reserve((rows + tile_rows - 1) / tile_rows);
+  for (std::size_t first = 0; first < rows; first += tile_rows) {
+	const std::size_t last = std::min(rows, first + tile_rows);
+	tiles.push_back(async([shared, first, last]() {
+	  std::apply([first, last](Stages &... stage) { (stage(first, last), ...); }, *shared);
+	}));
+  }
+
+  // Every tile is awaited before rethrowing, the stages may refer
+  // to the frame of the awaiting coroutine
+  std::exception_ptr error;
+  for (const future<void> &tile : tiles) {
+	try {
+	  co_await tile;
+	} catch (...) {
+	  if (!error)
+		error = std::current_exception();
+	}
+  }
+
+  if (error)
+	std::rethrow_exception(error);
+}
+
+} // namespace mtlt end
+
+#endif // __cplusplus > 201703L && defined(__cpp_impl_coroutine)
+
+#endif // MTLT_TASK_H_
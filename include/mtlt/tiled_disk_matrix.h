@@ -0,0 +1,831 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        The tiled_disk_matrix container class keeps a matrix in a file
+ *        split into fixed size tiles and caches a part of them in memory
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_TILED_DISK_MATRIX_H_
+#define MTLT_TILED_DISK_MATRIX_H_
+
+#include <list>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <condition_variable>
+
+#include <mtlt/matrix.h>
+#include <mtlt/matrix_config.h>
+#include <mtlt/serialization.h>
+
+namespace mtlt {
+
+/**
+ * @struct tiled_disk_settings
+ *
+ * tile_rows, tile_cols - size of a tile for a new matrix, an opened matrix takes them from the file
+ * memory_budget        - bytes of tiles kept in memory, at least 4 tiles are kept regardless
+ * prefetch             - load the next tiles of an operation by a background thread
+ *                        while the current ones are being computed
+ */
+struct tiled_disk_settings {
+  std::size_t tile_rows = 256;
+  std::size_t tile_cols = 256;
+  std::size_t memory_budget = std::size_t(256) << 20;
+  bool prefetch = true;
+};
+
+/**
+ * @struct tiled_disk_stats
+ * Buffer pool counters since the matrix was created or opened
+ */
+struct tiled_disk_stats {
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t prefetched = 0;
+  std::size_t evictions = 0;
+  std::size_t reads = 0;
+  std::size_t writes = 0;
+};
+
+namespace detail {
+
+/**
+ * File of tiles with an LRU pool of tiles in memory. Tiles in use are pinned
+ * and never evicted, dirty tiles are written back on eviction and on flush
+ *
+ * offset  size  field
+ *      0     8  magic "MTLTTILE"
+ *      8     4  element size in bytes
+ *     12     1  dtype
+ *     13     1  flags: bit 0 - big endian
+ *     16     8  rows
+ *     24     8  cols
+ *     32     8  tile rows
+ *     40     8  tile cols
+ *
+ * Tiles follow the 64 byte header in row major order of tiles, every tile
+ * takes tile rows * tile cols elements, edge tiles are padded
+ */
+template<typename T>
+class tile_store {
+public:
+  using size_type = std::size_t;
+
+  static const size_type kHeaderSize = 64;
+  static const size_type kMinTiles = 4;
+
+  struct frame {
+	matrix<T> tile;
+	bool dirty = false;
+	size_type pins = 0;
+	std::list<size_type>::iterator position;
+  };
+
+public:
+  tile_store(const std::string &path, size_type rows, size_type cols, const tiled_disk_settings &settings)
+	  : rows_(rows), cols_(cols), tile_rows_(settings.tile_rows), tile_cols_(settings.tile_cols) {
+	if (tile_rows_ == 0 || tile_cols_ == 0)
+	  throw std::logic_error("Tile size can't be zero");
+
+	file_.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file_.is_open())
+	  throw std::runtime_error("Can't open file " + path + " for writing");
+
+	write_header();
+
+	// Extends the file to its full size, the OS keeps the gap sparse and reads it as zeros
+	if (tiles() != 0) {
+	  file_.seekp(static_cast<std::streamoff>(tile_offset(tiles()) - 1));
+	  file_.put('\0');
+	}
+
+	if (!file_)
+	  throw std::runtime_error("Can't create file " + path);
+
+	start(settings);
+  }
+
+  tile_store(const std::string &path, const tiled_disk_settings &settings) {
+	file_.open(path, std::ios::in | std::ios::out | std::ios::binary);
+	if (!file_.is_open())
+	  throw std::runtime_error("Can't open file " + path + " for reading");
+
+	read_header();
+	start(settings);
+  }
+
+  tile_store(const tile_store &) = delete;
+  tile_store &operator=(const tile_store &) = delete;
+
+  ~tile_store() noexcept {
+	{
+	  std::lock_guard<std::mutex> lock(mutex_);
+	  stop_ = true;
+	}
+	worker_cv_.notify_all();
+
+	if (worker_.joinable())
+	  worker_.join();
+
+	try {
+	  flush();
+	} catch (...) {
+	}
+  }
+
+public:
+  size_type rows() const noexcept { return rows_; }
+  size_type cols() const noexcept { return cols_; }
+  size_type tile_rows() const noexcept { return tile_rows_; }
+  size_type tile_cols() const noexcept { return tile_cols_; }
+  size_type grid_rows() const noexcept { return (rows_ + tile_rows_ - 1) / tile_rows_; }
+  size_type grid_cols() const noexcept { return (cols_ + tile_cols_ - 1) / tile_cols_; }
+  size_type tiles() const noexcept { return grid_rows() * grid_cols(); }
+  size_type capacity() const noexcept { return capacity_; }
+
+  size_type rows_in(size_type tile_row) const noexcept {
+	return std::min(tile_rows_, rows_ - tile_row * tile_rows_);
+  }
+
+  size_type cols_in(size_type tile_col) const noexcept {
+	return std::min(tile_cols_, cols_ - tile_col * tile_cols_);
+  }
+
+  size_type resident() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return frames_.size();
+  }
+
+  tiled_disk_stats stats() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::lock_guard<std::mutex> io_lock(io_mutex_);
+
+	tiled_disk_stats snapshot = stats_;
+	snapshot.reads = reads_;
+	return snapshot;
+  }
+
+  /**
+   * Returns the pinned tile, loads it if it is not in memory
+   * or waits for the prefetch thread if it is being loaded
+   */
+  frame *acquire(size_type index) {
+	std::unique_lock<std::mutex> lock(mutex_);
+
+	for (;;) {
+	  auto found = frames_.find(index);
+	  if (found != frames_.end()) {
+		++stats_.hits;
+		++found->second.pins;
+		lru_.splice(lru_.begin(), lru_, found->second.position);
+		return &found->second;
+	  }
+
+	  if (pending_.count(index) == 0)
+		break;
+
+	  loaded_cv_.wait(lock);
+	}
+
+	++stats_.misses;
+	frame &loaded = load(index, lock);
+	++loaded.pins;
+
+	return &loaded;
+  }
+
+  void release(frame *f, bool dirty) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	--f->pins;
+	f->dirty = f->dirty || dirty;
+  }
+
+  /**
+   * Queues the tile for the prefetch thread, does nothing if it is already in memory
+   */
+  void prefetch(size_type index) {
+	if (!worker_.joinable() || index >= tiles())
+	  return;
+
+	{
+	  std::lock_guard<std::mutex> lock(mutex_);
+	  if (frames_.count(index) != 0 || pending_.count(index) != 0)
+		return;
+	  queue_.push_back(index);
+	}
+
+	worker_cv_.notify_one();
+  }
+
+  void flush() {
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	for (auto &item : frames_) {
+	  if (item.second.dirty) {
+		write_tile(item.first, item.second.tile);
+		item.second.dirty = false;
+	  }
+	}
+
+	std::lock_guard<std::mutex> io_lock(io_mutex_);
+	file_.flush();
+	if (!file_)
+	  throw std::runtime_error("Can't flush tiled matrix file");
+  }
+
+private:
+  void start(const tiled_disk_settings &settings) {
+	const size_type tile_bytes = tile_rows_ * tile_cols_ * sizeof(T);
+	capacity_ = std::max(settings.memory_budget / tile_bytes, static_cast<size_type>(kMinTiles));
+
+	if (settings.prefetch)
+	  worker_ = std::thread(&tile_store::prefetch_loop, this);
+  }
+
+  void prefetch_loop() {
+	std::unique_lock<std::mutex> lock(mutex_);
+
+	for (;;) {
+	  worker_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+	  if (stop_)
+		return;
+
+	  const size_type index = queue_.front();
+	  queue_.pop_front();
+
+	  if (frames_.count(index) != 0 || pending_.count(index) != 0)
+		continue;
+
+	  try {
+		load(index, lock);
+		++stats_.prefetched;
+	  } catch (...) {
+		// The tile is read again and the error is reported by acquire
+	  }
+	}
+  }
+
+  /**
+   * Reads the tile without holding the pool lock, so other tiles
+   * can be used in the meantime, and puts it into the pool
+   */
+  frame &load(size_type index, std::unique_lock<std::mutex> &lock) {
+	pending_.insert(index);
+	lock.unlock();
+
+	matrix<T> tile;
+	try {
+	  tile = read_tile(index);
+	} catch (...) {
+	  lock.lock();
+	  pending_.erase(index);
+	  loaded_cv_.notify_all();
+	  throw;
+	}
+
+	lock.lock();
+	pending_.erase(index);
+	evict();
+
+	frame &inserted = frames_[index];
+	inserted.tile = std::move(tile);
+	lru_.push_front(index);
+	inserted.position = lru_.begin();
+
+	loaded_cv_.notify_all();
+	return inserted;
+  }
+
+  /**
+   * Evicts least recently used unpinned tiles until there is room for one more,
+   * if every tile is pinned the pool temporary grows over the budget
+   */
+  void evict() {
+	auto candidate = lru_.end();
+
+	while (frames_.size() >= capacity_ && candidate != lru_.begin()) {
+	  --candidate;
+
+	  auto found = frames_.find(*candidate);
+	  if (found->second.pins != 0)
+		continue;
+
+	  if (found->second.dirty)
+		write_tile(found->first, found->second.tile);
+
+	  ++stats_.evictions;
+	  candidate = lru_.erase(candidate);
+	  frames_.erase(found);
+	}
+  }
+
+  size_type tile_offset(size_type index) const noexcept {
+	return kHeaderSize + index * tile_rows_ * tile_cols_ * sizeof(T);
+  }
+
+  matrix<T> read_tile(size_type index) {
+	matrix<T> tile(tile_rows_, tile_cols_);
+
+	std::lock_guard<std::mutex> io_lock(io_mutex_);
+	file_.seekg(static_cast<std::streamoff>(tile_offset(index)));
+	file_.read(reinterpret_cast<char *>(tile.data()), static_cast<std::streamsize>(tile.size() * sizeof(T)));
+
+	if (!file_) {
+	  file_.clear();
+	  throw std::runtime_error("Can't read tile from tiled matrix file");
+	}
+
+	++reads_;
+	return tile;
+  }
+
+  void write_tile(size_type index, const matrix<T> &tile) {
+	std::lock_guard<std::mutex> io_lock(io_mutex_);
+	file_.seekp(static_cast<std::streamoff>(tile_offset(index)));
+	file_.write(reinterpret_cast<const char *>(tile.data()), static_cast<std::streamsize>(tile.size() * sizeof(T)));
+
+	if (!file_) {
+	  file_.clear();
+	  throw std::runtime_error("Can't write tile to tiled matrix file");
+	}
+
+	++stats_.writes;
+  }
+
+  void write_header() {
+	char header[kHeaderSize] = {};
+	std::memcpy(header, "MTLTTILE", 8);
+	put(header, 8, static_cast<std::uint32_t>(sizeof(T)));
+	put(header, 12, static_cast<std::uint8_t>(dtype_of<T>::value));
+	put(header, 13, static_cast<std::uint8_t>(is_big_endian() ? 1 : 0));
+	put(header, 16, static_cast<std::uint64_t>(rows_));
+	put(header, 24, static_cast<std::uint64_t>(cols_));
+	put(header, 32, static_cast<std::uint64_t>(tile_rows_));
+	put(header, 40, static_cast<std::uint64_t>(tile_cols_));
+
+	file_.write(header, sizeof(header));
+  }
+
+  void read_header() {
+	char header[kHeaderSize];
+	if (!file_.read(header, sizeof(header)) || std::memcmp(header, "MTLTTILE", 8) != 0)
+	  throw std::runtime_error("Can't open tiled matrix because file is not in MTLT tile format");
+
+	if (get<std::uint8_t>(header, 13, false) != (is_big_endian() ? 1 : 0))
+	  throw std::logic_error("Can't open tiled matrix because it was written with another byte order");
+
+	if (get<std::uint32_t>(header, 8, false) != sizeof(T)
+		|| get<std::uint8_t>(header, 12, false) != static_cast<std::uint8_t>(dtype_of<T>::value))
+	  throw std::logic_error("Can't open tiled matrix because stored element type differs from matrix value_type");
+
+	rows_ = static_cast<size_type>(get<std::uint64_t>(header, 16, false));
+	cols_ = static_cast<size_type>(get<std::uint64_t>(header, 24, false));
+	tile_rows_ = static_cast<size_type>(get<std::uint64_t>(header, 32, false));
+	tile_cols_ = static_cast<size_type>(get<std::uint64_t>(header, 40, false));
+
+	if (tile_rows_ == 0 || tile_cols_ == 0)
+	  throw std::runtime_error("Can't open tiled matrix because header is corrupted");
+  }
+
+private:
+  size_type rows_{}, cols_{};
+  size_type tile_rows_{}, tile_cols_{};
+  size_type capacity_{};
+
+  std::fstream file_;
+  mutable std::mutex io_mutex_;
+  size_type reads_{};
+
+  mutable std::mutex mutex_;
+  std::condition_variable loaded_cv_;
+  std::unordered_map<size_type, frame> frames_;
+  std::list<size_type> lru_;
+  std::unordered_set<size_type> pending_;
+  tiled_disk_stats stats_;
+
+  std::thread worker_;
+  std::condition_variable worker_cv_;
+  std::deque<size_type> queue_;
+  bool stop_ = false;
+};
+
+} // namespace detail end
+
+/**
+ * @class tiled_disk_matrix
+ *
+ * Out of core matrix: elements are stored in a file as tile_rows x tile_cols tiles
+ * and only memory_budget bytes of recently used tiles are kept in memory.
+ * Operations walk the matrix tile by tile and ask a background thread
+ * to read the next tiles while the current ones are computed
+ *
+ * Single tiles are exchanged with regular matrices through load_tile and store_tile
+ *
+ * @code
+ *
+ * mtlt::tiled_disk_settings settings;
+ * settings.memory_budget = std::size_t(8) << 30;
+ *
+ * mtlt::tiled_disk_matrix<double> x("x.tiles", 200000, 1000, settings);
+ * for (std::size_t row = 0; row != x.grid_rows(); ++row)
+ *   x.store_tile(row, 0, next_batch());
+ *
+ * mtlt::tiled_disk_matrix<double> gram = x.mul(x.transpose("xt.tiles"), "gram.tiles");
+ *
+ * @endcode
+ */
+template<typename T>
+class tiled_disk_matrix final {
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to be stored in file");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+public:
+  /**
+   * Creates (or truncates) the file for a rows x cols matrix of zeros
+   */
+  tiled_disk_matrix(const std::string &path, size_type rows, size_type cols,
+					tiled_disk_settings settings = tiled_disk_settings{})
+	  : store_(new detail::tile_store<T>(path, rows, cols, settings)), settings_(settings) {}
+
+  /**
+   * Opens a file created by tiled_disk_matrix, the tile size is taken from the file
+   */
+  explicit tiled_disk_matrix(const std::string &path, tiled_disk_settings settings = tiled_disk_settings{})
+	  : store_(new detail::tile_store<T>(path, settings)), settings_(settings) {
+	settings_.tile_rows = store_->tile_rows();
+	settings_.tile_cols = store_->tile_cols();
+  }
+
+  /**
+   * Writes a regular matrix into a new tiled file
+   */
+  static tiled_disk_matrix from_matrix(const std::string &path, const matrix<T> &m,
+									   tiled_disk_settings settings = tiled_disk_settings{}) {
+	tiled_disk_matrix tiled(path, m.rows(), m.cols(), settings);
+
+	for (size_type tile_row = 0; tile_row != tiled.grid_rows(); ++tile_row) {
+	  for (size_type tile_col = 0; tile_col != tiled.grid_cols(); ++tile_col) {
+		pinned tile(tiled, tile_row, tile_col, true);
+		for (size_type row = 0; row != tiled.store_->rows_in(tile_row); ++row)
+		  for (size_type col = 0; col != tiled.store_->cols_in(tile_col); ++col)
+			(*tile)(row, col) = m(tile_row * tiled.tile_rows() + row, tile_col * tiled.tile_cols() + col);
+	  }
+	}
+
+	return tiled;
+  }
+
+  tiled_disk_matrix(tiled_disk_matrix &&other) noexcept = default;
+  tiled_disk_matrix &operator=(tiled_disk_matrix &&other) noexcept = default;
+
+  /**
+   * Dirty tiles are written back, use flush() to get write errors reported
+   */
+  ~tiled_disk_matrix() noexcept = default;
+
+public:
+  MATRIX_CXX17_NODISCARD
+  size_type rows() const noexcept { return store_->rows(); }
+
+  MATRIX_CXX17_NODISCARD
+  size_type cols() const noexcept { return store_->cols(); }
+
+  MATRIX_CXX17_NODISCARD
+  size_type size() const noexcept { return rows() * cols(); }
+
+  MATRIX_CXX17_NODISCARD
+  size_type tile_rows() const noexcept { return store_->tile_rows(); }
+
+  MATRIX_CXX17_NODISCARD
+  size_type tile_cols() const noexcept { return store_->tile_cols(); }
+
+  /**
+   * Count of tiles along the rows and the cols
+   */
+  MATRIX_CXX17_NODISCARD
+  size_type grid_rows() const noexcept { return store_->grid_rows(); }
+
+  MATRIX_CXX17_NODISCARD
+  size_type grid_cols() const noexcept { return store_->grid_cols(); }
+
+  /**
+   * Count of tiles the buffer pool may keep in memory
+   */
+  MATRIX_CXX17_NODISCARD
+  size_type capacity() const noexcept { return store_->capacity(); }
+
+  MATRIX_CXX17_NODISCARD
+  size_type resident_tiles() const { return store_->resident(); }
+
+  MATRIX_CXX17_NODISCARD
+  tiled_disk_stats stats() const { return store_->stats(); }
+
+  void flush() { store_->flush(); }
+
+public:
+  value_type at(size_type row, size_type col) const {
+	check_range(row, col);
+
+	const pinned tile(*this, row / tile_rows(), col / tile_cols(), false);
+	return (*tile)(row % tile_rows(), col % tile_cols());
+  }
+
+  void set(size_type row, size_type col, const value_type &value) {
+	check_range(row, col);
+
+	pinned tile(*this, row / tile_rows(), col / tile_cols(), true);
+	(*tile)(row % tile_rows(), col % tile_cols()) = value;
+  }
+
+  /**
+   * Copy of the tile, edge tiles are smaller than tile_rows() x tile_cols()
+   */
+  matrix<T> load_tile(size_type tile_row, size_type tile_col) const {
+	check_tile(tile_row, tile_col);
+
+	const size_type rows = store_->rows_in(tile_row);
+	const size_type cols = store_->cols_in(tile_col);
+	const pinned tile(*this, tile_row, tile_col, false);
+
+	matrix<T> copy(rows, cols);
+	for (size_type row = 0; row != rows; ++row)
+	  for (size_type col = 0; col != cols; ++col)
+		copy(row, col) = (*tile)(row, col);
+
+	return copy;
+  }
+
+  void store_tile(size_type tile_row, size_type tile_col, const matrix<T> &m) {
+	check_tile(tile_row, tile_col);
+
+	const size_type rows = store_->rows_in(tile_row);
+	const size_type cols = store_->cols_in(tile_col);
+	if (m.rows() != rows || m.cols() != cols)
+	  throw std::logic_error("Can't store tile because matrix size differs from tile size");
+
+	pinned tile(*this, tile_row, tile_col, true);
+	for (size_type row = 0; row != rows; ++row)
+	  for (size_type col = 0; col != cols; ++col)
+		(*tile)(row, col) = m(row, col);
+  }
+
+  /**
+   * Reads the whole matrix into memory
+   */
+  matrix<T> to_matrix() const {
+	matrix<T> m(rows(), cols());
+
+	for_each_tile([&](size_type tile_row, size_type tile_col, size_type rows, size_type cols) {
+	  const pinned tile(*this, tile_row, tile_col, false);
+	  for (size_type row = 0; row != rows; ++row)
+		for (size_type col = 0; col != cols; ++col)
+		  m(tile_row * tile_rows() + row, tile_col * tile_cols() + col) = (*tile)(row, col);
+	});
+
+	return m;
+  }
+
+public:
+  template<typename UnaryOperation>
+  void transform(UnaryOperation &&op) {
+	for_each_tile([&](size_type tile_row, size_type tile_col, size_type rows, size_type cols) {
+	  pinned tile(*this, tile_row, tile_col, true);
+	  for (size_type row = 0; row != rows; ++row)
+		for (size_type col = 0; col != cols; ++col)
+		  (*tile)(row, col) = op((*tile)(row, col));
+	});
+  }
+
+  template<typename BinaryOperation>
+  void transform(const tiled_disk_matrix &other, BinaryOperation &&op) {
+	if (rows() != other.rows() || cols() != other.cols())
+	  throw std::logic_error("Can't transform different sized matrices");
+
+	if (tile_rows() != other.tile_rows() || tile_cols() != other.tile_cols())
+	  throw std::logic_error("Can't transform tiled matrices with different tile sizes");
+
+	for_each_tile([&](size_type tile_row, size_type tile_col, size_type rows, size_type cols) {
+	  const bool last_col = tile_col + 1 == grid_cols();
+	  other.prefetch(last_col ? tile_row + 1 : tile_row, last_col ? 0 : tile_col + 1);
+
+	  pinned tile(*this, tile_row, tile_col, true);
+	  const pinned rhs(other, tile_row, tile_col, false);
+
+	  for (size_type row = 0; row != rows; ++row)
+		for (size_type col = 0; col != cols; ++col)
+		  (*tile)(row, col) = op((*tile)(row, col), (*rhs)(row, col));
+	});
+  }
+
+  tiled_disk_matrix &fill(const value_type &number) {
+	transform([&number](const value_type &) { return number; });
+	return *this;
+  }
+
+  tiled_disk_matrix &mul(const value_type &number) {
+	transform([&number](const value_type &item) { return item * number; });
+	return *this;
+  }
+
+  tiled_disk_matrix &add(const value_type &number) {
+	transform([&number](const value_type &item) { return item + number; });
+	return *this;
+  }
+
+  tiled_disk_matrix &sub(const value_type &number) {
+	transform([&number](const value_type &item) { return item - number; });
+	return *this;
+  }
+
+  tiled_disk_matrix &add(const tiled_disk_matrix &rhs) {
+	transform(rhs, [](const value_type &lhs, const value_type &rhs) { return lhs + rhs; });
+	return *this;
+  }
+
+  tiled_disk_matrix &sub(const tiled_disk_matrix &rhs) {
+	transform(rhs, [](const value_type &lhs, const value_type &rhs) { return lhs - rhs; });
+	return *this;
+  }
+
+  tiled_disk_matrix &mul_by_element(const tiled_disk_matrix &rhs) {
+	transform(rhs, [](const value_type &lhs, const value_type &rhs) { return lhs * rhs; });
+	return *this;
+  }
+
+  value_type sum() const {
+	value_type sum_value{};
+
+	for_each_tile([&](size_type tile_row, size_type tile_col, size_type rows, size_type cols) {
+	  const pinned tile(*this, tile_row, tile_col, false);
+	  for (size_type row = 0; row != rows; ++row)
+		for (size_type col = 0; col != cols; ++col)
+		  sum_value += (*tile)(row, col);
+	});
+
+	return sum_value;
+  }
+
+  /**
+   * Writes the transposed matrix to a new file at path,
+   * its tiles are tile_cols() x tile_rows()
+   */
+  tiled_disk_matrix transpose(const std::string &path) const {
+	tiled_disk_settings settings = settings_;
+	std::swap(settings.tile_rows, settings.tile_cols);
+
+	tiled_disk_matrix transposed(path, cols(), rows(), settings);
+
+	for_each_tile([&](size_type tile_row, size_type tile_col, size_type rows, size_type cols) {
+	  const pinned tile(*this, tile_row, tile_col, false);
+	  pinned target(transposed, tile_col, tile_row, true);
+
+	  for (size_type row = 0; row != rows; ++row)
+		for (size_type col = 0; col != cols; ++col)
+		  (*target)(col, row) = (*tile)(row, col);
+	});
+
+	return transposed;
+  }
+
+  /**
+   * Out of core GEMM: writes this * rhs to a new file at path. Tiles of the
+   * product are computed one by one, for every step over k the next pair
+   * of input tiles is being read while the current pair is multiplied.
+   * Requires tile_cols() == rhs.tile_rows()
+   */
+  tiled_disk_matrix mul(const tiled_disk_matrix &rhs, const std::string &path) const {
+	if (cols() != rhs.rows())
+	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
+
+	if (tile_cols() != rhs.tile_rows())
+	  throw std::logic_error("Can't multiply tiled matrices because lhs.tile_cols() != rhs.tile_rows()");
+
+	tiled_disk_settings settings = settings_;
+	settings.tile_cols = rhs.tile_cols();
+
+	tiled_disk_matrix multiplied(path, rows(), rhs.cols(), settings);
+	const size_type steps = grid_cols();
+
+	multiplied.for_each_tile([&](size_type tile_row, size_type tile_col, size_type rows, size_type cols) {
+	  pinned product(multiplied, tile_row, tile_col, true);
+
+	  for (size_type step = 0; step != steps; ++step) {
+		if (step + 1 != steps) {
+		  prefetch(tile_row, step + 1);
+		  rhs.prefetch(step + 1, tile_col);
+		} else {
+		  rhs.prefetch(0, tile_col + 1 == rhs.grid_cols() ? 0 : tile_col + 1);
+		}
+
+		const pinned lhs_tile(*this, tile_row, step, false);
+		const pinned rhs_tile(rhs, step, tile_col, false);
+		const size_type depth = store_->cols_in(step);
+
+		for (size_type row = 0; row != rows; ++row)
+		  for (size_type k = 0; k != depth; ++k) {
+			const value_type a = (*lhs_tile)(row, k);
+			for (size_type col = 0; col != cols; ++col)
+			  (*product)(row, col) += a * (*rhs_tile)(k, col);
+		  }
+	  }
+	});
+
+	return multiplied;
+  }
+
+private:
+  /**
+   * Pins a tile of the pool for the lifetime of the object
+   */
+  class pinned {
+  public:
+	pinned(const tiled_disk_matrix &owner, size_type tile_row, size_type tile_col, bool dirty)
+		: store_(owner.store_.get()),
+		  frame_(store_->acquire(tile_row * owner.grid_cols() + tile_col)),
+		  dirty_(dirty) {}
+
+	pinned(const pinned &) = delete;
+	pinned &operator=(const pinned &) = delete;
+
+	~pinned() noexcept {
+	  store_->release(frame_, dirty_);
+	}
+
+	matrix<T> &operator*() const noexcept { return frame_->tile; }
+
+  private:
+	detail::tile_store<T> *store_;
+	typename detail::tile_store<T>::frame *frame_;
+	bool dirty_;
+  };
+
+  void prefetch(size_type tile_row, size_type tile_col) const {
+	if (tile_row < grid_rows() && tile_col < grid_cols())
+	  store_->prefetch(tile_row * grid_cols() + tile_col);
+  }
+
+  /**
+   * Calls f(tile_row, tile_col, rows, cols) for every tile in row major order,
+   * the next tile is prefetched before f works on the current one
+   */
+  template<typename Function>
+  void for_each_tile(Function &&f) const {
+	for (size_type tile_row = 0; tile_row != grid_rows(); ++tile_row) {
+	  for (size_type tile_col = 0; tile_col != grid_cols(); ++tile_col) {
+		if (tile_col + 1 != grid_cols())
+		  prefetch(tile_row, tile_col + 1);
+		else
+		  prefetch(tile_row + 1, 0);
+
+		f(tile_row, tile_col, store_->rows_in(tile_row), store_->cols_in(tile_col));
+	  }
+	}
+  }
+
+  void check_range(size_type row, size_type col) const {
+	if (row >= rows() || col >= cols())
+	  throw std::out_of_range("row or col is out of range of matrix");
+  }
+
+  void check_tile(size_type tile_row, size_type tile_col) const {
+	if (tile_row >= grid_rows() || tile_col >= grid_cols())
+	  throw std::out_of_range("tile_row or tile_col is out of range of tile grid");
+  }
+
+private:
+  std::unique_ptr<detail::tile_store<T>> store_;
+  tiled_disk_settings settings_;
+};
+
+} // namespace mtlt end
+
+#endif // MTLT_TILED_DISK_MATRIX_H_
@@ -0,0 +1,279 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        Tracing hooks called around matrix operations
+ *        and the Chrome trace event JSON writer
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_TRACING_H_
+#define MTLT_TRACING_H_
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <cstddef>
+#include <fstream>
+#include <ostream>
+#include <typeinfo>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+#include <mtlt/matrix_config.h>
+
+/**
+ * Define MTLT_ENABLE_TRACING before including any mtlt header (or pass -DMTLT_ENABLE_TRACING)
+ * to call the installed trace_sink around matrix operations.
+ * Without it MTLT_TRACE_SCOPE expands to nothing
+ *
+ * The macro is used inside of the matrix classes, the element type is taken from value_type
+ */
+#if defined(MTLT_ENABLE_TRACING)
+#  define MTLT_TRACE_SCOPE(name, rows, cols) \
+	 const ::mtlt::detail::trace_scope mtlt_trace_scope_(name, rows, cols, ::mtlt::detail::trace_type_name<value_type>())
+#else
+#  define MTLT_TRACE_SCOPE(name, rows, cols) static_cast<void>(0)
+#endif
+
+namespace mtlt {
+
+/**
+ * @struct trace_event
+ * Begin or end of an operation, name and type point to static strings
+ */
+struct trace_event {
+  const char *name = "";
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+  const char *type = "";
+  std::thread::id thread;
+  std::chrono::steady_clock::time_point time;
+};
+
+/**
+ * @class trace_sink
+ *
+ * Receives events from all threads, so implementations must be thread safe.
+ * An operation that throws still reports its end event
+ */
+class trace_sink {
+public:
+  virtual ~trace_sink() = default;
+
+  virtual void begin(const trace_event &event) = 0;
+  virtual void end(const trace_event &event) = 0;
+};
+
+namespace detail {
+
+inline std::atomic<trace_sink *> &current_trace_sink() noexcept {
+  static std::atomic<trace_sink *> sink{nullptr};
+  return sink;
+}
+
+template<typename T>
+struct trace_type {
+  static const char *name() noexcept {
+	return std::is_same<T, bool>::value ? "bool" :
+		   std::is_integral<T>::value ?
+		   (std::is_signed<T>::value ?
+			(sizeof(T) == 1 ? "int8" : sizeof(T) == 2 ? "int16" : sizeof(T) == 4 ? "int32" : "int64") :
+			(sizeof(T) == 1 ? "uint8" : sizeof(T) == 2 ? "uint16" : sizeof(T) == 4 ? "uint32" : "uint64")) :
+		   std::is_floating_point<T>::value ?
+		   (sizeof(T) == 4 ? "float32" : sizeof(T) == 8 ? "float64" : "float128") :
+		   typeid(T).name();
+  }
+};
+
+template<typename T>
+struct trace_type<std::atomic<T>> : trace_type<T> {};
+
+template<typename T>
+const char *trace_type_name() noexcept {
+  return trace_type<T>::name();
+}
+
+/**
+ * Reports begin on construction and end on destruction to the sink installed at construction
+ */
+class trace_scope {
+public:
+  trace_scope(const char *name, std::size_t rows, std::size_t cols, const char *type)
+	  : sink_(current_trace_sink().load(std::memory_order_acquire)) {
+	if (!sink_)
+	  return;
+
+	event_.name = name;
+	event_.rows = rows;
+	event_.cols = cols;
+	event_.type = type;
+	event_.thread = std::this_thread::get_id();
+	event_.time = std::chrono::steady_clock::now();
+	sink_->begin(event_);
+  }
+
+  trace_scope(const trace_scope &) = delete;
+  trace_scope &operator=(const trace_scope &) = delete;
+
+  ~trace_scope() {
+	if (!sink_)
+	  return;
+
+	event_.time = std::chrono::steady_clock::now();
+	sink_->end(event_);
+  }
+
+private:
+  trace_sink *sink_;
+  trace_event event_;
+};
+
+} // namespace detail end
+
+/**
+ * Installs the sink for all threads and returns the previous one, nullptr disables tracing.
+ * The sink must outlive the operations started while it was installed
+ */
+inline trace_sink *set_trace_sink(trace_sink *sink) noexcept {
+  return detail::current_trace_sink().exchange(sink, std::memory_order_acq_rel);
+}
+
+inline trace_sink *get_trace_sink() noexcept {
+  return detail::current_trace_sink().load(std::memory_order_acquire);
+}
+
+MATRIX_CXX17_NODISCARD
+constexpr bool tracing_enabled() noexcept {
+#if defined(MTLT_ENABLE_TRACING)
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @class chrome_trace_writer
+ *
+ * Writes events in the Chrome trace event format (JSON array of "B" and "E" events),
+ * the output can be opened in chrome://tracing or https://ui.perfetto.dev
+ *
+ * Timestamps are microseconds since the writer creation, threads are numbered
+ * in order of their first event. The array is closed by close() or by the destructor
+ *
+ * @code
+ *
+ * mtlt::chrome_trace_writer writer("trace.json");
+ * mtlt::set_trace_sink(&writer);
+ *
+ * a.mul(b).inverse();
+ *
+ * mtlt::set_trace_sink(nullptr);
+ * writer.close();
+ *
+ * @endcode
+ */
+class chrome_trace_writer final : public trace_sink {
+public:
+  explicit chrome_trace_writer(std::ostream &os)
+	  : os_(&os), start_(std::chrono::steady_clock::now()) {
+	*os_ << '[';
+  }
+
+  explicit chrome_trace_writer(const std::string &path)
+	  : file_(new std::ofstream(path, std::ios::binary | std::ios::trunc)),
+		os_(file_.get()),
+		start_(std::chrono::steady_clock::now()) {
+	if (!*file_)
+	  throw std::runtime_error("Can't open trace file " + path);
+
+	*os_ << '[';
+  }
+
+  chrome_trace_writer(const chrome_trace_writer &) = delete;
+  chrome_trace_writer &operator=(const chrome_trace_writer &) = delete;
+
+  ~chrome_trace_writer() override {
+	close();
+  }
+
+  void begin(const trace_event &event) override {
+	write('B', event);
+  }
+
+  void end(const trace_event &event) override {
+	write('E', event);
+  }
+
+  void close() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (closed_)
+	  return;
+
+	*os_ << "\n]\n";
+	os_->flush();
+	closed_ = true;
+  }
+
+  MATRIX_CXX17_NODISCARD
+  std::size_t events() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return events_;
+  }
+
+private:
+  void write(char phase, const trace_event &event) {
+	const double microseconds = std::chrono::duration<double, std::micro>(event.time - start_).count();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (closed_)
+	  return;
+
+	auto thread = threads_.emplace(event.thread, threads_.size() + 1).first;
+
+	*os_ << (events_ == 0 ? "\n" : ",\n")
+		 << "{\"name\":\"" << event.name
+		 << "\",\"cat\":\"mtlt\",\"ph\":\"" << phase
+		 << "\",\"ts\":" << std::fixed << microseconds << std::defaultfloat
+		 << ",\"pid\":1,\"tid\":" << thread->second;
+
+	if (phase == 'B')
+	  *os_ << ",\"args\":{\"rows\":" << event.rows
+		   << ",\"cols\":" << event.cols
+		   << ",\"type\":\"" << event.type << "\"}";
+
+	*os_ << '}';
+	++events_;
+  }
+
+private:
+  std::unique_ptr<std::ofstream> file_;
+  std::ostream *os_;
+  std::chrono::steady_clock::time_point start_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::thread::id, std::size_t> threads_;
+  std::size_t events_ = 0;
+  bool closed_ = false;
+};
+
+} // namespace mtlt end
+
+#endif // MTLT_TRACING_H_
@@ -0,0 +1,326 @@
+/*
+ *        Copyright 2024, School21 (Sberbank) Student Library
+ *        All rights reserved
+ *
+ *        MTLT - Matrix Template Library Tonitaga (STL Like)
+ *
+ *        Author:   Gubaydullin Nurislam aka tonitaga
+ *        Email:    gubaydullin.nurislam@gmail.com
+ *        Telegram: @tonitaga
+ *
+ *        The Template Matrix Library for different types
+ *        contains most of the operations on matrices.
+ *
+ *        The triangular_matrix container class stores only the upper
+ *        or the lower triangle of a square matrix in a packed dynamic array
+ *
+ *        The Template Matrix library is written in the C++20 standard
+ *        Supports C++11 C++14 C++17 C++20 C++23 versions. Also
+ *        The Library is  written in STL style and supports
+ *        STL Algorithms Library.
+*/
+
+#ifndef MTLT_TRIANGULAR_MATRIX_H_
+#define MTLT_TRIANGULAR_MATRIX_H_
+
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <mtlt/matrix.h>
+#include <mtlt/matrix_config.h>
+#include <mtlt/matrix_normal_iterator.h>
+
+namespace mtlt {
+
+enum class triangle {
+  lower,
+  upper
+};
+
+/**
+ * @class triangular_matrix
+ *
+ * Square matrix with zeros above (triangle::lower) or below (triangle::upper)
+ * the main diagonal. Only the non zero triangle is stored, row by row,
+ * so an n x n matrix keeps n * (n + 1) / 2 elements
+ *
+ * operator() returns zero outside of the stored triangle,
+ * at() returns a reference to the stored element and throws outside of it
+ *
+ * @code
+ *
+ * mtlt::triangular_matrix<double, mtlt::triangle::lower> l(factor); // from matrix<double>
+ *
+ * mtlt::matrix<double> product = l.mul(b); // TRMM
+ * mtlt::matrix<double> x = l.solve(b);     // l * x == b
+ *
+ * @endcode
+ */
+template<typename T, triangle Triangle = triangle::lower>
+class triangular_matrix final {
+public:
+  using value_type = T;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using size_type = std::size_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = matrix_normal_iterator<pointer>;
+  using const_iterator = matrix_normal_iterator<const_pointer>;
+
+public:
+  MATRIX_CXX17_CONSTEXPR triangular_matrix() noexcept = default;
+
+  MATRIX_CXX17_CONSTEXPR explicit triangular_matrix(size_type order, value_type f = {})
+	  : order_(order), data_(new value_type[packed_size(order)]{}) {
+	if (f != value_type{})
+	  std::fill(begin(), end(), f);
+  }
+
+  /**
+   * Packs the Triangle part of a square matrix, the other part is ignored
+   */
+  explicit triangular_matrix(const matrix<T> &full)
+	  : triangular_matrix(full.rows()) {
+	if (full.rows() != full.cols())
+	  throw std::logic_error("Only square matrices can be packed as triangular");
+
+	for (size_type row = 0; row != order_; ++row)
+	  for (size_type col = first_col(row); col != last_col(row); ++col)
+		data_[index(row, col)] = full(row, col);
+  }
+
+  MATRIX_CXX17_CONSTEXPR triangular_matrix(const triangular_matrix &other)
+	  : triangular_matrix(other.order_) {
+	std::copy(other.begin(), other.end(), begin());
+  }
+
+  MATRIX_CXX17_CONSTEXPR triangular_matrix(triangular_matrix &&other) noexcept
+	  : order_(other.order_), data_(other.data_) {
+	other.order_ = size_type{};
+	other.data_ = nullptr;
+  }
+
+  MATRIX_CXX17_CONSTEXPR triangular_matrix &operator=(const triangular_matrix &other) {
+	if (&other == this)
+	  return *this;
+
+	triangular_matrix tmp(other);
+	*this = std::move(tmp);
+
+	return *this;
+  }
+
+  MATRIX_CXX17_CONSTEXPR triangular_matrix &operator=(triangular_matrix &&other) noexcept {
+	if (&other == this)
+	  return *this;
+
+	std::swap(order_, other.order_);
+	std::swap(data_, other.data_);
+
+	return *this;
+  }
+
+  ~triangular_matrix() noexcept {
+	delete[] data_;
+  }
+
+public:
+  MATRIX_CXX17_CONSTEXPR
+  iterator begin() noexcept { return iterator(data_); }
+
+  MATRIX_CXX17_CONSTEXPR
+  const_iterator begin() const noexcept { return const_iterator(data_); }
+
+  MATRIX_CXX17_CONSTEXPR
+  iterator end() noexcept { return iterator(data_ + size()); }
+
+  MATRIX_CXX17_CONSTEXPR
+  const_iterator end() const noexcept { return const_iterator(data_ + size()); }
+
+public:
+  value_type operator()(size_type row, size_type col) const {
+	return is_stored(row, col) ? data_[index(row, col)] : value_type{};
+  }
+
+  reference at(size_type row, size_type col) {
+	if (row >= order_ || col >= order_)
+	  throw std::out_of_range("row or col is out of range of matrix");
+
+	if (!is_stored(row, col))
+	  throw std::out_of_range("row and col are out of the stored triangle");
+
+	return data_[index(row, col)];
+  }
+
+  value_type at(size_type row, size_type col) const {
+	if (row >= order_ || col >= order_)
+	  throw std::out_of_range("row or col is out of range of matrix");
+
+	return (*this)(row, col);
+  }
+
+  MATRIX_CXX17_NODISCARD
+  static MATRIX_CXX17_CONSTEXPR bool is_stored(size_type row, size_type col) noexcept {
+	return Triangle == triangle::lower ? col <= row : col >= row;
+  }
+
+  MATRIX_CXX17_NODISCARD
+  size_type rows() const noexcept { return order_; }
+
+  MATRIX_CXX17_NODISCARD
+  size_type cols() const noexcept { return order_; }
+
+  /**
+   * Count of stored (packed) elements, not rows() * cols()
+   */
+  MATRIX_CXX17_NODISCARD
+  size_type size() const noexcept { return packed_size(order_); }
+
+public:
+  void print(std::ostream &os = std::cout, matrix_debug_settings s = matrix_debug_settings{}) const {
+	for (size_type row = 0; row != order_; ++row) {
+	  for (size_type col = 0; col != order_; ++col) {
+		os << std::setw(s.width)
+		   << std::setprecision(s.precision)
+		   << (*this)(row, col)
+		   << s.separator;
+	  }
+	  os << s.end;
+	}
+
+	if (s.is_double_end)
+	  os << s.end;
+  }
+
+  matrix<T> to_matrix() const {
+	matrix<T> full(order_, order_);
+
+	for (size_type row = 0; row != order_; ++row)
+	  for (size_type col = first_col(row); col != last_col(row); ++col)
+		full(row, col) = data_[index(row, col)];
+
+	return full;
+  }
+
+  /**
+   * TRMM: returns this * rhs, the zero triangle is skipped,
+   * so the work is half of the full product
+   */
+  matrix<T> mul(const matrix<T> &rhs) const {
+	if (order_ != rhs.rows())
+	  throw std::logic_error("Can't multiply two matrices because lhs.cols() != rhs.rows()");
+
+	const size_type cols = rhs.cols();
+	matrix<T> multiplied(order_, cols);
+
+	const_pointer packed = data_;
+	for (size_type row = 0; row != order_; ++row)
+	  for (size_type k = first_col(row); k != last_col(row); ++k, ++packed)
+		for (size_type col = 0; col != cols; ++col)
+		  multiplied(row, col) += *packed * rhs(k, col);
+
+	return multiplied;
+  }
+
+  /**
+   * Solves this * x == rhs by forward (lower) or backward (upper) substitution
+   */
+  matrix<T> solve(const matrix<T> &rhs) const {
+	if (order_ != rhs.rows())
+	  throw std::logic_error("Can't solve system because lhs.rows() != rhs.rows()");
+
+	const size_type cols = rhs.cols();
+	matrix<T> x(rhs);
+
+	for (size_type step = 0; step != order_; ++step) {
+	  const size_type row = Triangle == triangle::lower ? step : order_ - 1 - step;
+
+	  for (size_type k = first_col(row); k != last_col(row); ++k) {
+		if (k == row)
+		  continue;
+
+		const value_type a = data_[index(row, k)];
+		for (size_type col = 0; col != cols; ++col)
+		  x(row, col) -= a * x(k, col);
+	  }
+
+	  const value_type diagonal = data_[index(row, row)];
+	  if (diagonal == value_type{})
+		throw std::logic_error("Can't solve system because triangular matrix is singular");
+
+	  for (size_type col = 0; col != cols; ++col)
+		x(row, col) /= diagonal;
+	}
+
+	return x;
+  }
+
+  value_type determinant() const {
+	value_type determinant_value{1};
+	for (size_type i = 0; i != order_; ++i)
+	  determinant_value *= data_[index(i, i)];
+	return determinant_value;
+  }
+
+  template<typename EqualCompare = std::equal_to<value_type>>
+  bool equal_to(const triangular_matrix &rhs) const {
+	return order_ == rhs.order_ && std::equal(begin(), end(), rhs.begin(), EqualCompare());
+  }
+
+private:
+  static MATRIX_CXX17_CONSTEXPR size_type packed_size(size_type order) noexcept {
+	return order * (order + 1) / 2;
+  }
+
+  MATRIX_CXX17_CONSTEXPR size_type first_col(size_type row) const noexcept {
+	return Triangle == triangle::lower ? 0 : row;
+  }
+
+  MATRIX_CXX17_CONSTEXPR size_type last_col(size_type row) const noexcept {
+	return Triangle == triangle::lower ? row + 1 : order_;
+  }
+
+  MATRIX_CXX17_CONSTEXPR size_type index(size_type row, size_type col) const noexcept {
+	return Triangle == triangle::lower
+		   ? row * (row + 1) / 2 + col
+		   : row * order_ - row * (row - 1) / 2 + (col - row);
+  }
+
+private:
+  size_type order_{};
+  pointer data_ = nullptr;
+};
+
+template<typename T>
+using lower_triangular_matrix = triangular_matrix<T, triangle::lower>;
+
+template<typename T>
+using upper_triangular_matrix = triangular_matrix<T, triangle::upper>;
+
+template<typename T, triangle Triangle>
+std::ostream &operator<<(std::ostream &out, const triangular_matrix<T, Triangle> &rhs) {
+  rhs.print(out);
+  return out;
+}
+
+template<typename T, triangle Triangle>
+matrix<T> inline operator*(const triangular_matrix<T, Triangle> &lhs, const matrix<T> &rhs) {
+  return lhs.mul(rhs);
+}
+
+template<typename T, triangle Triangle>
+bool inline operator==(const triangular_matrix<T, Triangle> &lhs, const triangular_matrix<T, Triangle> &rhs) {
+  return lhs.equal_to(rhs);
+}
+
+template<typename T, triangle Triangle>
+bool inline operator!=(const triangular_matrix<T, Triangle> &lhs, const triangular_matrix<T, Triangle> &rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace mtlt end
+
+#endif // MTLT_TRIANGULAR_MATRIX_H_
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <stdexcept>
+
+#include <mtlt/async.h>
+
+using namespace mtlt;
+
+TEST(FTAsync, MulAndInverse) {
+  matrix<double> a(2, 2, {4, 7, 2, 6});
+  matrix<double> b(2, 2, {1, 0, 0, 1});
+
+  future<matrix<double>> product = mul_async(a, b);
+  future<matrix<double>> inversed = inverse_async(a);
+
+  ASSERT_TRUE(product.valid());
+  ASSERT_TRUE(product.get() == a);
+  ASSERT_TRUE(mul_async(a, inversed.get()).get().approx_equal(matrix<double>::identity(2, 2)));
+  ASSERT_TRUE(product.is_ready());
+}
+
+TEST(FTAsync, Chaining) {
+  work_stealing_executor pool(2);
+  set_executor(&pool);
+
+  future<int> answer = async([]() { return 6; })
+	  .then([](int &x) { return x * 7; });
+  ASSERT_EQ(answer.get(), 42);
+
+  int calls = 0;
+  future<void> done = answer.then([&calls](int &) { ++calls; });
+  future<int> after_void = done.then([&calls]() { return calls; });
+  ASSERT_EQ(after_void.get(), 1);
+
+  future<int> failed = async([]() -> int { throw std::runtime_error("failed"); })
+	  .then([&calls](int &x) { ++calls; return x; });
+  EXPECT_THROW(failed.get(), std::runtime_error);
+  ASSERT_EQ(calls, 1);
+
+  set_executor(nullptr);
+}
+
+TEST(FTAsync, LoadAndSave) {
+  const std::string path = "mtlt_async_test.mtlt";
+  matrix<int> m(3, 2, {1, 2, 3, 4, 5, 6});
+
+  save_async(m, path).get();
+  future<matrix<int>> transposed = load_async<matrix<int>>(path)
+	  .then([](matrix<int> &loaded) { return loaded.transpose(); });
+
+  ASSERT_TRUE(transposed.get() == m.transpose());
+  std::remove(path.c_str());
+
+  EXPECT_THROW(load_async<matrix<int>>(path).get(), std::runtime_error);
+}
@@ -578,3 +578,16 @@ TEST(FTAtomicmatrix, ThreadsValueChange) {
 
   ASSERT_TRUE(correct.equal_to(matrix));
 }
+
+TEST(FTAtomicmatrix, reductions) {
+  atomic_matrix<double> m(2, 2, {1.5, -4.0, 2.5, 3.0});
+
+  ASSERT_DOUBLE_EQ(m.sum(), 3.0);
+  ASSERT_DOUBLE_EQ(m.mean(), 0.75);
+  ASSERT_DOUBLE_EQ(m.min(), -4.0);
+  ASSERT_DOUBLE_EQ(m.max(), 3.0);
+  ASSERT_EQ(m.argmin(), std::make_pair(std::size_t{0}, std::size_t{1}));
+  ASSERT_DOUBLE_EQ(m.l1_norm(), 7.0);
+  ASSERT_DOUBLE_EQ(m.linf_norm(), 5.5);
+  ASSERT_DOUBLE_EQ(m.frobenius_norm(), std::sqrt(33.5));
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include <mtlt/bit_matrix.h>
+
+using namespace mtlt;
+
+namespace {
+
+matrix<bool> random_bools(std::size_t rows, std::size_t cols, std::uint64_t seed, double p) {
+  matrix<int> bits(rows, cols);
+  bits.fill_random(bernoulli_random<int>(seed, p));
+
+  matrix<bool> converted(rows, cols);
+  for (std::size_t row = 0; row != rows; ++row)
+	for (std::size_t col = 0; col != cols; ++col)
+	  converted(row, col) = bits(row, col) != 0;
+
+  return converted;
+}
+
+} // namespace
+
+TEST(FTBitMatrix, ElementsAndConversion) {
+  bit_matrix m(3, 70);
+  ASSERT_EQ(m.rows(), 3);
+  ASSERT_EQ(m.cols(), 70);
+  ASSERT_EQ(m.words_per_row(), 2);
+  ASSERT_TRUE(m.none());
+
+  m.set(0, 0).set(1, 64).set(2, 69);
+  ASSERT_TRUE(m(1, 64));
+  ASSERT_FALSE(m(1, 63));
+  ASSERT_EQ(m.count(), 3);
+
+  m.reset(1, 64);
+  ASSERT_FALSE(m.at(1, 64));
+  EXPECT_THROW(m.at(3, 0), std::out_of_range);
+  EXPECT_THROW(m.set(0, 70), std::out_of_range);
+
+  // The padding bits of the last word stay zero
+  ASSERT_EQ((~m).count(), 3 * 70 - 2);
+  ASSERT_EQ(bit_matrix(3, 70, true).count(), 3 * 70);
+  ASSERT_TRUE(~bit_matrix(3, 70, true) == bit_matrix(3, 70));
+
+  const matrix<bool> bools = random_bools(37, 130, 1, 0.3);
+  const bit_matrix packed(bools);
+  ASSERT_TRUE(packed.to_matrix() == bools);
+  ASSERT_TRUE(packed.to_matrix<int>() == bit_matrix(packed.to_matrix<int>()).to_matrix<int>());
+}
+
+TEST(FTBitMatrix, ElementWise) {
+  const matrix<bool> a = random_bools(20, 100, 2, 0.5), b = random_bools(20, 100, 3, 0.5);
+  const bit_matrix x(a), y(b);
+
+  matrix<bool> conjunction(20, 100), disjunction(20, 100), exclusive(20, 100), difference(20, 100);
+  for (std::size_t row = 0; row != a.rows(); ++row)
+	for (std::size_t col = 0; col != a.cols(); ++col) {
+	  conjunction(row, col) = a(row, col) && b(row, col);
+	  disjunction(row, col) = a(row, col) || b(row, col);
+	  exclusive(row, col) = a(row, col) != b(row, col);
+	  difference(row, col) = a(row, col) && !b(row, col);
+	}
+
+  ASSERT_TRUE((x & y).to_matrix() == conjunction);
+  ASSERT_TRUE((x | y).to_matrix() == disjunction);
+  ASSERT_TRUE((x ^ y).to_matrix() == exclusive);
+  ASSERT_TRUE(bit_matrix(x).bit_and_not(y).to_matrix() == difference);
+
+  bit_matrix z(x);
+  z ^= y;
+  z ^= y;
+  ASSERT_TRUE(z == x);
+
+  EXPECT_THROW(z &= bit_matrix(20, 99), std::logic_error);
+}
+
+TEST(FTBitMatrix, TransposeAndProducts) {
+  const matrix<bool> a = random_bools(150, 200, 4, 0.02), b = random_bools(200, 90, 5, 0.02);
+  const bit_matrix x(a), y(b);
+
+  ASSERT_TRUE(x.transpose().to_matrix() == a.transpose());
+  ASSERT_TRUE(x.transpose().transpose() == x);
+
+  matrix<std::size_t> paths(150, 90);
+  for (std::size_t row = 0; row != paths.rows(); ++row)
+	for (std::size_t col = 0; col != paths.cols(); ++col)
+	  for (std::size_t k = 0; k != a.cols(); ++k)
+		paths(row, col) += a(row, k) && b(k, col);
+
+  matrix<bool> reachable(150, 90);
+  for (std::size_t row = 0; row != paths.rows(); ++row)
+	for (std::size_t col = 0; col != paths.cols(); ++col)
+	  reachable(row, col) = paths(row, col) != 0;
+
+  const execution_policy par = execution::par.with_threads(3).with_threshold(0);
+  ASSERT_TRUE((x * y).to_matrix() == reachable);
+  ASSERT_TRUE(x.mul(par, y).to_matrix() == reachable);
+  ASSERT_TRUE(x.mul_count(y) == paths);
+  ASSERT_TRUE(x.mul_count(par, y) == paths);
+
+  EXPECT_THROW(x.mul(x), std::logic_error);
+  EXPECT_THROW(x.mul_count(x), std::logic_error);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <sstream>
+
+#include <mtlt/csv.h>
+#include <mtlt/static_matrix.h>
+#include <mtlt/atomic_matrix.h>
+
+using namespace mtlt;
+
+TEST(FTCsv, Parse) {
+  const std::string text = "1, 2.5,-3\r\n\n4,+5,6e2\n  7 ,8,9";
+
+  matrix<double> m = parse_csv<double>(text.data(), text.size());
+  ASSERT_TRUE(m == matrix<double>(3, 3, {
+	  1, 2.5, -3,
+	  4, 5, 600,
+	  7, 8, 9
+  }));
+
+  ASSERT_EQ(parse_csv<int>("", 0).size(), 0);
+}
+
+TEST(FTCsv, HeaderAndTsv) {
+  matrix_csv_settings settings;
+  settings.delimiter = '\t';
+  settings.skip_header = true;
+
+  std::stringstream stream("a\tb\n10\t20\n30\t40\n");
+  ASSERT_TRUE(read_csv<int>(stream, settings) == matrix<int>(2, 2, {10, 20, 30, 40}));
+}
+
+TEST(FTCsv, InvalidInput) {
+  const std::string ragged = "1,2,3\n4,5\n";
+  EXPECT_THROW(parse_csv<int>(ragged.data(), ragged.size()), std::runtime_error);
+
+  const std::string not_number = "1,x\n";
+  EXPECT_THROW(parse_csv<int>(not_number.data(), not_number.size()), std::runtime_error);
+
+  const std::string overflow = "1,300\n";
+  EXPECT_THROW(parse_csv<signed char>(overflow.data(), overflow.size()), std::runtime_error);
+
+  EXPECT_THROW(read_csv<int>("mtlt_csv_missing_file.csv"), std::runtime_error);
+}
+
+TEST(FTCsv, WriteRoundTrip) {
+  matrix<double> m(7, 5);
+  m.fill_random(-1e6, 1e6);
+
+  std::stringstream stream;
+  write_csv(stream, m);
+  ASSERT_TRUE(read_csv<double>(stream) == m);
+
+  std::stringstream rounded;
+  matrix_csv_settings settings;
+  settings.precision = 3;
+  settings.delimiter = ';';
+  write_csv(rounded, matrix<double>(1, 2, {3.14159, 2.0}), settings);
+  ASSERT_EQ(rounded.str(), "3.14;2\n");
+
+  std::stringstream others;
+  write_csv(others, static_matrix<int, 1, 2>({-1, 2}));
+  write_csv(others, atomic_matrix<unsigned>(1, 1, {7u}));
+  ASSERT_EQ(others.str(), "-1,2\n7\n");
+}
+
+TEST(FTCsv, MultithreadedFile) {
+  const std::string path = "mtlt_csv_test.csv";
+  matrix<long long> m(20000, 8);
+  long long value = -80000;
+  m.generate([&value] { return value++ * 12345; });
+
+  write_csv(m, path);
+
+  matrix_csv_settings settings;
+  settings.threads = 4;
+  matrix<long long> loaded = read_csv<long long>(path, settings);
+  std::remove(path.c_str());
+
+  ASSERT_EQ(loaded.rows(), m.rows());
+  ASSERT_EQ(loaded.cols(), m.cols());
+  ASSERT_TRUE(loaded == m);
+}
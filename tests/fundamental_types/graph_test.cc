@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <stdexcept>
+
+#include <mtlt/graph.h>
+
+using namespace mtlt;
+
+namespace {
+
+template<typename T>
+matrix<T> random_graph(std::size_t n, std::uint64_t seed, T no_edge) {
+  matrix<T> weights(n, n);
+  weights.fill_random(uniform_random<T>(seed, T(1), T(100)));
+
+  matrix<double> edges(n, n);
+  edges.fill_random(bernoulli_random<double>(seed + 1, 0.05));
+
+  for (std::size_t row = 0; row != n; ++row)
+	for (std::size_t col = 0; col != n; ++col)
+	  if (row == col)
+		weights(row, col) = T(0);
+	  else if (edges(row, col) == 0)
+		weights(row, col) = no_edge;
+
+  return weights;
+}
+
+template<typename T>
+matrix<T> naive_floyd_warshall(matrix<T> d, T no_edge) {
+  for (std::size_t k = 0; k != d.rows(); ++k)
+	for (std::size_t i = 0; i != d.rows(); ++i)
+	  for (std::size_t j = 0; j != d.rows(); ++j)
+		if (d(i, k) != no_edge && d(k, j) != no_edge && d(i, k) + d(k, j) < d(i, j))
+		  d(i, j) = d(i, k) + d(k, j);
+
+  return d;
+}
+
+} // namespace
+
+TEST(FTGraph, FloydWarshall) {
+  const int inf = std::numeric_limits<int>::max();
+
+  matrix<int> small(4, 4, {
+	  0, 5, inf, 10,
+	  inf, 0, 3, inf,
+	  inf, inf, 0, 1,
+	  inf, -2, inf, 0
+  });
+  floyd_warshall(small);
+  ASSERT_TRUE(small == matrix<int>(4, 4, {
+	  0, 5, 8, 9,
+	  inf, 0, 3, 4,
+	  inf, -1, 0, 1,
+	  inf, -2, 1, 0
+  }));
+
+  // Not a multiple of the block, the last blocks are partial
+  const matrix<int> graph = random_graph<int>(150, 1, inf);
+  const matrix<int> expected = naive_floyd_warshall(graph, inf);
+
+  matrix<int> distances = graph;
+  ASSERT_TRUE(floyd_warshall(distances) == expected);
+
+  distances = graph;
+  ASSERT_TRUE(floyd_warshall(execution::par.with_threads(3).with_threshold(0), distances) == expected);
+
+  const double infinity = std::numeric_limits<double>::infinity();
+  matrix<double> real = random_graph<double>(97, 3, infinity);
+  const matrix<double> real_expected = naive_floyd_warshall(real, infinity);
+  ASSERT_TRUE(floyd_warshall(real).approx_equal(real_expected, 1e-9, 1e-12));
+
+  matrix<int> empty;
+  floyd_warshall(empty);
+  matrix<int> rectangle(2, 3);
+  EXPECT_THROW(floyd_warshall(rectangle), std::logic_error);
+}
+
+TEST(FTGraph, TransitiveClosure) {
+  matrix<int> chain(4, 4, {
+	  0, 1, 0, 0,
+	  0, 0, 1, 0,
+	  0, 0, 0, 0,
+	  0, 0, 1, 1
+  });
+  transitive_closure(chain);
+  ASSERT_TRUE(chain == matrix<int>(4, 4, {
+	  0, 1, 1, 0,
+	  0, 0, 1, 0,
+	  0, 0, 0, 0,
+	  0, 0, 1, 1
+  }));
+
+  matrix<int> adjacency(200, 200);
+  adjacency.fill_random(bernoulli_random<int>(5, 0.004));
+
+  matrix<int> expected = adjacency;
+  for (std::size_t k = 0; k != expected.rows(); ++k)
+	for (std::size_t i = 0; i != expected.rows(); ++i)
+	  if (expected(i, k))
+		for (std::size_t j = 0; j != expected.rows(); ++j)
+		  expected(i, j) |= expected(k, j);
+
+  matrix<int> closure = adjacency;
+  ASSERT_TRUE(transitive_closure(closure) == expected);
+
+  closure = adjacency;
+  ASSERT_TRUE(transitive_closure(execution::par.with_threads(3).with_threshold(0), closure) == expected);
+
+  matrix<int> rectangle(2, 3);
+  EXPECT_THROW(transitive_closure(rectangle), std::logic_error);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <mtlt/matrix.h>
+#include <mtlt/atomic_matrix.h>
+#include <mtlt/static_matrix.h>
+
+using namespace mtlt;
+
+TEST(FTInstrumentation, Enabled) {
+  ASSERT_TRUE(stats_enabled());
+  ASSERT_STREQ(operation_name(operation::mul), "mul");
+  ASSERT_STREQ(operation_name(operation::count), "unknown");
+}
+
+TEST(FTInstrumentation, MatrixMul) {
+  matrix<double> lhs(4, 3, 1.0);
+  matrix<double> rhs(3, 5, 2.0);
+
+  reset_stats();
+  lhs.mul(rhs);
+  stats_snapshot stats = take_stats_snapshot();
+
+  ASSERT_EQ(stats[operation::mul].calls, 1);
+  ASSERT_EQ(stats[operation::mul].flops, 2 * 4 * 3 * 5);
+  ASSERT_EQ(stats[operation::mul].bytes_read, (12 + 15) * sizeof(double));
+  ASSERT_EQ(stats[operation::mul].bytes_written, 20 * sizeof(double));
+  ASSERT_EQ(stats[operation::mul].allocations, 1);
+  ASSERT_EQ(stats[operation::mul].allocated_bytes, 20 * sizeof(double));
+  ASSERT_EQ(stats[operation::add].calls, 0);
+
+  reset_stats();
+  ASSERT_EQ(take_stats_snapshot().total().calls, 0);
+}
+
+TEST(FTInstrumentation, NestedOperations) {
+  matrix<double> m(3, 3, {
+	  2, 5, 7,
+	  6, 3, 4,
+	  5, -2, -3
+  });
+
+  reset_stats();
+  matrix<double> inverse = m.inverse();
+  stats_snapshot stats = take_stats_snapshot();
+
+  ASSERT_EQ(stats[operation::inverse].calls, 1);
+  ASSERT_EQ(stats[operation::complements].calls, 1);
+  ASSERT_EQ(stats[operation::transpose].calls, 1);
+  ASSERT_EQ(stats[operation::mul_by_number].calls, 1);
+  ASSERT_EQ(stats[operation::determinant].calls, 1 + 9);
+  ASSERT_GE(stats[operation::inverse].nanoseconds, stats[operation::complements].nanoseconds);
+
+  // The result of transpose is allocated inside of the transpose call
+  ASSERT_EQ(stats[operation::transpose].allocations, 1);
+  ASSERT_GT(stats[operation::complements].allocations, 1);
+  ASSERT_EQ(stats[operation::other].allocations, 0);
+}
+
+TEST(FTInstrumentation, StaticAndAtomicMatrix) {
+  static_matrix<int, 2, 3> lhs(1);
+  static_matrix<int, 3, 2> rhs(2);
+  atomic_matrix<int> atomic(2, 2, 1);
+
+  reset_stats();
+  static_matrix<int, 2, 2> product = lhs.mul(rhs);
+  atomic.add(atomic).transpose();
+  stats_snapshot stats = take_stats_snapshot();
+
+  ASSERT_EQ(product(1, 1), 6);
+  ASSERT_EQ(stats[operation::mul].calls, 1);
+  ASSERT_EQ(stats[operation::mul].flops, 2 * 2 * 3 * 2);
+  ASSERT_EQ(stats[operation::mul].allocations, 0);
+  ASSERT_EQ(stats[operation::add].calls, 1);
+  ASSERT_EQ(stats[operation::transpose].calls, 1);
+  ASSERT_EQ(stats[operation::transpose].allocated_bytes, 4 * sizeof(std::atomic<int>));
+}
+
+TEST(FTInstrumentation, ConcurrentCounters) {
+  const std::size_t kThreads = 4, kIterations = 100;
+
+  reset_stats();
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i != kThreads; ++i) {
+	threads.emplace_back([kIterations]() {
+	  matrix<int> m(2, 2, 1);
+	  for (std::size_t j = 0; j != kIterations; ++j)
+		m.add(1);
+	});
+  }
+
+  for (std::thread &thread : threads)
+	thread.join();
+
+  stats_snapshot stats = take_stats_snapshot();
+  ASSERT_EQ(stats[operation::add].calls, kThreads * kIterations);
+  ASSERT_EQ(stats[operation::add].flops, kThreads * kIterations * 4);
+  ASSERT_EQ(stats[operation::fill].calls, kThreads);
+  ASSERT_EQ(stats[operation::other].allocations, kThreads);
+}
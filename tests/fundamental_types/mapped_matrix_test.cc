@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include <mtlt/mapped_matrix.h>
+
+using namespace mtlt;
+
+TEST(FTMappedMatrix, OpenSavedMatrix) {
+  const std::string path = "mtlt_mapped_matrix_open.mtlt";
+  matrix<double> m(3, 4);
+  m.fill_random(-10.0, 10.0);
+  save(m, path);
+
+  {
+	mapped_matrix<double> mapped(path, map_mode::read_only, access_hint::sequential);
+	ASSERT_EQ(mapped.rows(), 3);
+	ASSERT_EQ(mapped.cols(), 4);
+	ASSERT_EQ(mapped.mode(), map_mode::read_only);
+	ASSERT_TRUE(mapped == m);
+	ASSERT_DOUBLE_EQ(mapped(2, 3), m(2, 3));
+	ASSERT_DOUBLE_EQ(mapped.sum(), m.sum());
+	ASSERT_TRUE(mapped.transpose() == m.transpose());
+	EXPECT_THROW(mapped.at(3, 0), std::out_of_range);
+
+	// Private mapping, the file keeps the original elements
+	mapped.fill(0.0);
+	ASSERT_DOUBLE_EQ(mapped.sum(), 0.0);
+  }
+
+  ASSERT_TRUE(load<matrix<double>>(path) == m);
+  std::remove(path.c_str());
+}
+
+TEST(FTMappedMatrix, ReadWrite) {
+  const std::string path = "mtlt_mapped_matrix_write.mtlt";
+  save(matrix<int>(2, 3, {1, 2, 3, 4, 5, 6}), path, [] {
+	matrix_binary_settings settings;
+	settings.checksum = true;
+	return settings;
+  }());
+
+  {
+	mapped_matrix<int> mapped(path, map_mode::read_write, access_hint::random);
+	mapped.mul(2);
+	mapped += matrix<int>(2, 3, 1);
+	mapped(0, 0) = 100;
+	mapped.flush();
+  }
+
+  // Checksum flag is dropped by the read_write mapping, so the file stays loadable
+  ASSERT_TRUE(load<matrix<int>>(path) == matrix<int>(2, 3, {100, 5, 7, 9, 11, 13}));
+  std::remove(path.c_str());
+}
+
+TEST(FTMappedMatrix, Create) {
+  const std::string path = "mtlt_mapped_matrix_create.mtlt";
+
+  {
+	auto mapped = mapped_matrix<float>::create(path, 4, 2);
+	ASSERT_EQ(mapped.size(), 8);
+	ASSERT_FLOAT_EQ(mapped.sum(), 0.0f);
+
+	float value = 0.0f;
+	mapped.generate([&value] { return value++; });
+
+	matrix<float> product = mapped * matrix<float>(2, 1, {1.0f, 1.0f});
+	ASSERT_TRUE(product == matrix<float>(4, 1, {1.0f, 5.0f, 9.0f, 13.0f}));
+	ASSERT_TRUE(std::is_sorted(mapped.begin(), mapped.end()));
+  }
+
+  mapped_matrix<float> reopened(path);
+  ASSERT_FLOAT_EQ(reopened(3, 1), 7.0f);
+  ASSERT_TRUE(reopened.to_matrix() == load<matrix<float>>(path));
+
+  mapped_matrix<float> moved(std::move(reopened));
+  ASSERT_EQ(reopened.size(), 0);
+  ASSERT_EQ(moved.rows(), 4);
+
+  EXPECT_THROW(mapped_matrix<double>{path}, std::logic_error);
+  std::remove(path.c_str());
+  EXPECT_THROW(mapped_matrix<float>{path}, std::runtime_error);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <sstream>
+
+#include <mtlt/matrix_market.h>
+
+using namespace mtlt;
+
+TEST(FTSparseMatrix, Construction) {
+  sparse_matrix<int> s(3, 4, {
+	  {2, 3, 5},
+	  {0, 1, 1},
+	  {0, 0, 2},
+	  {0, 1, 2}
+  });
+
+  ASSERT_EQ(s.nonzeros(), 3);
+  ASSERT_EQ(s(0, 1), 3);
+  ASSERT_EQ(s(1, 1), 0);
+  ASSERT_TRUE(s.to_matrix() == matrix<int>(3, 4, {
+	  2, 3, 0, 0,
+	  0, 0, 0, 0,
+	  0, 0, 0, 5
+  }));
+
+  ASSERT_TRUE(sparse_matrix<int>(s.to_matrix()) == s);
+  ASSERT_TRUE(s.transpose().to_matrix() == s.to_matrix().transpose());
+  EXPECT_THROW(s.at(3, 0), std::out_of_range);
+  EXPECT_THROW(sparse_matrix<int>(2, 2, {{2, 0, 1}}), std::out_of_range);
+}
+
+TEST(FTSparseMatrix, Mul) {
+  matrix<double> dense(3, 3, {
+	  1, 0, 0,
+	  0, 0, 2,
+	  3, 0, 4
+  });
+  matrix<double> rhs(3, 2, {
+	  1, 2,
+	  3, 4,
+	  5, 6
+  });
+
+  sparse_matrix<double> s(dense);
+  ASSERT_TRUE(s * rhs == dense * rhs);
+  ASSERT_TRUE(s.mul(2.0).to_matrix() == dense * 2.0);
+  EXPECT_THROW(s.mul(matrix<double>(2, 2)), std::logic_error);
+}
+
+TEST(FTMatrixMarket, CoordinateSymmetric) {
+  const std::string text =
+	  "%%MatrixMarket matrix coordinate real symmetric\n"
+	  "% comment\n"
+	  "3 3 4\n"
+	  "1 1 1.5\n"
+	  "2 1 -2\n"
+	  "3 2 3e1\n"
+	  "3 3 4\n";
+
+  matrix<double> expected(3, 3, {
+	  1.5, -2, 0,
+	  -2, 0, 30,
+	  0, 30, 4
+  });
+
+  ASSERT_TRUE(parse_mtx<double>(text.data(), text.size()) == expected);
+
+  sparse_matrix<double> s = parse_mtx_sparse<double>(text.data(), text.size());
+  ASSERT_EQ(s.nonzeros(), 6);
+  ASSERT_TRUE(s.to_matrix() == expected);
+}
+
+TEST(FTMatrixMarket, ArrayAndPattern) {
+  std::stringstream array(
+	  "%%MatrixMarket matrix array integer general\n"
+	  "2 3\n"
+	  "1\n4\n2\n5\n3\n6\n");
+  ASSERT_TRUE(read_mtx<int>(array) == matrix<int>(2, 3, {1, 2, 3, 4, 5, 6}));
+
+  std::stringstream pattern(
+	  "%%MatrixMarket matrix coordinate pattern general\n"
+	  "2 2 2\n"
+	  "1 2\n"
+	  "2 1\n");
+  ASSERT_TRUE(read_mtx<int>(pattern) == matrix<int>(2, 2, {0, 1, 1, 0}));
+
+  std::stringstream skew(
+	  "%%MatrixMarket matrix array real skew-symmetric\n"
+	  "2 2\n"
+	  "7\n");
+  ASSERT_TRUE(read_mtx<double>(skew) == matrix<double>(2, 2, {0, -7, 7, 0}));
+}
+
+TEST(FTMatrixMarket, InvalidInput) {
+  std::stringstream complex("%%MatrixMarket matrix coordinate complex general\n1 1 1\n1 1 1 0\n");
+  EXPECT_THROW(read_mtx<double>(complex), std::runtime_error);
+
+  std::stringstream out_of_range("%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1\n");
+  EXPECT_THROW(read_mtx<double>(out_of_range), std::runtime_error);
+
+  std::stringstream truncated("%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1\n");
+  EXPECT_THROW(read_mtx<double>(truncated), std::runtime_error);
+
+  std::stringstream not_mtx("1,2,3\n");
+  EXPECT_THROW(read_mtx<double>(not_mtx), std::runtime_error);
+}
+
+TEST(FTMatrixMarket, WriteRoundTrip) {
+  const std::string path = "mtlt_matrix_market_test.mtx";
+
+  matrix<double> m(4, 3);
+  m.fill_random(-100.0, 100.0);
+  write_mtx(m, path);
+  ASSERT_TRUE(read_mtx<double>(path) == m);
+
+  sparse_matrix<long long> s(1000, 500, {{0, 0, -1}, {999, 499, 123456789012LL}, {500, 7, 3}});
+  write_mtx(s, path);
+  ASSERT_TRUE(read_mtx_sparse<long long>(path) == s);
+
+  std::remove(path.c_str());
+}
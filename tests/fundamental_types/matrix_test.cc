@@ -166,6 +166,106 @@ TEST(FTDynamicmatrix, mulmatrix) {
   }
 }
 
+namespace {
+
+template<typename T>
+matrix<T> reference_product(const matrix<T> &lhs, const matrix<T> &rhs) {
+  matrix<T> product(lhs.rows(), rhs.cols());
+  for (std::size_t row = 0; row != lhs.rows(); ++row)
+	for (std::size_t col = 0; col != rhs.cols(); ++col)
+	  for (std::size_t k = 0; k != lhs.cols(); ++k)
+		product(row, col) += lhs(row, k) * rhs(k, col);
+
+  return product;
+}
+
+} // namespace
+
+TEST(FTDynamicmatrix, blocked_and_strassen_mul) {
+  matrix<long long> a(131, 301), b(301, 277);
+  a.fill_random(uniform_random<long long>(1, -100, 100));
+  b.fill_random(uniform_random<long long>(2, -100, 100));
+  const matrix<long long> expected = reference_product(a, b);
+
+  ASSERT_TRUE(matrix<long long>(a).mul(b) == expected);
+  ASSERT_TRUE(matrix<long long>(a).mul(execution::par.with_threads(3).with_threshold(0), b) == expected);
+
+  // Odd sizes on every level of the recursion are peeled
+  ASSERT_TRUE(matrix<long long>(a).mul_strassen(b, 16) == expected);
+  ASSERT_TRUE(matrix<long long>(a).mul(mul_policy(execution::par.with_threads(2).with_threshold(0), 20), b) == expected);
+
+  matrix<double> x(96, 96), y(96, 96);
+  x.fill_random(normal_random<double>(3, 0.0, 1.0));
+  y.fill_random(normal_random<double>(4, 0.0, 1.0));
+
+  ASSERT_TRUE(matrix<double>(x).mul(y) == reference_product(x, y));
+  ASSERT_TRUE(matrix<double>(x).mul_strassen(y, 16).approx_equal(reference_product(x, y), 1e-11, 1e-11));
+
+  ASSERT_FALSE(mul_policy().uses_strassen(4096, 4096, 4096));
+  ASSERT_TRUE(mul_policy().with_strassen().uses_strassen(4096, 4096, 4096));
+  ASSERT_FALSE(mul_policy().with_strassen().uses_strassen(4096, 100, 4096));
+  EXPECT_THROW(a.mul_strassen(a), std::logic_error);
+}
+
+TEST(FTDynamicmatrix, semiring_mul) {
+  const int inf = std::numeric_limits<int>::max();
+
+  // All pairs shortest paths by squaring: after the k-th squaring the paths have at most 2^k edges
+  matrix<int> distances(4, 4, {
+	  0, 5, inf, 10,
+	  inf, 0, 3, inf,
+	  inf, inf, 0, 1,
+	  inf, inf, inf, 0
+  });
+  for (std::size_t edges = 1; edges < distances.rows() - 1; edges *= 2)
+	distances.mul<semiring::min_plus>(distances);
+
+  ASSERT_TRUE(distances == matrix<int>(4, 4, {
+	  0, 5, 8, 9,
+	  inf, 0, 3, 4,
+	  inf, inf, 0, 1,
+	  inf, inf, inf, 0
+  }));
+
+  matrix<double> capacities(3, 3, {
+	  0, 4, 1,
+	  0, 0, 3,
+	  0, 0, 0
+  });
+  ASSERT_EQ(matrix<double>(capacities).mul<semiring::max_min>(capacities)(0, 2), 3.0);
+  ASSERT_EQ(matrix<double>(capacities).mul<semiring::max_plus>(capacities)(0, 2), 7.0);
+  ASSERT_TRUE(matrix<double>(capacities).mul<semiring::plus_times>(capacities) == matrix<double>(capacities).mul(capacities));
+
+  // Rows of more than one word of bits
+  matrix<int> adjacency(150, 130), other(130, 70);
+  adjacency.fill_random(bernoulli_random<int>(5, 0.05));
+  other.fill_random(bernoulli_random<int>(6, 0.05));
+
+  matrix<int> expected(150, 70);
+  for (std::size_t row = 0; row != expected.rows(); ++row)
+	for (std::size_t col = 0; col != expected.cols(); ++col)
+	  for (std::size_t k = 0; k != adjacency.cols(); ++k)
+		expected(row, col) |= adjacency(row, k) & other(k, col);
+
+  ASSERT_TRUE(matrix<int>(adjacency).mul<semiring::or_and>(other) == expected);
+  ASSERT_TRUE(matrix<int>(adjacency).mul<semiring::or_and>(execution::par.with_threads(3).with_threshold(0), other) == expected);
+
+  matrix<int> weights(70, 70);
+  weights.fill_random(uniform_random<int>(7, 1, 100));
+  weights.transform([inf](int w) { return w > 90 ? inf : w; });
+
+  matrix<int> shortest(70, 70, inf);
+  for (std::size_t row = 0; row != shortest.rows(); ++row)
+	for (std::size_t col = 0; col != shortest.cols(); ++col)
+	  for (std::size_t k = 0; k != weights.cols(); ++k)
+		if (weights(row, k) != inf && weights(k, col) != inf)
+		  shortest(row, col) = std::min(shortest(row, col), weights(row, k) + weights(k, col));
+
+  ASSERT_TRUE(matrix<int>(weights).mul<semiring::min_plus>(weights) == shortest);
+  ASSERT_TRUE(matrix<int>(weights).mul<semiring::min_plus>(execution::par.with_threads(3).with_threshold(0), weights) == shortest);
+  EXPECT_THROW(adjacency.mul<semiring::or_and>(adjacency), std::logic_error);
+}
+
 TEST(FTDynamicmatrix, fillRandom) {
   matrix<int> m(3, 3);
   m.fill_random(5, 5);
@@ -568,3 +668,295 @@ TEST(FTDynamicmatrix, swap_cols) {
   bool equal = m == correct;
   ASSERT_TRUE(equal);
 }
+
+TEST(FTDynamicmatrix, transpose_into) {
+  matrix<int> m(2, 3, {
+	  1, 2, 3,
+	  4, 5, 6
+  });
+
+  matrix<int> out(4, 4);
+  const int *buffer = out.data();
+
+  m.transpose_into(out);
+  ASSERT_EQ(out.data(), buffer);
+  ASSERT_TRUE(out == m.transpose());
+
+  m.transpose_into(m);
+  ASSERT_EQ(m.rows(), 3);
+  ASSERT_TRUE(m == out);
+}
+
+TEST(FTDynamicmatrix, join_into) {
+  matrix<int> lhs(2, 1, {1, 2});
+  matrix<int> rhs(2, 2, {
+	  3, 4,
+	  5, 6
+  });
+
+  matrix<int> out;
+  lhs.join_right_into(rhs, out);
+  ASSERT_TRUE(out == matrix<int>(2, 3, {1, 3, 4, 2, 5, 6}));
+
+  lhs.join_left_into(rhs, out);
+  ASSERT_TRUE(out == matrix<int>(2, 3, {3, 4, 1, 5, 6, 2}));
+
+  matrix<int> row(1, 2, {7, 8});
+  row.join_top_into(rhs, out);
+  ASSERT_TRUE(out == matrix<int>(3, 2, {3, 4, 5, 6, 7, 8}));
+
+  row.join_bottom_into(rhs, out);
+  ASSERT_TRUE(out == matrix<int>(3, 2, {7, 8, 3, 4, 5, 6}));
+
+  rhs.join_bottom_into(rhs, rhs);
+  ASSERT_TRUE(rhs == matrix<int>(4, 2, {3, 4, 5, 6, 3, 4, 5, 6}));
+
+  EXPECT_THROW(lhs.join_top_into(rhs, out), std::logic_error);
+}
+
+TEST(FTDynamicmatrix, inverse_into) {
+  matrix<double> m(3, 3, {
+	  2, 5, 7,
+	  6, 3, 4,
+	  5, -2, -3
+  });
+
+  matrix<double> out, complements, minored, rounded;
+  m.inverse_into(out);
+  ASSERT_TRUE(out == m.inverse());
+
+  m.calc_complements_into(complements);
+  ASSERT_TRUE(complements == m.calc_complements());
+
+  m.minor_into(1, 1, minored);
+  ASSERT_TRUE(minored == m.minor(1, 1));
+
+  out.mul(10).round_into(rounded);
+  ASSERT_TRUE(rounded == out.round());
+
+  EXPECT_THROW(matrix<double>(2, 2).inverse_into(out), std::logic_error);
+}
+
+TEST(FTDynamicmatrix, push_back_row) {
+  matrix<int> m;
+  m.push_back_row({1, 2, 3});
+  ASSERT_EQ(m.rows(), 1);
+  ASSERT_EQ(m.cols(), 3);
+
+  std::size_t reallocations = 0;
+  for (int row = 1; row != 100; ++row) {
+	const int *data = m.data();
+	std::vector<int> values(3, row);
+	m.push_back_row(values.begin(), values.end());
+	reallocations += data != m.data();
+  }
+
+  ASSERT_EQ(m.rows(), 100);
+  ASSERT_LE(reallocations, 8);
+  ASSERT_GE(m.capacity(), m.size());
+  ASSERT_EQ(m(0, 2), 3);
+  ASSERT_EQ(m(99, 0), 99);
+  EXPECT_THROW(m.push_back_row({1, 2}), std::logic_error);
+
+  m.shrink_to_fit();
+  ASSERT_EQ(m.capacity(), m.size());
+  ASSERT_EQ(m(57, 1), 57);
+}
+
+TEST(FTDynamicmatrix, reserve_and_relayout) {
+  matrix<int> m(2, 2, {
+	  1, 2,
+	  3, 4
+  });
+
+  m.reserve(4, 4);
+  const int *data = m.data();
+  ASSERT_EQ(m.capacity(), 16);
+
+  m.cols(3);
+  ASSERT_TRUE(m == matrix<int>(2, 3, {1, 2, 0, 3, 4, 0}));
+
+  m.resize(3, 4);
+  ASSERT_TRUE(m == matrix<int>(3, 4, {1, 2, 0, 0, 3, 4, 0, 0, 0, 0, 0, 0}));
+
+  m.resize(2, 1);
+  ASSERT_TRUE(m == matrix<int>(2, 1, {1, 3}));
+
+  m.to_join_bottom(matrix<int>(1, 1, {5}));
+  ASSERT_EQ(m.data(), data);
+
+  m.to_join_right(m);
+  ASSERT_TRUE(m == matrix<int>(3, 2, {1, 1, 3, 3, 5, 5}));
+}
+
+TEST(FTDynamicmatrix, uninitialized) {
+  matrix<double> m(3, 4, uninitialized);
+  ASSERT_EQ(m.rows(), 3);
+  ASSERT_EQ(m.cols(), 4);
+  ASSERT_EQ(m.capacity(), 12);
+
+  m.fill(2.5);
+  matrix<double> copy(m);
+  ASSERT_TRUE(copy == matrix<double>(3, 4, 2.5));
+
+  matrix<std::string> strings(2, 2, uninitialized);
+  ASSERT_TRUE(strings(1, 1).empty());
+}
+
+TEST(FTDynamicmatrix, equal_to_and_approx_equal) {
+  matrix<int> ints(3, 3, 7);
+  matrix<int> other(ints);
+  ASSERT_TRUE(ints == other);
+  other(2, 2) = 8;
+  ASSERT_FALSE(ints == other);
+  ASSERT_FALSE(ints == matrix<int>(1, 9, 7));
+  ASSERT_TRUE(matrix<int>() == matrix<int>());
+
+  matrix<double> m(20, 30, 1.0);
+  matrix<double> close(m);
+  close(19, 29) += 1e-12;
+  ASSERT_FALSE(m == close);
+  ASSERT_TRUE(m.approx_equal(close));
+  ASSERT_FALSE(m.approx_equal(close, 0, 0));
+  ASSERT_DOUBLE_EQ(m.max_abs_diff(close), close(19, 29) - 1.0);
+
+  close(0, 0) = 1.5;
+  ASSERT_FALSE(m.approx_equal(close));
+  ASSERT_TRUE(m.approx_equal(close, 0.5));
+  ASSERT_TRUE(m.approx_equal(close, 0, 0.34));
+  ASSERT_DOUBLE_EQ(m.max_abs_diff(close), 0.5);
+
+  close(0, 0) = std::numeric_limits<double>::quiet_NaN();
+  ASSERT_FALSE(close.approx_equal(close, 1.0));
+  ASSERT_TRUE(std::isnan(m.max_abs_diff(close)));
+
+  close(0, 0) = m(0, 0) = std::numeric_limits<double>::infinity();
+  ASSERT_TRUE(m.approx_equal(close));
+
+  ASSERT_FALSE(m.approx_equal(matrix<double>(30, 20, 1.0)));
+  EXPECT_THROW(m.max_abs_diff(matrix<double>(30, 20)), std::logic_error);
+}
+
+TEST(FTDynamicmatrix, reductions) {
+  matrix<int> m(2, 3, {
+	  3, -7, 1,
+	  5, 2, -7
+  });
+
+  ASSERT_EQ(m.sum(), -3);
+  ASSERT_DOUBLE_EQ(m.mean(), -0.5);
+  ASSERT_EQ(m.min(), -7);
+  ASSERT_EQ(m.max(), 5);
+  ASSERT_EQ(m.argmin(), std::make_pair(std::size_t{0}, std::size_t{1}));
+  ASSERT_EQ(m.argmax(), std::make_pair(std::size_t{1}, std::size_t{0}));
+  ASSERT_DOUBLE_EQ(m.frobenius_norm(), std::sqrt(137.0));
+  ASSERT_DOUBLE_EQ(m.l1_norm(), 9);
+  ASSERT_DOUBLE_EQ(m.linf_norm(), 14);
+
+  matrix<int> empty;
+  ASSERT_EQ(empty.sum(), 0);
+  ASSERT_DOUBLE_EQ(empty.frobenius_norm(), 0);
+  EXPECT_THROW(empty.mean(), std::logic_error);
+  EXPECT_THROW(empty.argmax(), std::logic_error);
+}
+
+TEST(FTDynamicmatrix, large_float_reductions) {
+  // Big enough to be reduced on several threads
+  matrix<float> m(1 << 11, 1 << 10, 0.1f);
+  m(1000, 1000) = -5.0f;
+  m(2000, 3) = 7.0f;
+
+  const double expected = 0.1 * static_cast<double>(m.size() - 2) + 2.0;
+  ASSERT_NEAR(m.sum(), expected, expected * 1e-6);
+  ASSERT_NEAR(m.mean(), expected / static_cast<double>(m.size()), 1e-7);
+  ASSERT_EQ(m.argmin(), std::make_pair(std::size_t{1000}, std::size_t{1000}));
+  ASSERT_EQ(m.argmax(), std::make_pair(std::size_t{2000}, std::size_t{3}));
+  ASSERT_NEAR(m.linf_norm(), 0.1 * 1023 + 7.0, 1e-3);
+  ASSERT_NEAR(m.l1_norm(), 0.1 * 2047 + 7.0, 1e-3);
+}
+
+TEST(FTDynamicmatrix, reduce_rows_and_cols) {
+  matrix<int> m(3, 4, {
+	  1, 5, -2, 5,
+	  4, 0, 3, -6,
+	  -1, 7, 2, 1
+  });
+
+  ASSERT_TRUE(m.reduce_rows(reduction::sum) == matrix<double>(3, 1, {9, 1, 9}));
+  ASSERT_TRUE(m.reduce_rows(reduction::mean) == matrix<double>(3, 1, {2.25, 0.25, 2.25}));
+  ASSERT_TRUE(m.reduce_rows(reduction::min) == matrix<double>(3, 1, {-2, -6, -1}));
+  ASSERT_TRUE(m.reduce_rows(reduction::argmax) == matrix<double>(3, 1, {1, 0, 1}));
+  ASSERT_DOUBLE_EQ(m.reduce_rows(reduction::norm)(1, 0), std::sqrt(61.0));
+
+  ASSERT_TRUE(m.reduce_cols(reduction::sum) == matrix<double>(1, 4, {4, 12, 3, 0}));
+  ASSERT_TRUE(m.reduce_cols(reduction::max) == matrix<double>(1, 4, {4, 7, 3, 5}));
+  ASSERT_TRUE(m.reduce_cols(reduction::argmin) == matrix<double>(1, 4, {2, 1, 0, 1}));
+  ASSERT_TRUE(m.reduce_cols(reduction::mean) == matrix<double>(1, 4, {4.0 / 3, 4, 1, 0}));
+  ASSERT_DOUBLE_EQ(m.reduce_cols(reduction::norm)(0, 3), std::sqrt(62.0));
+
+  matrix<int> empty(0, 3);
+  ASSERT_TRUE(empty.reduce_cols(reduction::sum) == matrix<double>(1, 3));
+  EXPECT_THROW(empty.reduce_cols(reduction::max), std::logic_error);
+  ASSERT_EQ(empty.reduce_rows(reduction::max).rows(), 0);
+}
+
+TEST(FTDynamicmatrix, broadcasting) {
+  matrix<double> m(2, 3, {
+	  1, 2, 3,
+	  4, 5, 6
+  });
+
+  m.add_row_vector(matrix<double>(1, 3, {10, 20, 30}));
+  ASSERT_TRUE(m == matrix<double>(2, 3, {11, 22, 33, 14, 25, 36}));
+
+  m.sub_row_vector(matrix<int>(1, 3, {10, 20, 30}));
+  m.mul_col_vector(matrix<double>(2, 1, {2, -1}));
+  ASSERT_TRUE(m == matrix<double>(2, 3, {2, 4, 6, -4, -5, -6}));
+
+  m.sub_row_mean();
+  ASSERT_TRUE(m == matrix<double>(2, 3, {-2, 0, 2, 1, 0, -1}));
+
+  m.add_col_vector(matrix<double>(2, 1, {1, 2})).mul_row_vector(matrix<double>(1, 3, {1, 0, 2}));
+  ASSERT_TRUE(m == matrix<double>(2, 3, {-1, 0, 6, 3, 0, 2}));
+
+  matrix<double> features(4, 2, {1, 10, 2, 20, 3, 30, 6, 60});
+  features.sub_row_vector(features.reduce_cols(reduction::mean));
+  ASSERT_TRUE(features.reduce_cols(reduction::sum) == matrix<double>(1, 2));
+
+  EXPECT_THROW(m.add_row_vector(matrix<double>(3, 1)), std::logic_error);
+  EXPECT_THROW(m.sub_col_vector(matrix<double>(1, 2)), std::logic_error);
+}
+
+TEST(FTDynamicmatrix, execution_policies) {
+  const execution_policy par = execution::par.with_threads(4).with_threshold(0);
+  ASSERT_EQ(par.threads(), 4);
+  ASSERT_EQ(par.threads_for(3), 3);
+  ASSERT_EQ(execution::par.threads_for(100), 1);
+  ASSERT_EQ(execution::seq.threads_for(1 << 20), 1);
+
+  matrix<double> m(7, 9);
+  m.generate(par, []() { return 1.25; });
+  ASSERT_TRUE(m == matrix<double>(7, 9, 1.25));
+
+  m.add(par, 1.0).mul(par, 2.0).sub(par, 0.5).div(par, 2.0);
+  ASSERT_TRUE(m == matrix<double>(7, 9, 2.0));
+
+  matrix<int> ints(7, 9, 3);
+  m.add(par, ints).mul_by_element(par, ints).sub(par, matrix<double>(7, 9, 1.0));
+  ASSERT_TRUE(m == matrix<double>(7, 9, 14.0));
+
+  m.fill(par, 0.5).to_floor(par);
+  ASSERT_TRUE(m == matrix<double>(7, 9));
+
+  m.fill(par, -1.5).to_round(par);
+  ASSERT_TRUE(m == matrix<double>(7, 9, -2.0));
+  m.fill(par, -1.5).to_ceil(par);
+  ASSERT_TRUE(m == matrix<double>(7, 9, -1.0));
+
+  m.transform(par, [](double x) { return x * 3; });
+  m.transform(par, matrix<double>(7, 9, 4.0), [](double lhs, double rhs) { return lhs + rhs; });
+  ASSERT_TRUE(m == matrix<double>(7, 9, 1.0));
+
+  EXPECT_THROW(m.add(par, matrix<double>(9, 7)), std::logic_error);
+  EXPECT_THROW(ints.div(par, 0), std::logic_error);
+}
@@ -85,4 +85,37 @@ TEST(FTNormalIterator, container_creation) {
 
 	++begin_m1, ++begin_m2, ++begin_vec1, ++begin_vec2;
   }
-}
\ No newline at end of file
+}
+TEST(FTNormalIterator, comparisons) {
+  matrix<int> m(2, 2, {1, 2, 3, 4});
+
+  auto first = m.begin(), last = m.end();
+  ASSERT_TRUE(first <= first);
+  ASSERT_TRUE(first >= first);
+  ASSERT_TRUE(first <= last);
+  ASSERT_FALSE(first >= last);
+  ASSERT_TRUE(2 + first == first + 2);
+  ASSERT_EQ(first[3], 4);
+
+  const auto const_first = m.begin();
+  *const_first = 10;
+  ASSERT_EQ(m(0, 0), 10);
+}
+
+#if __cplusplus > 201703L
+static_assert(std::contiguous_iterator<matrix<int>::iterator>);
+static_assert(std::contiguous_iterator<matrix<int>::const_iterator>);
+static_assert(std::contiguous_iterator<static_matrix<double, 2, 2>::iterator>);
+
+TEST(FTNormalIterator, contiguous) {
+  matrix<int> m(2, 3, {1, 2, 3, 4, 5, 6});
+  const matrix<int> &cm = m;
+
+  ASSERT_EQ(std::to_address(m.begin()), m.data());
+  ASSERT_EQ(std::to_address(cm.end()), m.data() + m.size());
+
+  std::vector<int> v(m.size());
+  std::ranges::copy(m, v.begin());
+  ASSERT_TRUE(std::ranges::equal(m, v));
+}
+#endif
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <sstream>
+
+#include <mtlt/npy.h>
+
+using namespace mtlt;
+
+// Builds a .npy v1.0 image the way numpy.save does
+static std::string make_npy(const std::string &dict, const std::string &payload) {
+  std::string header = dict;
+  while ((10 + header.size() + 1) % 64 != 0)
+	header.push_back(' ');
+  header.push_back('\n');
+
+  std::string bytes("\x93NUMPY\x01\x00", 8);
+  bytes.push_back(static_cast<char>(header.size() & 0xFF));
+  bytes.push_back(static_cast<char>(header.size() >> 8));
+  return bytes + header + payload;
+}
+
+TEST(FTNpy, StreamRoundTrip) {
+  matrix<double> m(3, 5);
+  m.fill_random(-1.0, 1.0);
+
+  std::stringstream stream;
+  write_npy(stream, m);
+
+  const std::string bytes = stream.str();
+  ASSERT_EQ(bytes.compare(0, 6, "\x93NUMPY"), 0);
+  ASSERT_EQ((bytes.size() - m.size() * sizeof(double)) % 64, 0);
+  ASSERT_NE(bytes.find("'descr': '<f8', 'fortran_order': False, 'shape': (3, 5), }"), std::string::npos);
+
+  ASSERT_TRUE(read_npy<double>(stream) == m);
+
+  stream.clear();
+  stream.seekg(0);
+  EXPECT_THROW(read_npy<float>(stream), std::logic_error);
+}
+
+TEST(FTNpy, ShapesAndOrder) {
+  const std::int32_t elements[] = {1, 2, 3, 4, 5, 6};
+  const std::string payload(reinterpret_cast<const char *>(elements), sizeof(elements));
+
+  std::stringstream vector(make_npy("{'descr': '<i4', 'fortran_order': False, 'shape': (6,), }", payload));
+  ASSERT_TRUE(read_npy<std::int32_t>(vector) == matrix<std::int32_t>(1, 6, {1, 2, 3, 4, 5, 6}));
+
+  std::stringstream fortran(make_npy("{'descr': '<i4', 'fortran_order': True, 'shape': (2, 3), }", payload));
+  ASSERT_TRUE(read_npy<std::int32_t>(fortran) == matrix<std::int32_t>(2, 3, {1, 3, 5, 2, 4, 6}));
+
+  std::stringstream cube(make_npy("{'descr': '<i4', 'fortran_order': False, 'shape': (1, 2, 3), }", payload));
+  EXPECT_THROW(read_npy<std::int32_t>(cube), std::runtime_error);
+
+  std::stringstream garbage("this is not an npy file");
+  EXPECT_THROW(read_npy<std::int32_t>(garbage), std::runtime_error);
+}
+
+TEST(FTNpy, ForeignByteOrder) {
+  const unsigned char big_endian[] = {0, 0, 0, 1, 0, 0, 1, 0};
+  const std::string payload(reinterpret_cast<const char *>(big_endian), sizeof(big_endian));
+
+  std::stringstream stream(make_npy("{'descr': '>u4', 'fortran_order': False, 'shape': (2, 1), }", payload));
+  ASSERT_TRUE(read_npy<std::uint32_t>(stream) == matrix<std::uint32_t>(2, 1, {1, 256}));
+}
+
+TEST(FTNpy, ZeroCopyMapping) {
+  const std::string path = "mtlt_npy_test.npy";
+  matrix<float> m(4, 4);
+  m.fill_random(0.0f, 10.0f);
+  write_npy(m, path);
+
+  {
+	mapped_matrix<float> mapped = map_npy<float>(path, map_mode::read_write);
+	ASSERT_TRUE(mapped == m);
+	mapped(0, 0) = 42.0f;
+  }
+
+  matrix<float> loaded = read_npy<float>(path);
+  ASSERT_FLOAT_EQ(loaded(0, 0), 42.0f);
+  ASSERT_FLOAT_EQ(loaded(3, 3), m(3, 3));
+
+  EXPECT_THROW(map_npy<double>(path), std::logic_error);
+  std::remove(path.c_str());
+
+  const std::string fortran_path = "mtlt_npy_fortran_test.npy";
+  std::ofstream(fortran_path, std::ios::binary)
+	  << make_npy("{'descr': '<f4', 'fortran_order': True, 'shape': (1, 1), }", std::string(4, '\0'));
+  EXPECT_THROW(map_npy<float>(fortran_path), std::logic_error);
+  std::remove(fortran_path.c_str());
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+#include <mtlt/matrix.h>
+#include <mtlt/parallel.h>
+
+using namespace mtlt;
+
+namespace {
+
+/**
+ * Executor of an application which never runs the submitted jobs
+ */
+class lazy_executor final : public executor {
+public:
+  std::size_t concurrency() const noexcept override { return 8; }
+
+  void submit(std::function<void()> job) override {
+	++submitted;
+	jobs.push_back(std::move(job));
+  }
+
+  std::size_t submitted = 0;
+  std::vector<std::function<void()>> jobs;
+};
+
+} // namespace
+
+TEST(FTParallel, ParallelForCoversRange) {
+  work_stealing_executor pool(3);
+  set_executor(&pool);
+
+  std::vector<int> visited(10007);
+  parallel_for(0, visited.size(), 64, [&](std::size_t first, std::size_t last) {
+	ASSERT_LE(last - first, 64u);
+	for (; first != last; ++first)
+	  ++visited[first];
+  });
+
+  set_executor(nullptr);
+  ASSERT_EQ(std::count(visited.begin(), visited.end(), 1), static_cast<long>(visited.size()));
+}
+
+TEST(FTParallel, NestedAndExceptions) {
+  work_stealing_executor pool(2);
+  set_executor(&pool);
+
+  std::atomic<std::size_t> sum{0};
+  parallel_for(0, 16, 1, [&](std::size_t row, std::size_t) {
+	parallel_for(0, 1000, 10, [&](std::size_t first, std::size_t last) {
+	  for (; first != last; ++first)
+		sum += row * 1000 + first;
+	});
+  });
+  ASSERT_EQ(sum.load(), std::size_t{16000} * 15999 / 2);
+
+  EXPECT_THROW(parallel_for(0, 100, 1, [](std::size_t first, std::size_t) {
+	if (first == 57)
+	  throw std::runtime_error("57");
+  }), std::runtime_error);
+
+  set_executor(nullptr);
+}
+
+TEST(FTParallel, ExternalExecutor) {
+  lazy_executor lazy;
+  set_executor(&lazy);
+
+  // The jobs are never run by the executor, the calling thread does everything itself
+  matrix<double> m(512, 512, 1.0);
+  m.add(execution::par.with_threshold(0), 1.0);
+  ASSERT_DOUBLE_EQ(m.sum(), 2.0 * 512 * 512);
+  ASSERT_GT(lazy.submitted, 0u);
+
+  for (auto &job : lazy.jobs)
+	job();
+
+  set_executor(nullptr);
+  ASSERT_EQ(&get_executor(), &get_executor());
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <mtlt/matrix.h>
+#include <mtlt/random.h>
+#include <mtlt/atomic_matrix.h>
+#include <mtlt/static_matrix.h>
+
+using namespace mtlt;
+
+TEST(FTRandom, PhiloxKnownAnswers) {
+  // Known answer tests of the Random123 reference implementation
+  std::uint32_t out[4];
+
+  detail::philox4x32({0, 0, 0, 0}, {0, 0}, out);
+  ASSERT_EQ(out[0], 0x6627e8d5u);
+  ASSERT_EQ(out[1], 0xe169c58du);
+  ASSERT_EQ(out[2], 0xbc57ac4cu);
+  ASSERT_EQ(out[3], 0x9b00dbd8u);
+
+  detail::philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}, out);
+  ASSERT_EQ(out[0], 0xd16cfe09u);
+  ASSERT_EQ(out[1], 0x94fdccebu);
+  ASSERT_EQ(out[2], 0x5001e420u);
+  ASSERT_EQ(out[3], 0x24126ea1u);
+}
+
+TEST(FTRandom, Reproducible) {
+  const normal_random<double> normal(42, 0.0, 1.0);
+
+  matrix<double> serial(101, 37);
+  serial.fill_random(normal);
+
+  matrix<double> parallel(101, 37);
+  parallel.fill_random(execution::par.with_threads(7).with_threshold(0), normal);
+  ASSERT_TRUE(serial == parallel);
+
+  parallel.fill_random(normal_random<double>(43, 0.0, 1.0));
+  ASSERT_FALSE(serial == parallel);
+  parallel.fill_random(normal_random<double>(42, 0.0, 1.0, 1));
+  ASSERT_FALSE(serial == parallel);
+
+  // Element i gets the same value whatever the shape is
+  matrix<double> row(1, 101 * 37);
+  row.fill_random(normal);
+  ASSERT_TRUE(std::equal(row.begin(), row.end(), serial.begin()));
+
+  matrix<int> first(10, 10), second(10, 10);
+  first.fill_random(0, 1000000);
+  second.fill_random(0, 1000000);
+  ASSERT_FALSE(first == second);
+}
+
+TEST(FTRandom, Distributions) {
+  const std::size_t n = 1 << 16;
+
+  matrix<double> normal(1, n);
+  normal.fill_random(normal_random<double>(7, 5.0, 2.0));
+  ASSERT_NEAR(normal.mean(), 5.0, 0.05);
+  ASSERT_NEAR(normal.frobenius_norm() * normal.frobenius_norm() / n - 25.0, 4.0, 0.1);
+
+  matrix<float> uniform(1, n);
+  uniform.fill_random(uniform_random<float>(7, -1.0f, 3.0f));
+  ASSERT_NEAR(uniform.mean(), 1.0, 0.05);
+  ASSERT_GE(uniform.min(), -1.0f);
+  ASSERT_LT(uniform.max(), 3.0f);
+
+  matrix<int> dice(1, n);
+  dice.fill_random(uniform_random<int>(7, 1, 6));
+  ASSERT_EQ(dice.min(), 1);
+  ASSERT_EQ(dice.max(), 6);
+  ASSERT_NEAR(dice.mean(), 3.5, 0.05);
+
+  matrix<int> coins(1, n);
+  coins.fill_random(bernoulli_random<int>(7, 0.25));
+  ASSERT_NEAR(coins.mean(), 0.25, 0.01);
+  ASSERT_EQ(coins.fill_random(bernoulli_random<int>(7, 1.0)).sum(), static_cast<int>(n));
+
+  EXPECT_THROW(uniform_random<int>(7, 6, 1), std::logic_error);
+  EXPECT_THROW(bernoulli_random<int>(7, 1.5), std::logic_error);
+  EXPECT_THROW(normal_random<float>(7, 0.0f, -1.0f), std::logic_error);
+}
+
+TEST(FTRandom, OtherContainers) {
+  const uniform_random<double> uniform(2024, 0.0, 1.0);
+
+  matrix<double> m(3, 4);
+  m.fill_random(uniform);
+
+  static_matrix<double, 3, 4> s;
+  s.fill_random(uniform);
+
+  atomic_matrix<double> a(3, 4);
+  a.fill_random(execution::par.with_threshold(0), uniform);
+
+  for (std::size_t row = 0; row != 3; ++row)
+	for (std::size_t col = 0; col != 4; ++col) {
+	  ASSERT_EQ(m(row, col), s(row, col));
+	  ASSERT_EQ(m(row, col), a(row, col));
+	}
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <sstream>
+
+#include <mtlt/serialization.h>
+
+using namespace mtlt;
+
+static matrix_binary_settings with_checksum() {
+  matrix_binary_settings settings;
+  settings.checksum = true;
+  return settings;
+}
+
+TEST(FTSerialization, MatrixStreamRoundTrip) {
+  matrix<double> m(3, 4);
+  m.fill_random(-100.0, 100.0);
+
+  std::stringstream stream;
+  save(stream, m);
+  ASSERT_EQ(stream.str().size(), binary_header::kSize + m.size() * sizeof(double));
+
+  matrix<double> loaded;
+  load(stream, loaded);
+  ASSERT_TRUE(loaded == m);
+}
+
+TEST(FTSerialization, MatrixFileRoundTrip) {
+  const std::string path = "mtlt_serialization_test.mtlt";
+  matrix<int> m(5, 2, {
+	  1, 2,
+	  3, 4,
+	  5, 6,
+	  7, 8,
+	  9, 10
+  });
+
+  save(m, path, with_checksum());
+  matrix<int> loaded = load<matrix<int>>(path);
+  std::remove(path.c_str());
+
+  ASSERT_EQ(loaded.rows(), 5);
+  ASSERT_EQ(loaded.cols(), 2);
+  ASSERT_TRUE(loaded == m);
+
+  EXPECT_THROW(load<matrix<int>>(path), std::runtime_error);
+}
+
+TEST(FTSerialization, StaticMatrix) {
+  static_matrix<float, 2, 3> m({1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f});
+
+  std::stringstream stream;
+  save(stream, m);
+  std::string bytes = stream.str();
+
+  static_matrix<float, 2, 3> loaded;
+  load(stream, loaded);
+  ASSERT_TRUE(loaded == m);
+
+  std::stringstream wrong_size(bytes);
+  static_matrix<float, 3, 2> transposed;
+  EXPECT_THROW(load(wrong_size, transposed), std::logic_error);
+}
+
+TEST(FTSerialization, AtomicMatrix) {
+  atomic_matrix<long long> m(2, 2, {1, 2, 3, 4});
+
+  std::stringstream stream;
+  save(stream, m, with_checksum());
+
+  atomic_matrix<long long> loaded;
+  load(stream, loaded);
+  ASSERT_TRUE(loaded == m);
+}
+
+TEST(FTSerialization, CrossTypeCompatibility) {
+  matrix<int> m(2, 2, {1, 2, 3, 4});
+
+  std::stringstream stream;
+  save(stream, m);
+
+  atomic_matrix<int> atomic;
+  load(stream, atomic);
+  ASSERT_EQ(atomic(1, 1), 4);
+
+  stream.clear();
+  stream.seekg(0);
+  matrix<float> floats;
+  EXPECT_THROW(load(stream, floats), std::logic_error);
+}
+
+TEST(FTSerialization, ChecksumMismatch) {
+  matrix<double> m(4, 4, 1.0);
+
+  std::stringstream stream;
+  save(stream, m, with_checksum());
+
+  std::string bytes = stream.str();
+  bytes[binary_header::kSize + 3] ^= 0x10;
+
+  std::stringstream corrupted(bytes);
+  matrix<double> loaded;
+  EXPECT_THROW(load(corrupted, loaded), std::runtime_error);
+
+  std::stringstream garbage("definitely not a matrix, but long enough to fill the whole header");
+  EXPECT_THROW(load(garbage, loaded), std::runtime_error);
+}
+
+TEST(FTSerialization, ForeignByteOrder) {
+  matrix<std::int32_t> m(2, 3, {1, -2, 3, 70000, 5, -600000});
+
+  std::stringstream stream;
+  save(stream, m, with_checksum());
+  std::string bytes = stream.str();
+
+  // Rewrite the file as if it was produced by a machine with opposite byte order
+  auto reverse = [&bytes](std::size_t offset, std::size_t size) {
+	std::reverse(bytes.begin() + offset, bytes.begin() + offset + size);
+  };
+
+  bytes[7] ^= binary_header::kBigEndianFlag;
+  reverse(4, 2);
+  reverse(8, 4);
+  reverse(12, 4);
+  reverse(16, 8);
+  reverse(24, 8);
+  for (std::size_t i = 0; i != m.size(); ++i)
+	reverse(binary_header::kSize + i * sizeof(std::int32_t), sizeof(std::int32_t));
+
+  // Checksum is taken over the payload words in the writer byte order
+  std::uint64_t checksum = detail::checksum(bytes.data() + binary_header::kSize,
+											m.size() * sizeof(std::int32_t), true);
+  std::memcpy(&bytes[32], &checksum, sizeof(checksum));
+  reverse(32, 8);
+
+  std::stringstream foreign(bytes);
+  matrix<std::int32_t> loaded;
+  load(foreign, loaded);
+  ASSERT_TRUE(loaded == m);
+}
@@ -428,4 +428,25 @@ TEST(FTStaticMatrix, swap_cols) {
 
   bool equal = m == correct;
   ASSERT_TRUE(equal);
-}
\ No newline at end of file
+}
+TEST(FTStaticMatrix, approx_equal) {
+  static_matrix<float, 2, 2> m({1.0f, 2.0f, 3.0f, 4.0f});
+  static_matrix<float, 2, 2> close({1.0f, 2.0f, 3.0f, 4.00001f});
+
+  ASSERT_FALSE(m == close);
+  ASSERT_TRUE(m.approx_equal(close));
+  ASSERT_FALSE(m.approx_equal(close, 0, 0));
+  ASSERT_NEAR(m.max_abs_diff(close), 0.00001f, 1e-6f);
+}
+
+TEST(FTStaticMatrix, reductions) {
+  static_matrix<int, 2, 2> m({1, -4, 2, 3});
+
+  ASSERT_DOUBLE_EQ(m.mean(), 0.5);
+  ASSERT_EQ(m.min(), -4);
+  ASSERT_EQ(m.max(), 3);
+  ASSERT_EQ(m.argmax(), std::make_pair(std::size_t{1}, std::size_t{1}));
+  ASSERT_DOUBLE_EQ(m.l1_norm(), 7.0);
+  ASSERT_DOUBLE_EQ(m.linf_norm(), 5.0);
+  ASSERT_DOUBLE_EQ(m.frobenius_norm(), std::sqrt(30.0));
+}
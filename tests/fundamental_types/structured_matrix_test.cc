@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <mtlt/matrix.h>
+#include <mtlt/banded_matrix.h>
+#include <mtlt/diagonal_matrix.h>
+#include <mtlt/symmetric_matrix.h>
+#include <mtlt/triangular_matrix.h>
+
+using namespace mtlt;
+
+static void expect_near(const matrix<double> &lhs, const matrix<double> &rhs) {
+  ASSERT_EQ(lhs.rows(), rhs.rows());
+  ASSERT_EQ(lhs.cols(), rhs.cols());
+
+  for (std::size_t row = 0; row != lhs.rows(); ++row)
+	for (std::size_t col = 0; col != lhs.cols(); ++col)
+	  EXPECT_NEAR(lhs(row, col), rhs(row, col), 1e-9);
+}
+
+TEST(FTStructuredMatrix, SymmetricPacking) {
+  matrix<int> full(3, 3, {
+	  1, 2, 3,
+	  2, 4, 5,
+	  3, 5, 6
+  });
+
+  symmetric_matrix<int> packed(full);
+  ASSERT_EQ(packed.rows(), 3);
+  ASSERT_EQ(packed.cols(), 3);
+  ASSERT_EQ(packed.size(), 6);
+  ASSERT_TRUE(packed.to_matrix() == full);
+
+  packed(0, 2) = 10;
+  ASSERT_EQ(packed(2, 0), 10);
+  EXPECT_THROW(packed.at(3, 0), std::out_of_range);
+  EXPECT_THROW(symmetric_matrix<int>(matrix<int>(2, 3)), std::logic_error);
+}
+
+TEST(FTStructuredMatrix, SymmetricMul) {
+  matrix<double> full(3, 3, {
+	  4, 1, 2,
+	  1, 5, 3,
+	  2, 3, 6
+  });
+  matrix<double> rhs(3, 2, {
+	  1, 2,
+	  3, 4,
+	  5, 6
+  });
+
+  symmetric_matrix<double> packed(full);
+  expect_near(packed.mul(rhs), full * rhs);
+  expect_near(packed * rhs, full * rhs);
+  EXPECT_THROW(packed.mul(matrix<double>(2, 2)), std::logic_error);
+}
+
+TEST(FTStructuredMatrix, TriangularLower) {
+  matrix<double> full(3, 3, {
+	  2, 7, 7,
+	  1, 3, 7,
+	  4, 5, 6
+  });
+  matrix<double> rhs(3, 2, {
+	  1, 2,
+	  3, 4,
+	  5, 6
+  });
+  matrix<double> lower(3, 3, {
+	  2, 0, 0,
+	  1, 3, 0,
+	  4, 5, 6
+  });
+
+  lower_triangular_matrix<double> l(full);
+  ASSERT_EQ(l.size(), 6);
+  ASSERT_EQ(l(0, 2), 0);
+  ASSERT_DOUBLE_EQ(l.determinant(), 36);
+  expect_near(l.to_matrix(), lower);
+  expect_near(l.mul(rhs), lower * rhs);
+  expect_near(lower * l.solve(rhs), rhs);
+  EXPECT_THROW(l.at(0, 2), std::out_of_range);
+}
+
+TEST(FTStructuredMatrix, TriangularUpper) {
+  matrix<double> full(3, 3, {
+	  2, 1, 4,
+	  7, 3, 5,
+	  7, 7, 6
+  });
+  matrix<double> rhs(3, 1, {1, 2, 3});
+  matrix<double> upper(3, 3, {
+	  2, 1, 4,
+	  0, 3, 5,
+	  0, 0, 6
+  });
+
+  upper_triangular_matrix<double> u(full);
+  ASSERT_EQ(u(2, 0), 0);
+  expect_near(u.to_matrix(), upper);
+  expect_near(u * rhs, upper * rhs);
+  expect_near(upper * u.solve(rhs), rhs);
+
+  u.at(1, 1) = 0;
+  EXPECT_THROW(u.solve(rhs), std::logic_error);
+}
+
+TEST(FTStructuredMatrix, BandedMatrix) {
+  matrix<double> full(5, 5, {
+	  4, 1, 0, 0, 0,
+	  2, 5, 1, 0, 0,
+	  1, 2, 6, 1, 0,
+	  0, 1, 2, 7, 1,
+	  0, 0, 1, 2, 8
+  });
+  matrix<double> rhs(5, 2, {
+	  1, 0,
+	  2, 1,
+	  3, 0,
+	  4, 1,
+	  5, 0
+  });
+
+  banded_matrix<double> band(full, 2, 1);
+  ASSERT_EQ(band.lower(), 2);
+  ASSERT_EQ(band.upper(), 1);
+  ASSERT_EQ(band.size(), 20);
+  ASSERT_EQ(band(0, 3), 0);
+  EXPECT_THROW(band.at(0, 3), std::out_of_range);
+
+  expect_near(band.to_matrix(), full);
+  expect_near(band.mul(rhs), full * rhs);
+  expect_near(full * band.solve(rhs), rhs);
+}
+
+TEST(FTStructuredMatrix, BandedSolvePivoting) {
+  matrix<double> full(4, 4, {
+	  0, 1, 0, 0,
+	  1, 0, 1, 0,
+	  0, 1, 0, 1,
+	  0, 0, 1, 1
+  });
+  matrix<double> rhs(4, 1, {1, 2, 3, 4});
+
+  banded_matrix<double> band(full, 1, 1);
+  expect_near(full * band.solve(rhs), rhs);
+
+  banded_matrix<double> singular(3, 1, 1);
+  EXPECT_THROW(singular.solve(matrix<double>(3, 1)), std::logic_error);
+}
+
+TEST(FTStructuredMatrix, DiagonalMatrix) {
+  diagonal_matrix<double> d(3, {1, 2, 4});
+  matrix<double> m(3, 3, {
+	  1, 1, 1,
+	  2, 2, 2,
+	  3, 3, 3
+  });
+
+  ASSERT_EQ(d.size(), 3);
+  ASSERT_EQ(d(0, 1), 0);
+  ASSERT_DOUBLE_EQ(d.determinant(), 8);
+  ASSERT_DOUBLE_EQ(d.trace(), 7);
+
+  expect_near(d * m, d.to_matrix() * m);
+  expect_near(m * d, m * d.to_matrix());
+  expect_near(d.to_matrix() * d.solve(m), m);
+  ASSERT_TRUE(d.inverse().mul(d) == diagonal_matrix<double>(3, 1));
+
+  ASSERT_TRUE(diagonal_matrix<double>(m.transpose()) == diagonal_matrix<double>(3, {1, 2, 3}));
+  EXPECT_THROW(diagonal_matrix<double>(3).inverse(), std::logic_error);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <mtlt/task.h>
+
+#if __cplusplus > 201703L && defined(__cpp_impl_coroutine)
+
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+
+using namespace mtlt;
+
+namespace {
+
+task<int> answer() {
+  co_return 42;
+}
+
+task<matrix<double>> product(matrix<double> a, matrix<double> b) {
+  matrix<double> inversed = co_await inverse_async(std::move(a));
+  co_return co_await mul_async(std::move(inversed), std::move(b));
+}
+
+task<double> load_and_sum(std::string path) {
+  matrix<double> m = co_await load_async<matrix<double>>(path);
+  co_await resume_on_executor();
+  co_return m.sum() + co_await answer();
+}
+
+task<void> failing() {
+  co_await async([]() { throw std::runtime_error("failed"); });
+}
+
+} // namespace
+
+TEST(FTTask, AwaitFutures) {
+  matrix<double> a(2, 2, {4, 7, 2, 6});
+
+  ASSERT_EQ(spawn(answer()).get(), 42);
+  ASSERT_TRUE(spawn(product(a, a)).get().approx_equal(matrix<double>::identity(2, 2)));
+
+  const std::string path = "mtlt_task_test.mtlt";
+  save(matrix<double>(2, 2, {1, 2, 3, 4}), path);
+  ASSERT_DOUBLE_EQ(spawn(load_and_sum(path)).get(), 52.0);
+  std::remove(path.c_str());
+
+  EXPECT_THROW(spawn(failing()).get(), std::runtime_error);
+}
+
+TEST(FTTask, PipelineRows) {
+  work_stealing_executor pool(2);
+  set_executor(&pool);
+
+  matrix<double> x(103, 7);
+  x.fill_random(uniform_random<double>(7, -1.0, 1.0));
+  matrix<double> w(7, 3);
+  w.fill_random(uniform_random<double>(11, -1.0, 1.0));
+
+  matrix<double> expected = x;
+  expected.sub_row_mean();
+  expected = expected.mul(w);
+
+  matrix<double> y(x.rows(), w.cols());
+  std::atomic<std::size_t> scaled_rows{0};
+
+  future<void> done = spawn(pipeline_rows(x.rows(), 16,
+	  [&](std::size_t first, std::size_t last) {
+		for (std::size_t row = first; row != last; ++row) {
+		  double mean = 0;
+		  for (std::size_t col = 0; col != x.cols(); ++col)
+			mean += x(row, col);
+		  mean /= x.cols();
+		  for (std::size_t col = 0; col != x.cols(); ++col)
+			x(row, col) -= mean;
+		}
+	  },
+	  [&](std::size_t first, std::size_t last) {
+		for (std::size_t row = first; row != last; ++row)
+		  for (std::size_t col = 0; col != w.cols(); ++col)
+			for (std::size_t k = 0; k != x.cols(); ++k)
+			  y(row, col) += x(row, k) * w(k, col);
+		scaled_rows += last - first;
+	  }));
+
+  done.get();
+  ASSERT_EQ(scaled_rows.load(), x.rows());
+  ASSERT_TRUE(y.approx_equal(expected));
+
+  future<void> failed = spawn(pipeline_rows(10, 3, [](std::size_t first, std::size_t) {
+	if (first == 3)
+	  throw std::logic_error("tile");
+  }));
+  EXPECT_THROW(failed.get(), std::logic_error);
+
+  set_executor(nullptr);
+}
+
+#endif // __cplusplus > 201703L && defined(__cpp_impl_coroutine)
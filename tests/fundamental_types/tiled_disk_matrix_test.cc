@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+#include <mtlt/tiled_disk_matrix.h>
+
+using namespace mtlt;
+
+static tiled_disk_settings small_tiles(std::size_t tiles_in_memory, bool prefetch = true) {
+  tiled_disk_settings settings;
+  settings.tile_rows = 4;
+  settings.tile_cols = 3;
+  settings.memory_budget = tiles_in_memory * 4 * 3 * sizeof(double);
+  settings.prefetch = prefetch;
+  return settings;
+}
+
+TEST(FTTiledDiskMatrix, TilesAndElements) {
+  const std::string path = "mtlt_tiled_test.tiles";
+
+  {
+	tiled_disk_matrix<double> tiled(path, 10, 7, small_tiles(4));
+	ASSERT_EQ(tiled.grid_rows(), 3);
+	ASSERT_EQ(tiled.grid_cols(), 3);
+	ASSERT_EQ(tiled.capacity(), 4);
+	ASSERT_DOUBLE_EQ(tiled.sum(), 0.0);
+
+	tiled.store_tile(2, 2, matrix<double>(2, 1, {1.0, 2.0}));
+	EXPECT_THROW(tiled.store_tile(0, 0, matrix<double>(2, 1)), std::logic_error);
+	EXPECT_THROW(tiled.load_tile(3, 0), std::out_of_range);
+
+	tiled.set(0, 0, 5.0);
+	ASSERT_DOUBLE_EQ(tiled.at(9, 6), 2.0);
+	EXPECT_THROW(tiled.at(10, 0), std::out_of_range);
+	ASSERT_LE(tiled.resident_tiles(), tiled.capacity());
+  }
+
+  tiled_disk_matrix<double> reopened(path);
+  ASSERT_EQ(reopened.rows(), 10);
+  ASSERT_EQ(reopened.tile_cols(), 3);
+  ASSERT_TRUE(reopened.load_tile(2, 2) == matrix<double>(2, 1, {1.0, 2.0}));
+  ASSERT_DOUBLE_EQ(reopened.at(0, 0), 5.0);
+
+  EXPECT_THROW(tiled_disk_matrix<float>{path}, std::logic_error);
+  std::remove(path.c_str());
+}
+
+TEST(FTTiledDiskMatrix, ElementWise) {
+  matrix<double> lhs(9, 8), rhs(9, 8);
+  lhs.fill_random(-5.0, 5.0);
+  rhs.fill_random(-5.0, 5.0);
+
+  auto a = tiled_disk_matrix<double>::from_matrix("mtlt_tiled_a.tiles", lhs, small_tiles(4));
+  auto b = tiled_disk_matrix<double>::from_matrix("mtlt_tiled_b.tiles", rhs, small_tiles(4, false));
+
+  a.add(b).mul(2.0).sub(1.0);
+  ASSERT_TRUE(a.to_matrix().equal_to((lhs + rhs) * 2.0 - 1.0));
+
+  a.mul_by_element(b);
+  ASSERT_TRUE(a.to_matrix().equal_to(((lhs + rhs) * 2.0 - 1.0).mul_by_element(rhs)));
+  ASSERT_NEAR(a.sum(), a.to_matrix().sum(), 1e-9);
+
+  tiled_disk_settings other = small_tiles(4);
+  other.tile_rows = 5;
+  auto c = tiled_disk_matrix<double>::from_matrix("mtlt_tiled_c.tiles", rhs, other);
+  EXPECT_THROW(a.add(c), std::logic_error);
+
+  std::remove("mtlt_tiled_a.tiles");
+  std::remove("mtlt_tiled_b.tiles");
+  std::remove("mtlt_tiled_c.tiles");
+}
+
+TEST(FTTiledDiskMatrix, TransposeAndMul) {
+  matrix<double> lhs(11, 7), rhs(7, 5);
+  lhs.fill_random(-1.0, 1.0);
+  rhs.fill_random(-1.0, 1.0);
+
+  tiled_disk_settings rhs_settings = small_tiles(4);
+  rhs_settings.tile_rows = 3;
+  rhs_settings.tile_cols = 2;
+
+  auto a = tiled_disk_matrix<double>::from_matrix("mtlt_tiled_lhs.tiles", lhs, small_tiles(4));
+  auto b = tiled_disk_matrix<double>::from_matrix("mtlt_tiled_rhs.tiles", rhs, rhs_settings);
+
+  auto transposed = a.transpose("mtlt_tiled_t.tiles");
+  ASSERT_EQ(transposed.tile_rows(), 3);
+  ASSERT_TRUE(transposed.to_matrix() == lhs.transpose());
+
+  auto product = a.mul(b, "mtlt_tiled_product.tiles");
+  matrix<double> expected = lhs * rhs;
+  matrix<double> actual = product.to_matrix();
+
+  ASSERT_EQ(actual.rows(), 11);
+  ASSERT_EQ(actual.cols(), 5);
+  for (std::size_t row = 0; row != actual.rows(); ++row)
+	for (std::size_t col = 0; col != actual.cols(); ++col)
+	  EXPECT_NEAR(actual(row, col), expected(row, col), 1e-12);
+
+  // 4 x 3 tiles of the lhs were evicted and read back during the product
+  ASSERT_GT(a.stats().evictions, 0);
+  ASSERT_LE(a.resident_tiles(), a.capacity());
+
+  EXPECT_THROW(a.mul(a, "mtlt_tiled_fail.tiles"), std::logic_error);
+
+  std::remove("mtlt_tiled_lhs.tiles");
+  std::remove("mtlt_tiled_rhs.tiles");
+  std::remove("mtlt_tiled_t.tiles");
+  std::remove("mtlt_tiled_product.tiles");
+  std::remove("mtlt_tiled_fail.tiles");
+}
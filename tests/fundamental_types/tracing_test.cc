@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include <mtlt/matrix.h>
+#include <mtlt/atomic_matrix.h>
+#include <mtlt/tracing.h>
+
+using namespace mtlt;
+
+namespace {
+
+class recording_sink final : public trace_sink {
+public:
+  void begin(const trace_event &event) override {
+	std::lock_guard<std::mutex> lock(mutex);
+	events.push_back("B " + std::string(event.name) + ' ' + std::to_string(event.rows) + 'x'
+						 + std::to_string(event.cols) + ' ' + event.type);
+  }
+
+  void end(const trace_event &event) override {
+	std::lock_guard<std::mutex> lock(mutex);
+	events.push_back("E " + std::string(event.name));
+  }
+
+  std::mutex mutex;
+  std::vector<std::string> events;
+};
+
+} // namespace
+
+TEST(FTTracing, BeginEndEvents) {
+  ASSERT_TRUE(tracing_enabled());
+
+  matrix<double> lhs(2, 3, 1.0);
+  matrix<double> rhs(3, 4, 1.0);
+
+  recording_sink sink;
+  ASSERT_EQ(set_trace_sink(&sink), nullptr);
+  lhs.mul(rhs);
+  lhs.transpose();
+  ASSERT_EQ(set_trace_sink(nullptr), &sink);
+  lhs.transpose();
+
+  std::vector<std::string> expected = {
+	  "B mul 2x4 float64", "E mul",
+	  "B transpose 2x4 float64", "E transpose"
+  };
+  ASSERT_EQ(sink.events, expected);
+}
+
+TEST(FTTracing, NestedAndThrowing) {
+  atomic_matrix<int> singular(2, 2, 1);
+
+  recording_sink sink;
+  set_trace_sink(&sink);
+  EXPECT_THROW(singular.inverse(), std::logic_error);
+  set_trace_sink(nullptr);
+
+  std::vector<std::string> expected = {
+	  "B inverse 2x2 int32",
+	  "B determinant 2x2 int32", "E determinant",
+	  "E inverse"
+  };
+  ASSERT_EQ(sink.events, expected);
+}
+
+TEST(FTTracing, ChromeTraceWriter) {
+  matrix<float> m(2, 2, 1.0f);
+
+  std::stringstream json;
+  {
+	chrome_trace_writer writer(json);
+	set_trace_sink(&writer);
+	m.join_right(m);
+	set_trace_sink(nullptr);
+	ASSERT_EQ(writer.events(), 2);
+  }
+
+  const std::string trace = json.str();
+  ASSERT_EQ(trace.front(), '[');
+  ASSERT_EQ(trace.substr(trace.size() - 3), "\n]\n");
+  ASSERT_NE(trace.find("{\"name\":\"join\",\"cat\":\"mtlt\",\"ph\":\"B\",\"ts\":"), std::string::npos);
+  ASSERT_NE(trace.find(",\"pid\":1,\"tid\":1,\"args\":{\"rows\":2,\"cols\":2,\"type\":\"float32\"}}"), std::string::npos);
+  ASSERT_NE(trace.find("\"ph\":\"E\""), std::string::npos);
+}